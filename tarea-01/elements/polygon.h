@@ -56,6 +56,12 @@ public:
     // Agrega un punto
     void add_point(const Point<T> &p);
 
+    // Retorna el punto i-ésimo
+    Point<T> get_point(int i) const;
+
+    // Retorna el número de puntos
+    int size() const;
+
     // Retorna el polígono en forma de string
     std::string to_string() const;
 
@@ -158,6 +164,33 @@ void Polygon<T>::add_point(const Point<T> &p) {
     this->totalp += 1;
 }
 
+template<class T>
+/**
+ * Retorna un punto del polígono.
+ *
+ * @tparam T - Template
+ * @param i - Posición del punto
+ * @return
+ */
+Point<T> Polygon<T>::get_point(int i) const {
+    if (i < 0 || i >= this->totalp) {
+        std::cerr << "Point index out of range" << std::endl;
+        throw std::logic_error("Point index out of range");
+    }
+    return this->puntos[i];
+}
+
+template<class T>
+/**
+ * Retorna el número de puntos del polígono.
+ *
+ * @tparam T - Template
+ * @return
+ */
+int Polygon<T>::size() const {
+    return this->totalp;
+}
+
 template<class T>
 /**
  * Crea string del polígono.
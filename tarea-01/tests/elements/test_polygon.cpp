@@ -21,6 +21,25 @@ void test_creation() {
     poly.add_point(Point<double>(5, 6));
 }
 
+/**
+ * Testea el acceso a los puntos.
+ */
+void test_get_point() {
+    Point<double> plist[] = {Point<double>(1, 2), Point<double>(3, 4), Point<double>(5, 6)};
+    Polygon<double> poly = Polygon<double>(plist, 3);
+    assert(poly.size() == 3);
+    assert(poly.get_point(1).get_coord_x() == 3 && poly.get_point(1).get_coord_y() == 4);
+    poly.add_point(Point<double>(7, 8));
+    assert(poly.size() == 4 && poly.get_point(3).get_coord_y() == 8);
+    bool lanzada = false;
+    try {
+        poly.get_point(4);
+    } catch (const std::logic_error &) {
+        lanzada = true;
+    }
+    assert(lanzada);
+}
+
 /**
  * Testea la implementación de CCW.
  */
@@ -153,6 +172,7 @@ int main() {
 
     // Carga los tests
     test_creation();
+    test_get_point();
     test_poly_ccw();
     test_poly_area();
     test_in_poly();
@@ -3,25 +3,97 @@
  * Código en CPU.
  */
 
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <stdexcept>
+#include <utility>
 #include "GOL.h"
+#include "paralelo.h"
+#include "rng.h"
 
 #define SRAND_VALUE 1998 // Semilla para generar numeros random
 
+/**
+ * Aplica las reglas a una fila contando sólo los vecinos de la máscara. La máscara es un
+ * parámetro del template, así cada vecindad se compila sin ramas ni lecturas de más.
+ *
+ * @param arriba Fila anterior
+ * @param centro Fila actual
+ * @param abajo Fila siguiente
+ * @param salida Fila de salida
+ * @param M Número de columnas, incluye las fantasmas
+ * @param reglas Bit n: nace con n vecinos, bit 9 + n: sobrevive con n vecinos
+ */
+template<int MASCARA>
+static void reglasFila(const bool *arriba, const bool *centro, const bool *abajo, bool *salida, int M,
+                       uint32_t reglas) {
+    for (int j = 1; j < M - 1; j++) {
+        int vivos = 0;
+        if (MASCARA & 0x001) vivos += arriba[j - 1];
+        if (MASCARA & 0x002) vivos += arriba[j];
+        if (MASCARA & 0x004) vivos += arriba[j + 1];
+        if (MASCARA & 0x008) vivos += centro[j - 1];
+        if (MASCARA & 0x020) vivos += centro[j + 1];
+        if (MASCARA & 0x040) vivos += abajo[j - 1];
+        if (MASCARA & 0x080) vivos += abajo[j];
+        if (MASCARA & 0x100) vivos += abajo[j + 1];
+        salida[j] = (reglas >> (vivos + 9 * centro[j])) & 1;
+    }
+}
+
+/**
+ * Tabla con una especialización de reglasFila por cada una de las 256 máscaras, el índice son
+ * los 8 bits de vecinos sin el bit de la celda.
+ */
+template<size_t... K>
+static const FuncionFila *tablaFilas(std::index_sequence<K...>) {
+    static const FuncionFila tabla[] = {reglasFila<(int) ((K & 0x0F) | (K & 0xF0) << 1)>...};
+    return tabla;
+}
+
+/**
+ * Retorna la especialización de reglasFila para una máscara de vecinos.
+ */
+static FuncionFila funcionFila(int mascara) {
+    return tablaFilas(std::make_index_sequence<256>())[(mascara & 0x0F) | (mascara >> 1 & 0xF0)];
+}
+
 /**
  * Constructor, crea matriz tamaño NXM.
  *
  * @param N Número de filas
  * @param M Número de columnas
+ * @param enSitio Actualiza la matriz en sitio, sin matrizAux
+ * @param nHilos Bandas en paralelo del modo en sitio
  */
-GOL::GOL(int N, int M) {
+GOL::GOL(int N, int M, bool enSitio, int nHilos) {
     // Para las filas fantasmas
     this->N = N + 2;
     this->M = M + 2;
+    this->frontera = FRONTERA_FIJA;
+    this->enSitio = enSitio;
+    this->render = nullptr;
+    this->sumas = nullptr;
+    this->sumasBanda = nullptr;
+    this->bandaFila = nullptr;
+    this->bandasSumas = 0;
+    this->sumasValidas = false;
+    setVecindad(VECINDAD_MOORE);
+    setRegla(1 << 3, 1 << 2 | 1 << 3);
 
-    matriz = new bool[this->N * this->M];
-    matrizAux = new bool[this->N * this->M];
+    matriz = new bool[(size_t) this->N * this->M];
+    if (enSitio) {
+        if (nHilos < 1) nHilos = hilosDisponibles();
+        bandas = std::max(1, std::min(nHilos, N));
+        matrizAux = nullptr;
+        filasGuardadas = new bool[4 * (size_t) bandas * this->M];
+    } else {
+        bandas = 1;
+        matrizAux = new bool[(size_t) this->N * this->M];
+        filasGuardadas = nullptr;
+    }
 }
 
 /**
@@ -30,25 +102,35 @@ GOL::GOL(int N, int M) {
 GOL::~GOL() {
     delete[] matriz;
     delete[] matrizAux;
+    delete[] filasGuardadas;
+    delete render;
+    delete[] sumas;
+    delete[] sumasBanda;
+    delete[] bandaFila;
 }
 
 /**
  * Imprime la grilla.
  */
 void GOL::printGrid() {
+    printGrid(RENDER_TEXTO, 0, 0);
+}
+
+/**
+ * Imprime la grilla reducida a un tamaño máximo, el cuadro se arma en un buffer y se escribe
+ * de una vez.
+ *
+ * @param modo Forma de dibujar las celdas
+ * @param filas Filas máximas de texto
+ * @param columnas Columnas máximas de texto
+ */
+void GOL::printGrid(ModoRender modo, int filas, int columnas) {
+    if (!render) render = new GOLRender();
+    render->configurar(modo, filas, columnas);
+
     // No imprime las celdas fantasmas
-    for (int a = 1; a < N - 1; a++) {
-        for (int b = 1; b < M - 1; b++) {
-            if (!matriz[a * M + b]) {
-                std::cout << " . ";
-            } else {
-                std::cout << " O ";
-            }
-            if (b == M - 2) {
-                std::cout << std::endl;
-            }
-        }
-    }
+    render->dibujar(matriz + M + 1, N - 2, M - 2, (size_t) M);
+    render->emitir();
 }
 
 /**
@@ -57,10 +139,11 @@ void GOL::printGrid() {
 void GOL::setMatrizToFalse() {
     for (int a = 0; a < N; a++) {
         for (int b = 0; b < M; b++) {
-            matriz[a * M + b] = false;
-            matrizAux[a * M + b] = false;
+            matriz[(size_t) a * M + b] = false;
+            if (matrizAux) matrizAux[(size_t) a * M + b] = false;
         }
     }
+    sumasValidas = false;
 }
 
 /**
@@ -68,38 +151,153 @@ void GOL::setMatrizToFalse() {
  */
 void GOL::aplicarReglas() {
 
-    // Reglas generales
-    for (int i = 1; i < N - 1; i++) {
-        for (int j = 1; j < M - 1; j++) {
+    // Actualiza las filas fantasmas si el tablero es periódico
+    if (frontera == FRONTERA_TOROIDAL) {
+        copiarBordesToroidales();
+    }
 
-            // Calculamos cantidad de vecinos vivos
-            int vivos = 0;
-            for (int k = -1; k < 2; k++) {
-                for (int p = -1; p < 2; p++) {
-                    if (!(k == 0 && p == 0)) {
-                        if (matriz[(i + k) * M + (j + p)]) {
-                            vivos++;
-                        }
-                    }
-                }
-            }
+    if (enSitio) {
+        aplicarReglasEnSitio();
+        return;
+    }
 
-            // Reglas del juego
-            if ((vivos == 2 || vivos == 3) && matriz[i * M + j]) {
-                matrizAux[i * M + j] = true;
-            } else if (vivos == 3 && !matriz[i * M + j]) {
-                matrizAux[i * M + j] = true;
-            } else { //muere de otra forma
-                matrizAux[i * M + j] = false;
-            }
-        }
+    // Reglas generales, la paridad se cuenta desde la primera fila real
+    for (int i = 1; i < N - 1; i++) {
+        FuncionFila reglasFila = (i - 1) & 1 ? filaImpar : filaPar;
+        reglasFila(matriz + (size_t) (i - 1) * M, matriz + (size_t) i * M, matriz + (size_t) (i + 1) * M,
+                   matrizAux + (size_t) i * M, M, reglas);
+        if (sumas) acumularFila(i, matrizAux + (size_t) i * M);
     }
 
     // Cambiamos punteros
     aux = matriz;
     matriz = matrizAux;
     matrizAux = aux;
+    if (sumas) {
+        acumularBandas();
+        sumasValidas = true;
+    }
+
+}
+
+/**
+ * Aplica las reglas sobre la misma matriz. Cada banda de filas recorre sus filas de arriba hacia
+ * abajo guardando la fila actual antes de sobrescribirla, así la fila anterior sigue disponible
+ * para la siguiente. Las filas vecinas de cada banda se copian antes de lanzar los hilos, ya que
+ * la banda de al lado las sobrescribe.
+ */
+void GOL::aplicarReglasEnSitio() {
+    int filas = N - 2;
+
+    // Fila vecina de arriba y de abajo de cada banda, misma división que paraleloBandasIndice
+    for (int t = 0; t < bandas; t++) {
+        int a = 1 + (int) ((long long) filas * t / bandas);
+        int b = 1 + (int) ((long long) filas * (t + 1) / bandas);
+        bool *guardadas = filasGuardadas + 4 * (size_t) t * M;
+        memcpy(guardadas, matriz + (size_t) (a - 1) * M, M);
+        memcpy(guardadas + M, matriz + (size_t) b * M, M);
+    }
+
+    paraleloBandasIndice(1, N - 1, bandas, [this](int t, int a, int b) {
+        bool *guardadas = filasGuardadas + 4 * (size_t) t * M;
+        const bool *abajoBanda = guardadas + M;
+        bool *anterior = guardadas + 2 * (size_t) M;
+        bool *actual = guardadas + 3 * (size_t) M;
+
+        // La fila anterior a la banda parte desde la copia
+        memcpy(anterior, guardadas, M);
+        for (int i = a; i < b; i++) {
+            bool *fila = matriz + (size_t) i * M;
+            const bool *abajo = i == b - 1 ? abajoBanda : fila + M;
+            memcpy(actual, fila, M);
+            ((i - 1) & 1 ? filaImpar : filaPar)(anterior, actual, abajo, fila, M, reglas);
+            if (sumas) acumularFila(i, fila); // La fila sigue en caché
+            std::swap(anterior, actual);
+        }
+    });
+    if (sumas) {
+        acumularBandas();
+        sumasValidas = true;
+    }
+}
+
+/**
+ * Acumula una fila recién calculada en la tabla de sumas, la primera fila de cada banda de sumas
+ * parte desde cero.
+ *
+ * @param i Fila, incluye la fila fantasma
+ * @param fila Celdas de la fila, incluye las columnas fantasmas
+ */
+void GOL::acumularFila(int i, const bool *fila) {
+    uint32_t *suma = sumas + (size_t) (i - 1) * (M - 1);
+    uint32_t acumulado = 0;
+    suma[0] = 0;
+    if (i == 1 || bandaFila[i - 1] != bandaFila[i - 2]) {
+        for (int j = 1; j < M - 1; j++) {
+            acumulado += fila[j];
+            suma[j] = acumulado;
+        }
+    } else {
+        const uint32_t *anterior = suma - (M - 1);
+        for (int j = 1; j < M - 1; j++) {
+            acumulado += fila[j];
+            suma[j] = anterior[j] + acumulado;
+        }
+    }
+}
+
+/**
+ * Calcula las sumas de las filas anteriores a cada banda, O(bandasSumas * M).
+ */
+void GOL::acumularBandas() {
+    int filas = N - 2;
+    for (int j = 0; j < M - 1; j++) sumasBanda[j] = 0;
+    for (int t = 1; t < bandasSumas; t++) {
+        int ultima = (int) ((long long) filas * t / bandasSumas) - 1; // Última fila real de la banda t - 1
+        const uint32_t *suma = sumas + (size_t) ultima * (M - 1);
+        const long long *anterior = sumasBanda + (size_t) (t - 1) * (M - 1);
+        long long *actual = sumasBanda + (size_t) t * (M - 1);
+        for (int j = 0; j < M - 1; j++) actual[j] = anterior[j] + suma[j];
+    }
+}
+
+/**
+ * Arma la tabla de sumas recorriendo la matriz, con las mismas bandas que aplicarReglas.
+ */
+void GOL::calcularSumas() {
+    paraleloBandasIndice(1, N - 1, bandas, [this](int t, int a, int b) {
+        (void) t;
+        for (int i = a; i < b; i++) acumularFila(i, matriz + (size_t) i * M);
+    });
+    acumularBandas();
+    sumasValidas = true;
+}
 
+/**
+ * Celdas vivas en un prefijo del tablero.
+ *
+ * @param i Filas reales [0, i)
+ * @param j Columnas reales [0, j)
+ */
+long long GOL::sumaPrefijo(int i, int j) const {
+    if (i == 0) return 0;
+    size_t k = (size_t) (i - 1) * (M - 1) + j;
+    return sumas[k] + sumasBanda[(size_t) bandaFila[i - 1] * (M - 1) + j];
+}
+
+/**
+ * Copia las filas y columnas reales del lado opuesto en las fantasmas, primero las filas y luego
+ * las columnas (incluyendo las esquinas), igual que ghostRows y ghostCols en CUDA y OpenCL.
+ */
+void GOL::copiarBordesToroidales() {
+    for (int j = 1; j < M - 1; j++) {
+        matriz[j] = matriz[(size_t) (N - 2) * M + j];
+        matriz[(size_t) (N - 1) * M + j] = matriz[M + j];
+    }
+    for (int i = 0; i < N; i++) {
+        matriz[(size_t) i * M] = matriz[(size_t) i * M + M - 2];
+        matriz[(size_t) i * M + M - 1] = matriz[(size_t) i * M + 1];
+    }
 }
 
 /**
@@ -107,17 +305,21 @@ void GOL::aplicarReglas() {
  */
 void GOL::inicializarBordesMatriz() {
     for (int i = 0; i < N; i++) {
-        matriz[i * M + 0] = true;
-        matrizAux[i * M + 0] = true;
-        matriz[i * M + M - 1] = true;
-        matrizAux[i * M + M - 1] = true;
+        matriz[(size_t) i * M + 0] = true;
+        matriz[(size_t) i * M + M - 1] = true;
+        if (matrizAux) {
+            matrizAux[(size_t) i * M + 0] = true;
+            matrizAux[(size_t) i * M + M - 1] = true;
+        }
     }
 
     for (int i = 0; i < M; i++) {
         matriz[i] = true;
-        matrizAux[i] = true;
-        matriz[(N - 1) * M + i] = true;
-        matrizAux[(N - 1) * M + i] = true;
+        matriz[(size_t) (N - 1) * M + i] = true;
+        if (matrizAux) {
+            matrizAux[i] = true;
+            matrizAux[(size_t) (N - 1) * M + i] = true;
+        }
     }
 }
 
@@ -127,17 +329,305 @@ void GOL::inicializarBordesMatriz() {
  * @param probTrue Probabilidad
  */
 void GOL::inicializarMatrizRandom(int probTrue) {
+    inicializarMatrizRandom(probTrue, SRAND_VALUE);
+}
 
-    // Aplica semilla para generación valores aleatorios
-    srand(SRAND_VALUE);
+/**
+ * Funcion que inicializa las matrices en paralelo con el generador basado en contador de rng.h,
+ * no modifica las filas fantasmas.
+ *
+ * @param probTrue Probabilidad
+ * @param seed Semilla
+ * @param nHilos Cantidad de hilos
+ */
+void GOL::inicializarMatrizRandom(int probTrue, unsigned long long seed, int nHilos) {
+    paraleloBandas(1, N - 1, nHilos, [this, probTrue, seed](int a, int b) {
+        for (int i = a; i < b; i++) {
+            unsigned long long base = (unsigned long long) (i - 1) * (M - 2);
+            for (int j = 1; j < M - 1; j++) {
+                bool v = celdaAleatoria(seed, base + j - 1, probTrue);
+                matriz[(size_t) i * M + j] = v;
+                if (matrizAux) matrizAux[(size_t) i * M + j] = v;
+            }
+        }
+    });
+    sumasValidas = false;
+}
+
+/**
+ * Copia las celdas reales fila por fila.
+ *
+ * @param destino Arreglo de N * M celdas, sin contar las fantasmas
+ */
+void GOL::copiarTablero(bool *destino) const {
+    for (int i = 1; i < N - 1; i++) {
+        memcpy(destino + (size_t) (i - 1) * (M - 2), matriz + (size_t) i * M + 1, M - 2);
+    }
+}
+
+/**
+ * Retorna el valor de una celda.
+ *
+ * @param i Fila, sin contar las filas fantasmas
+ * @param j Columna, sin contar las columnas fantasmas
+ * @return Estado de la celda
+ */
+bool GOL::getCelda(int i, int j) const {
+    return matriz[(size_t) (i + 1) * M + j + 1];
+}
+
+/**
+ * Retorna las celdas reales de una fila.
+ *
+ * @param i Fila, sin contar las filas fantasmas
+ */
+const bool *GOL::getFila(int i) const {
+    return matriz + (size_t) (i + 1) * M + 1;
+}
+
+/**
+ * Retorna la primera celda real para escribir el tablero sin pasar por setCeldas. Las celdas
+ * fantasmas se actualizan en la siguiente aplicación de reglas.
+ *
+ * @return Celda (0, 0), la fila i empieza getColumnas() + 2 celdas después de la fila i - 1
+ */
+bool *GOL::editarTablero() {
+    sumasValidas = false;
+    return matriz + M + 1;
+}
+
+/**
+ * Cambia n celdas consecutivas de una fila, recortando al tablero.
+ *
+ * @param i Fila, sin contar las filas fantasmas
+ * @param j Primera columna, sin contar las columnas fantasmas
+ * @param n Cantidad de celdas
+ * @param valor Nuevo estado
+ */
+void GOL::setCeldas(int i, int j, int n, bool valor) {
+    if (i < 0 || i >= N - 2) return;
+    int j1 = std::min(j + n, M - 2);
+    if (j < 0) j = 0;
+    if (j >= j1) return;
+    memset(matriz + (size_t) (i + 1) * M + j + 1, valor, (size_t) (j1 - j));
+    sumasValidas = false;
+}
+
+/**
+ * Invierte n celdas consecutivas de una fila, recortando al tablero.
+ *
+ * @param i Fila, sin contar las filas fantasmas
+ * @param j Primera columna, sin contar las columnas fantasmas
+ * @param n Cantidad de celdas
+ */
+void GOL::invertirCeldas(int i, int j, int n) {
+    if (i < 0 || i >= N - 2) return;
+    int j1 = std::min(j + n, M - 2);
+    if (j < 0) j = 0;
+    bool *celda = matriz + (size_t) (i + 1) * M + 1;
+    for (int k = j; k < j1; k++) celda[k] = !celda[k];
+    sumasValidas = false;
+}
+
+/**
+ * Cuenta las celdas vivas.
+ *
+ * @return Población
+ */
+long long GOL::contarPoblacion() const {
+    long long vivas = 0;
     for (int i = 1; i < N - 1; i++) {
         for (int j = 1; j < M - 1; j++) {
-            int numero = std::rand() % 100;
-            if (numero < probTrue) {
-                matriz[i * M + j] = true;
-                matrizAux[i * M + j] = true;
-            }
+            vivas += matriz[(size_t) i * M + j];
         }
     }
+    return vivas;
+}
+
+/**
+ * Activa o libera la tabla de sumas acumuladas.
+ *
+ * @param activar Activa la tabla
+ */
+void GOL::activarSumas(bool activar) {
+    delete[] sumas;
+    delete[] sumasBanda;
+    delete[] bandaFila;
+    sumas = nullptr;
+    sumasBanda = nullptr;
+    bandaFila = nullptr;
+    sumasValidas = false;
+    if (!activar) return;
 
-}
\ No newline at end of file
+    // Cada banda de hilos se divide en k bandas de sumas hasta que las sumas de una banda quepan
+    // en 32 bits. Con la misma división entera los bordes de las bandas de hilos siguen siendo
+    // bordes, así ninguna banda de sumas cruza dos hilos
+    int filas = N - 2;
+    int k = 1;
+    while (((long long) filas + (long long) bandas * k - 1) / ((long long) bandas * k) * (M - 1) > LIMITE_SUMA_BANDA) {
+        k++;
+    }
+    bandasSumas = bandas * k;
+    sumas = new uint32_t[(size_t) filas * (M - 1)];
+    sumasBanda = new long long[(size_t) bandasSumas * (M - 1)];
+    bandaFila = new int[filas];
+    for (int t = 0; t < bandasSumas; t++) {
+        int a = (int) ((long long) filas * t / bandasSumas);
+        int b = (int) ((long long) filas * (t + 1) / bandasSumas);
+        for (int i = a; i < b; i++) bandaFila[i] = t;
+    }
+}
+
+/**
+ * Cuenta las celdas vivas de un rectángulo.
+ *
+ * @param i0 Primera fila
+ * @param j0 Primera columna
+ * @param alto Filas
+ * @param ancho Columnas
+ * @return Celdas vivas
+ */
+long long GOL::contarRegion(int i0, int j0, int alto, int ancho) {
+    int i1 = std::min(i0 + alto, N - 2), j1 = std::min(j0 + ancho, M - 2);
+    i0 = std::max(i0, 0);
+    j0 = std::max(j0, 0);
+    if (i0 >= i1 || j0 >= j1) return 0;
+
+    if (!sumas) {
+        long long vivas = 0;
+        for (int i = i0; i < i1; i++) {
+            const bool *fila = getFila(i);
+            for (int j = j0; j < j1; j++) vivas += fila[j];
+        }
+        return vivas;
+    }
+    if (!sumasValidas) calcularSumas();
+    return sumaPrefijo(i1, j1) - sumaPrefijo(i0, j1) - sumaPrefijo(i1, j0) + sumaPrefijo(i0, j0);
+}
+
+/**
+ * Mapa de densidad de una ventana, cada bloque cubre la ventana en partes iguales.
+ *
+ * @param i0 Primera fila de la ventana
+ * @param j0 Primera columna de la ventana
+ * @param alto Filas de la ventana
+ * @param ancho Columnas de la ventana
+ * @param filas Filas del mapa
+ * @param columnas Columnas del mapa
+ * @param destino Valores del mapa, de 0 (vacío) a 255 (lleno)
+ */
+void GOL::mapaDensidad(int i0, int j0, int alto, int ancho, int filas, int columnas, uint8_t *destino) {
+    for (int y = 0; y < filas; y++) {
+        int a = i0 + (int) ((long long) alto * y / filas);
+        int b = i0 + (int) ((long long) alto * (y + 1) / filas);
+        if (b == a) b = a + 1; // Con más filas que la ventana los bloques se repiten
+        for (int x = 0; x < columnas; x++) {
+            int c = j0 + (int) ((long long) ancho * x / columnas);
+            int d = j0 + (int) ((long long) ancho * (x + 1) / columnas);
+            if (d == c) d = c + 1;
+            long long area = (long long) (b - a) * (d - c);
+            long long vivas = contarRegion(a, c, b - a, d - c);
+            destino[y * columnas + x] = area > 0 ? (uint8_t) (255 * vivas / area) : 0;
+        }
+    }
+}
+
+/**
+ * Cambia la vecindad.
+ *
+ * @param vecindad Vecindad
+ */
+void GOL::setVecindad(Vecindad vecindad) {
+    switch (vecindad) {
+        case VECINDAD_VON_NEUMANN:
+            setMascaraVecinos(MASCARA_VON_NEUMANN);
+            break;
+        case VECINDAD_HEXAGONAL:
+            filaPar = funcionFila(MASCARA_HEX_PAR);
+            filaImpar = funcionFila(MASCARA_HEX_IMPAR);
+            break;
+        default:
+            setMascaraVecinos(MASCARA_MOORE);
+    }
+}
+
+/**
+ * Usa una vecindad arbitraria de 3x3.
+ *
+ * @param mascara Máscara de vecinos
+ */
+void GOL::setMascaraVecinos(int mascara) {
+    filaPar = funcionFila(mascara);
+    filaImpar = filaPar;
+}
+
+/**
+ * Cambia las reglas.
+ *
+ * @param nacer Vecinos con los que nace una celda, un bit por cantidad
+ * @param sobrevivir Vecinos con los que sobrevive una celda, un bit por cantidad
+ */
+void GOL::setRegla(int nacer, int sobrevivir) {
+    reglas = (uint32_t) (nacer & 0x1FF) | (uint32_t) (sobrevivir & 0x1FF) << 9;
+}
+
+/**
+ * Cambia las reglas desde el formato B/S.
+ *
+ * @param regla Regla, por ejemplo "B3/S23"
+ */
+void GOL::setRegla(const std::string &regla) {
+    int mascaras[2] = {0, 0};
+    bool vistas[2] = {false, false};
+    size_t k = 0;
+    while (k < regla.size()) {
+        char letra = regla[k] == 'b' || regla[k] == 'B' ? 'B' : regla[k] == 's' || regla[k] == 'S' ? 'S' : 0;
+        int parte = letra == 'B' ? 0 : 1;
+        if (!letra || vistas[parte]) break;
+        vistas[parte] = true;
+        for (k++; k < regla.size() && regla[k] >= '0' && regla[k] <= '8'; k++) {
+            mascaras[parte] |= 1 << (regla[k] - '0');
+        }
+        if (k < regla.size() && regla[k] == '/') k++;
+    }
+    if (k < regla.size() || !vistas[0] || !vistas[1]) {
+        throw std::invalid_argument("Regla no válida: " + regla);
+    }
+    setRegla(mascaras[0], mascaras[1]);
+}
+
+/**
+ * Cambia la condición de borde.
+ *
+ * @param frontera Condición de borde
+ */
+void GOL::setFrontera(Frontera frontera) {
+    this->frontera = frontera;
+}
+
+/**
+ * Retorna el número de filas reales.
+ */
+int GOL::getFilas() const {
+    return N - 2;
+}
+
+/**
+ * Retorna el número de columnas reales.
+ */
+int GOL::getColumnas() const {
+    return M - 2;
+}
+
+/**
+ * Bytes usados por las matrices, las filas guardadas y la tabla de sumas.
+ */
+size_t GOL::memoria() const {
+    size_t celdas = (size_t) N * M;
+    size_t bytes = enSitio ? sizeof(bool) * (celdas + 4 * (size_t) bandas * M) : 2 * sizeof(bool) * celdas;
+    if (sumas) {
+        bytes += sizeof(uint32_t) * (size_t) (N - 2) * (M - 1) + sizeof(long long) * (size_t) bandasSumas * (M - 1) +
+                 sizeof(int) * (size_t) (N - 2);
+    }
+    return bytes;
+}
@@ -6,6 +6,40 @@
 #ifndef GAMEOFLIFECPU_GOL_H
 #define GAMEOFLIFECPU_GOL_H
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "render.h"
+
+// Condición de borde del tablero
+enum Frontera {
+    FRONTERA_FIJA,      // Las filas fantasmas no cambian (ver inicializarBordesMatriz)
+    FRONTERA_TOROIDAL   // Las filas fantasmas copian el lado opuesto, igual que en CUDA y OpenCL
+};
+
+// Vecindad de cada celda
+enum Vecindad {
+    VECINDAD_MOORE,         // 8 vecinos
+    VECINDAD_VON_NEUMANN,   // 4 vecinos ortogonales
+    VECINDAD_HEXAGONAL      // 6 vecinos, las filas impares están desplazadas media celda a la derecha
+};
+
+// Máscaras de vecinos de 3x3, el bit 3 * (di + 1) + (dj + 1) es el vecino (i + di, j + dj). El
+// bit 4 (la celda) se ignora
+#define MASCARA_MOORE 0x1EF
+#define MASCARA_VON_NEUMANN 0x0AA
+#define MASCARA_HEX_PAR 0x0EB
+#define MASCARA_HEX_IMPAR 0x1AE
+
+// Suma máxima de una banda de la tabla de sumas, que guarda enteros de 32 bits
+#ifndef LIMITE_SUMA_BANDA
+#define LIMITE_SUMA_BANDA 0xFFFFFFFFLL
+#endif
+
+// Aplica las reglas a las columnas [1, M - 1) de una fila, ver GOL.cpp
+typedef void (*FuncionFila)(const bool *arriba, const bool *centro, const bool *abajo, bool *salida, int M,
+                            uint32_t reglas);
+
 class GOL {
 private:
 
@@ -18,10 +52,64 @@ private:
     bool *matrizAux;
     bool *aux;
 
+    // Condición de borde
+    Frontera frontera;
+
+    // Reglas de las filas pares e impares (distintas sólo en la vecindad hexagonal), cada una
+    // especializada para su máscara de vecinos. El bit n de reglas indica si nace una celda con
+    // n vecinos y el bit 9 + n si sobrevive
+    FuncionFila filaPar;
+    FuncionFila filaImpar;
+    uint32_t reglas;
+
+    // Actualización en sitio, sin matrizAux. Cada banda guarda 4 filas: la fila fantasma de
+    // arriba y de abajo de la banda, y la fila anterior y actual antes de sobrescribirlas
+    bool enSitio;
+    int bandas;
+    bool *filasGuardadas;
+
+    // Dibuja la matriz, se crea en el primer printGrid y reutiliza su buffer
+    GOLRender *render;
+
+    // Tabla de sumas acumuladas, se arma fila a fila al aplicar las reglas. Por cada fila real
+    // guarda M - 1 sumas de las celdas vivas desde el inicio de su banda, y por cada banda las
+    // sumas de todas las filas anteriores a ella. nullptr si no está activa. Las bandas de sumas
+    // dividen a las de los hilos para que ninguna pase de LIMITE_SUMA_BANDA
+    uint32_t *sumas;
+    long long *sumasBanda;
+    int *bandaFila;
+    int bandasSumas;
+    bool sumasValidas;
+
+    // Acumula la fila i (con celdas nuevas en fila) en la tabla
+    void acumularFila(int i, const bool *fila);
+
+    // Calcula las sumas de cada banda a partir de la última fila de la anterior
+    void acumularBandas();
+
+    // Arma la tabla completa desde matriz, tras modificar las celdas fuera de aplicarReglas
+    void calcularSumas();
+
+    // Celdas vivas en las filas [0, i) y columnas [0, j), sin contar las fantasmas
+    long long sumaPrefijo(int i, int j) const;
+
+    // Aplica las reglas sobre matriz guardando solo las filas que aún se necesitan
+    void aplicarReglasEnSitio();
+
+    // Copia las filas y columnas reales del lado opuesto en las fantasmas
+    void copiarBordesToroidales();
+
 public:
 
-    // Constructor
-    GOL(int N, int M);
+    /* Constructor, crea matriz tamaño NXM.
+     *
+     * @Param N: Número de filas.
+     * @Param M: Número de columnas.
+     * @Param enSitio: Usa una sola matriz y una ventana de filas guardadas por banda, cerca de la
+     *                 mitad de la memoria.
+     * @Param nHilos: Bandas en paralelo del modo en sitio, 0 usa todos los núcleos.
+     */
+    GOL(int N, int M, bool enSitio = false, int nHilos = 1);
 
     // Destructor
     virtual ~GOL();
@@ -29,6 +117,15 @@ public:
     // Método que imprime la matriz en pantalla. No incliye las filas fantasmas
     void printGrid();
 
+    /* Imprime la matriz reducida a un tamaño máximo en una sola escritura. No incluye las filas
+     * fantasmas.
+     *
+     * @Param modo: Forma de dibujar las celdas.
+     * @Param filas: Filas máximas de texto, 0 no limita.
+     * @Param columnas: Columnas máximas de texto, 0 no limita.
+     */
+    void printGrid(ModoRender modo, int filas, int columnas);
+
     // Método que cambia todas las celdas a falso. Incluye las filas fantasmas
     void setMatrizToFalse();
 
@@ -45,6 +142,114 @@ public:
      */
     void inicializarMatrizRandom(int probTrue);
 
+    /* Funcion que inicializa las matrices en paralelo usando un generador basado en contador,
+     * el tablero resultante es el mismo en CPU, CUDA y OpenCL. No modifica las filas fantasmas.
+     *
+     * @Param probTrue: Probabilidad de que una celda sea verdadera.
+     * @Param seed: Semilla.
+     * @Param nHilos: Cantidad de hilos, 0 usa todos los núcleos.
+     */
+    void inicializarMatrizRandom(int probTrue, unsigned long long seed, int nHilos = 0);
+
+    // Copia las celdas reales fila por fila en destino, de N * M celdas
+    void copiarTablero(bool *destino) const;
+
+    // Retorna el valor de una celda, (0, 0) es la primera celda real
+    bool getCelda(int i, int j) const;
+
+    // Retorna las celdas reales de la fila i, sin la columna fantasma
+    const bool *getFila(int i) const;
+
+    // Retorna la fila 0 para escribir el tablero directo (filas a getColumnas() + 2 celdas), por
+    // ejemplo desde varios hilos en filas distintas. Invalida la tabla de sumas
+    bool *editarTablero();
+
+    /* Cambia n celdas consecutivas de una fila, las que quedan fuera del tablero se ignoran.
+     *
+     * @Param i: Fila, (0, 0) es la primera celda real.
+     * @Param j: Primera columna.
+     * @Param n: Cantidad de celdas.
+     * @Param valor: Nuevo estado.
+     */
+    void setCeldas(int i, int j, int n, bool valor);
+
+    // Invierte n celdas consecutivas de una fila, igual que setCeldas
+    void invertirCeldas(int i, int j, int n);
+
+    // Cuenta las celdas vivas, no incluye las filas fantasmas
+    long long contarPoblacion() const;
+
+    // Cambia la condición de borde, por defecto FRONTERA_FIJA
+    void setFrontera(Frontera frontera);
+
+    /* Activa la tabla de sumas acumuladas, aplicarReglas la actualiza al calcular cada fila y
+     * contarRegion responde en O(1). Usa 4 bytes por celda; en tableros de más de 2^32 celdas
+     * las filas se dividen en más bandas para que las sumas de 32 bits no se desborden.
+     *
+     * @Param activar: Activa o libera la tabla.
+     */
+    void activarSumas(bool activar);
+
+    /* Cuenta las celdas vivas de un rectángulo, recortado al tablero. Con la tabla de sumas
+     * activa toma O(1), si no recorre la matriz.
+     *
+     * @Param i0: Primera fila.
+     * @Param j0: Primera columna.
+     * @Param alto: Filas.
+     * @Param ancho: Columnas.
+     * @Return: Celdas vivas.
+     */
+    long long contarRegion(int i0, int j0, int alto, int ancho);
+
+    /* Mapa de densidad de una ventana del tablero, cada valor es la fracción de celdas vivas de
+     * su bloque escalada a [0, 255]. Con la tabla de sumas cuesta O(filas * columnas) sin
+     * importar el tamaño de la ventana, por lo que sirve para hacer zoom.
+     *
+     * @Param i0: Primera fila de la ventana.
+     * @Param j0: Primera columna de la ventana.
+     * @Param alto: Filas de la ventana.
+     * @Param ancho: Columnas de la ventana.
+     * @Param filas: Filas del mapa.
+     * @Param columnas: Columnas del mapa.
+     * @Param destino: Arreglo de filas * columnas valores.
+     */
+    void mapaDensidad(int i0, int j0, int alto, int ancho, int filas, int columnas, uint8_t *destino);
+
+    /* Cambia la vecindad. Con frontera toroidal y vecindad hexagonal N debe ser par.
+     *
+     * @Param vecindad: Vecindad, por defecto VECINDAD_MOORE.
+     */
+    void setVecindad(Vecindad vecindad);
+
+    /* Usa una vecindad arbitraria dentro del cuadrado de 3x3.
+     *
+     * @Param mascara: Máscara de vecinos (ver MASCARA_MOORE).
+     */
+    void setMascaraVecinos(int mascara);
+
+    /* Cambia las reglas, por defecto B3/S23.
+     *
+     * @Param nacer: El bit n indica que nace una celda muerta con n vecinos.
+     * @Param sobrevivir: El bit n indica que sobrevive una celda viva con n vecinos.
+     */
+    void setRegla(int nacer, int sobrevivir);
+
+    /* Cambia las reglas desde el formato B/S, por ejemplo "B36/S23". Lanza
+     * std::invalid_argument si el formato no es válido.
+     *
+     * @Param regla: Regla.
+     */
+    void setRegla(const std::string &regla);
+
+    // Número de filas sin contar las filas fantasmas
+    int getFilas() const;
+
+    // Número de columnas sin contar las columnas fantasmas
+    int getColumnas() const;
+
+    // Bytes usados por las matrices, las filas guardadas y la tabla de sumas
+    size_t memoria() const;
+
 };
 
 #endif // GAMEOFLIFECPU_GOL_H
\ No newline at end of file
@@ -0,0 +1,138 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Topología de la máquina y asignación de bandas a núcleos.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include "afinidad.h"
+#include "paralelo.h"
+
+/**
+ * Lee un entero de un archivo de /sys, retorna defecto si no existe.
+ */
+static int leerEntero(const std::string &ruta, int defecto) {
+    std::ifstream infile(ruta);
+    int valor;
+    if (infile >> valor) return valor;
+    return defecto;
+}
+
+/**
+ * Lee la lista de núcleos de la forma "0-3,8,10-11".
+ */
+static std::vector<int> leerLista(const std::string &ruta) {
+    std::vector<int> lista;
+    std::ifstream infile(ruta);
+    std::string texto, rango;
+    if (!std::getline(infile, texto)) return lista;
+    std::stringstream ss(texto);
+    while (std::getline(ss, rango, ',')) {
+        int a, b;
+        if (sscanf(rango.c_str(), "%d-%d", &a, &b) == 2) {
+            for (int c = a; c <= b; c++) lista.push_back(c);
+        } else if (sscanf(rango.c_str(), "%d", &a) == 1) {
+            lista.push_back(a);
+        }
+    }
+    return lista;
+}
+
+/**
+ * Id de la caché L3 de un núcleo, busca el índice de nivel 3.
+ */
+static int leerL3(int cpu) {
+    std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cache/index";
+    for (int k = 0; k < 8; k++) {
+        if (leerEntero(base + std::to_string(k) + "/level", 0) != 3) continue;
+        int id = leerEntero(base + std::to_string(k) + "/id", -1);
+        if (id >= 0) return id;
+
+        // Kernels sin id, se usa el primer núcleo que comparte la caché
+        std::vector<int> compartida = leerLista(base + std::to_string(k) + "/shared_cpu_list");
+        return compartida.empty() ? -1 : compartida[0];
+    }
+    return -1;
+}
+
+/**
+ * Lee los núcleos permitidos al proceso.
+ */
+std::vector<Nucleo> leerTopologia() {
+    std::vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t conjunto;
+    if (sched_getaffinity(0, sizeof(conjunto), &conjunto) == 0) {
+        for (int c = 0; c < CPU_SETSIZE; c++) {
+            if (CPU_ISSET(c, &conjunto)) cpus.push_back(c);
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        for (int c = 0; c < hilosDisponibles(); c++) cpus.push_back(c);
+    }
+
+    std::vector<Nucleo> nucleos;
+    for (int c : cpus) {
+        std::string topologia = "/sys/devices/system/cpu/cpu" + std::to_string(c) + "/topology/";
+        Nucleo n;
+        n.cpu = c;
+        n.socket = leerEntero(topologia + "physical_package_id", 0);
+        n.core = leerEntero(topologia + "core_id", c);
+        n.l3 = leerL3(c);
+        std::vector<int> hermanos = leerLista(topologia + "thread_siblings_list");
+        n.hermano = !hermanos.empty() && hermanos[0] != c;
+        nucleos.push_back(n);
+    }
+    return nucleos;
+}
+
+/**
+ * Ordena los núcleos y asigna uno por banda.
+ *
+ * @param nucleos Núcleos de leerTopologia
+ * @param nHilos Cantidad de bandas
+ * @return Núcleos de cada banda
+ */
+std::vector<Nucleo> asignarBandas(const std::vector<Nucleo> &nucleos, int nHilos) {
+    std::vector<Nucleo> orden = nucleos;
+    std::sort(orden.begin(), orden.end(), [](const Nucleo &a, const Nucleo &b) {
+        if (a.hermano != b.hermano) return !a.hermano;
+        if (a.socket != b.socket) return a.socket < b.socket;
+        if (a.l3 != b.l3) return a.l3 < b.l3;
+        if (a.core != b.core) return a.core < b.core;
+        return a.cpu < b.cpu;
+    });
+    if (nHilos < 1) nHilos = (int) orden.size();
+
+    std::vector<Nucleo> asignados;
+    for (int t = 0; t < nHilos && !orden.empty(); t++) {
+        asignados.push_back(orden[t % orden.size()]);
+    }
+    return asignados;
+}
+
+/**
+ * Fija los hilos de paraleloBandas y retorna la asignación en texto.
+ *
+ * @param nHilos Cantidad de bandas
+ */
+std::string activarAfinidad(int nHilos) {
+    nucleosBandas().clear();
+    if (nHilos < 0) return "";
+
+    std::vector<Nucleo> asignados = asignarBandas(leerTopologia(), nHilos == 0 ? hilosDisponibles() : nHilos);
+    std::string texto;
+    char linea[128];
+    for (size_t t = 0; t < asignados.size(); t++) {
+        const Nucleo &n = asignados[t];
+        nucleosBandas().push_back(n.cpu);
+        snprintf(linea, sizeof(linea), "banda %zu -> cpu %d (socket %d, L3 %d, core %d%s)\n", t, n.cpu, n.socket,
+                 n.l3, n.core, n.hermano ? ", SMT" : "");
+        texto += linea;
+    }
+    return texto;
+}
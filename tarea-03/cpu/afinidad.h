@@ -0,0 +1,42 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Topología de la máquina y asignación de bandas a núcleos, las bandas vecinas quedan en
+ * núcleos que comparten caché L3 y socket.
+ */
+
+#ifndef GAMEOFLIFECPU_AFINIDAD_H
+#define GAMEOFLIFECPU_AFINIDAD_H
+
+#include <string>
+#include <vector>
+
+// Núcleo lógico de la máquina
+struct Nucleo {
+    int cpu;        // Número del núcleo lógico
+    int socket;     // physical_package_id
+    int l3;         // Id de la caché L3, -1 si no se conoce
+    int core;       // core_id dentro del socket
+    bool hermano;   // Segundo hilo (SMT) de un núcleo físico ya listado
+};
+
+// Lee los núcleos permitidos al proceso desde /sys, sin topología retorna un socket y una L3
+std::vector<Nucleo> leerTopologia();
+
+/* Ordena los núcleos para asignar bandas: primero un hilo por núcleo físico, agrupados por
+ * socket y L3, luego los hermanos SMT en el mismo orden. Bandas consecutivas quedan en núcleos
+ * que comparten caché.
+ *
+ * @Param nucleos: Núcleos de leerTopologia.
+ * @Param nHilos: Cantidad de bandas, 0 usa todos los núcleos.
+ * @Return: Núcleos asignados a las bandas 0 .. nHilos - 1.
+ */
+std::vector<Nucleo> asignarBandas(const std::vector<Nucleo> &nucleos, int nHilos);
+
+/* Fija los hilos de paraleloBandas según asignarBandas y retorna la asignación en texto, una
+ * línea por banda. Con nHilos negativo se desactiva.
+ *
+ * @Param nHilos: Cantidad de bandas, 0 usa todos los núcleos.
+ */
+std::string activarAfinidad(int nHilos);
+
+#endif // GAMEOFLIFECPU_AFINIDAD_H
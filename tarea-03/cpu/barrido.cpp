@@ -0,0 +1,95 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Barrido de Monte Carlo de la densidad inicial: corre tamaño x densidad x semilla en todos los
+ * núcleos con robo de trabajo y escribe la serie de población de cada corrida en un CSV.
+ *
+ * Uso: BARRIDO [--n 64,128] [--probs 0:100:5|10,20,30] [--semillas s] [--seed s]
+ *              [--gens generaciones] [--cada generaciones] [--motor nombre|fijo] [--hilos h]
+ *              [--frontera fija|toroidal] [--csv archivo|-]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ensamble.h"
+
+// Opciones del barrido
+struct OpcionesBarrido {
+    std::vector<int> tamanos = {64};
+    std::vector<int> densidades;
+    int semillas = 10;
+    unsigned long long seed = 1998;
+    OpcionesEnsamble ensamble;
+    std::string csv = "-";
+};
+
+/**
+ * Lee una lista de enteros separados por comas, o un rango inicio:fin:paso (fin incluido).
+ */
+std::vector<int> leerLista(const std::string &texto) {
+    std::vector<int> valores;
+    int inicio, fin, paso;
+    if (sscanf(texto.c_str(), "%d:%d:%d", &inicio, &fin, &paso) == 3 && paso > 0) {
+        for (int v = inicio; v <= fin; v += paso) valores.push_back(v);
+        return valores;
+    }
+    size_t a = 0;
+    while (a < texto.size()) {
+        size_t b = texto.find(',', a);
+        if (b == std::string::npos) b = texto.size();
+        if (b > a) valores.push_back(atoi(texto.substr(a, b - a).c_str()));
+        a = b + 1;
+    }
+    return valores;
+}
+
+/**
+ * Lee las opciones de la línea de comandos.
+ */
+OpcionesBarrido leerOpciones(int argc, char *argv[]) {
+    OpcionesBarrido op;
+    op.densidades = leerLista("0:100:5");
+    for (int i = 1; i < argc; i++) {
+        bool valor = i + 1 < argc;
+        if (strcmp(argv[i], "--n") == 0 && valor) op.tamanos = leerLista(argv[++i]);
+        else if (strcmp(argv[i], "--probs") == 0 && valor) op.densidades = leerLista(argv[++i]);
+        else if (strcmp(argv[i], "--semillas") == 0 && valor) op.semillas = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && valor) op.seed = strtoull(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--gens") == 0 && valor) op.ensamble.gens = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--cada") == 0 && valor) op.ensamble.cada = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--motor") == 0 && valor) op.ensamble.motor = argv[++i];
+        else if (strcmp(argv[i], "--hilos") == 0 && valor) op.ensamble.nHilos = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--frontera") == 0 && valor) {
+            op.ensamble.frontera = strcmp(argv[++i], "fija") == 0 ? FRONTERA_FIJA : FRONTERA_TOROIDAL;
+        } else if (strcmp(argv[i], "--csv") == 0 && valor) op.csv = argv[++i];
+        else {
+            std::cout << "Opción desconocida: " << argv[i] << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+    return op;
+}
+
+/**
+ * Corre el barrido.
+ */
+int main(int argc, char *argv[]) {
+    OpcionesBarrido op = leerOpciones(argc, argv);
+    std::vector<CorridaEnsamble> corridas = armarEnsamble(op.tamanos, op.densidades, op.seed, op.semillas);
+    try {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        long long robadas = correrEnsamble(corridas, op.ensamble);
+        double tiempo = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        guardarCSVEnsamble(op.csv, corridas, op.ensamble.cada, op.ensamble.gens);
+        fprintf(stderr, "%zu corridas en %.3f s, %lld robadas\n", corridas.size(), tiempo, robadas);
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
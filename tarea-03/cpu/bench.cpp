@@ -0,0 +1,235 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Benchmark de todos los motores. Con --baseline compara las celdas por segundo contra una
+ * referencia guardada y falla si algún motor cae bajo ella por más de la tolerancia.
+ *
+ * Uso: BENCH [--motor nombre|todos] [--n filas] [--m columnas] [--prob p] [--seed s]
+ *            [--tiempo segundos] [--gens generaciones] [--hilos h] [--frontera fija|toroidal]
+ *            [--baseline archivo [--actualizar] [--tolerancia 0.5]] [--halos 1,2,4,8]
+ *            [--afinidad] [--tamanos 256,1024,4096]
+ *
+ * Con --afinidad cada banda se fija a un núcleo (bandas vecinas comparten L3) y se imprime la
+ * asignación, así los resultados son reproducibles en máquinas con varios sockets.
+ * Con --halos se compara el motor halo para cada k: trabajo redundante contra barreras.
+ * Con --tamanos se corren los motores de --motor (separados por comas) en tableros cuadrados de
+ * cada tamaño, por ejemplo --motor simd,tiled para comparar la matriz por filas con las teselas,
+ * o --motor simd,fijo-64 --tamanos 64 para comparar el motor de tamaño fijo con el dinámico.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "afinidad.h"
+#include "engine.h"
+#include "engines.h"
+
+// Opciones del benchmark
+struct OpcionesBench {
+    std::string motor = "todos";
+    int N = 512;
+    int M = 512;
+    int probTrue = 30;
+    unsigned long long seed = 1998;
+    double tiempo = 0.5;
+    int gens = 0;
+    int hilos = 0;
+    Frontera frontera = FRONTERA_TOROIDAL;
+    std::string baseline;
+    bool actualizar = false;
+    double tolerancia = 0.5;
+    std::string halos;
+    bool afinidad = false;
+    std::string tamanos;
+};
+
+/**
+ * Lee las opciones de la línea de comandos.
+ */
+OpcionesBench leerOpciones(int argc, char *argv[]) {
+    OpcionesBench op;
+    for (int i = 1; i < argc; i++) {
+        bool valor = i + 1 < argc;
+        if (strcmp(argv[i], "--motor") == 0 && valor) op.motor = argv[++i];
+        else if (strcmp(argv[i], "--n") == 0 && valor) op.N = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--m") == 0 && valor) op.M = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--prob") == 0 && valor) op.probTrue = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && valor) op.seed = strtoull(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--tiempo") == 0 && valor) op.tiempo = atof(argv[++i]);
+        else if (strcmp(argv[i], "--gens") == 0 && valor) op.gens = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--hilos") == 0 && valor) op.hilos = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--frontera") == 0 && valor) {
+            op.frontera = strcmp(argv[++i], "fija") == 0 ? FRONTERA_FIJA : FRONTERA_TOROIDAL;
+        } else if (strcmp(argv[i], "--baseline") == 0 && valor) op.baseline = argv[++i];
+        else if (strcmp(argv[i], "--actualizar") == 0) op.actualizar = true;
+        else if (strcmp(argv[i], "--tolerancia") == 0 && valor) op.tolerancia = atof(argv[++i]);
+        else if (strcmp(argv[i], "--halos") == 0 && valor) op.halos = argv[++i];
+        else if (strcmp(argv[i], "--afinidad") == 0) op.afinidad = true;
+        else if (strcmp(argv[i], "--tamanos") == 0 && valor) op.tamanos = argv[++i];
+        else {
+            std::cout << "Opción desconocida: " << argv[i] << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (op.M == 512 && op.N != 512) op.M = op.N;
+    return op;
+}
+
+/**
+ * Avanza el motor por un número fijo de generaciones o hasta cumplir el tiempo.
+ */
+void correrMotor(GOLEngine &motor, const OpcionesBench &op) {
+    motor.avanzar(1); // Calentamiento, no se descuenta de las estadísticas
+    if (op.gens > 0) {
+        motor.avanzar(op.gens - 1);
+        return;
+    }
+    int paso = 1;
+    while (motor.estadisticas().tiempo < op.tiempo) {
+        motor.avanzar(paso);
+        if (paso < 64) paso *= 2;
+    }
+}
+
+/**
+ * Separa una lista por comas.
+ */
+std::vector<std::string> separarLista(const std::string &lista) {
+    std::vector<std::string> valores;
+    size_t inicio = 0;
+    while (inicio < lista.size()) {
+        size_t fin = lista.find(',', inicio);
+        if (fin == std::string::npos) fin = lista.size();
+        if (fin > inicio) valores.push_back(lista.substr(inicio, fin - inicio));
+        inicio = fin + 1;
+    }
+    return valores;
+}
+
+/**
+ * Compara el motor halo para cada k de la lista separada por comas.
+ */
+void compararHalos(const OpcionesBench &op) {
+    printf("Tablero %dx%d, densidad %d%%, semilla %llu\n", op.N, op.M, op.probTrue, op.seed);
+    printf("%-8s %8s %10s %16s %12s %14s\n", "k", "gens", "tiempo[s]", "celdas/s", "redundante", "barreras/gen");
+    for (const std::string &valor : separarLista(op.halos)) {
+        int k = atoi(valor.c_str());
+        if (k < 1) continue;
+
+        GOLHalo motor(k, op.hilos);
+        motor.inicializar(op.N, op.M, op.probTrue, op.seed, op.frontera);
+        correrMotor(motor, op);
+        GOLStats s = motor.estadisticas();
+        printf("%-8d %8lld %10.3f %16.0f %11.2f%% %14.3f\n", k, s.generacion, s.tiempo, s.celdasPorSegundo,
+               100 * motor.trabajoRedundante(), motor.barrerasPorGeneracion());
+    }
+}
+
+/**
+ * Corre los motores en tableros cuadrados de cada tamaño de la lista, la última columna es la
+ * velocidad relativa al primer motor en el mismo tamaño.
+ */
+void compararTamanos(const OpcionesBench &op) {
+    std::vector<std::string> motores = op.motor == "todos" ? motoresDisponibles() : separarLista(op.motor);
+    printf("Densidad %d%%, semilla %llu\n", op.probTrue, op.seed);
+    printf("%-8s %-14s %8s %10s %16s %10s\n", "n", "motor", "gens", "tiempo[s]", "celdas/s", "relativo");
+    for (const std::string &valor : separarLista(op.tamanos)) {
+        int n = atoi(valor.c_str());
+        if (n < 1) continue;
+        double primero = 0;
+        for (const std::string &nombre : motores) {
+            std::unique_ptr<GOLEngine> motor(crearMotor(nombre, op.hilos));
+            try {
+                motor->inicializar(n, n, op.probTrue, op.seed, op.frontera);
+            } catch (const std::exception &e) {
+                printf("%-8d %-14s no disponible: %s\n", n, nombre.c_str(), e.what());
+                continue;
+            }
+            correrMotor(*motor, op);
+            GOLStats s = motor->estadisticas();
+            if (primero == 0) primero = s.celdasPorSegundo;
+            printf("%-8d %-14s %8lld %10.3f %16.0f %9.2fx\n", n, nombre.c_str(), s.generacion, s.tiempo,
+                   s.celdasPorSegundo, s.celdasPorSegundo / primero);
+        }
+    }
+}
+
+/**
+ * Corre el benchmark.
+ */
+int main(int argc, char *argv[]) {
+    OpcionesBench op = leerOpciones(argc, argv);
+    if (op.afinidad) printf("%s", activarAfinidad(op.hilos).c_str());
+    if (!op.halos.empty()) {
+        compararHalos(op);
+        return 0;
+    }
+    if (!op.tamanos.empty()) {
+        compararTamanos(op);
+        return 0;
+    }
+
+    // Carga la referencia, una línea por motor: nombre celdas/s
+    std::map<std::string, double> referencia;
+    if (!op.baseline.empty()) {
+        std::ifstream infile(op.baseline);
+        std::string nombre;
+        double valor;
+        while (infile >> nombre >> valor) {
+            referencia[nombre] = valor;
+        }
+        infile.close();
+    }
+
+    std::vector<std::string> motores;
+    if (op.motor == "todos") motores = motoresDisponibles();
+    else motores.push_back(op.motor);
+
+    printf("Tablero %dx%d, densidad %d%%, semilla %llu\n", op.N, op.M, op.probTrue, op.seed);
+    printf("%-14s %8s %10s %16s %12s %12s\n", "motor", "gens", "tiempo[s]", "celdas/s", "poblacion", "memoria[B]");
+    bool ok = true;
+    std::map<std::string, double> medido;
+    for (const std::string &nombre : motores) {
+        std::unique_ptr<GOLEngine> motor;
+        try {
+            motor.reset(crearMotor(nombre, op.hilos));
+            motor->inicializar(op.N, op.M, op.probTrue, op.seed, op.frontera);
+        } catch (const std::exception &e) {
+            printf("%-14s no disponible: %s\n", nombre.c_str(), e.what());
+            continue;
+        }
+        correrMotor(*motor, op);
+        GOLStats s = motor->estadisticas();
+        medido[nombre] = s.celdasPorSegundo;
+        printf("%-14s %8lld %10.3f %16.0f %12lld %12zu", nombre.c_str(), s.generacion, s.tiempo,
+               s.celdasPorSegundo, s.poblacion, s.memoria);
+        if (referencia.count(nombre)) {
+            double razon = s.celdasPorSegundo / referencia[nombre];
+            printf("  (%.2fx referencia)", razon);
+            if (razon < 1 - op.tolerancia) {
+                printf("  REGRESION");
+                ok = false;
+            }
+        } else if (!op.baseline.empty()) {
+            printf("  (sin referencia)");
+        }
+        printf("\n");
+    }
+
+    // Guarda los nuevos valores
+    if (op.actualizar && !op.baseline.empty()) {
+        for (auto &m : medido) referencia[m.first] = m.second;
+        std::ofstream outfile(op.baseline);
+        for (auto &r : referencia) outfile << r.first << " " << (long long) r.second << std::endl;
+        outfile.close();
+        printf("Referencia actualizada en %s\n", op.baseline.c_str());
+        return 0;
+    }
+    return ok ? 0 : EXIT_FAILURE;
+}
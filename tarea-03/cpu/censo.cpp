@@ -0,0 +1,96 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Avanza un tablero aleatorio hasta que se asiente y cuenta sus objetos por forma (bloques,
+ * colmenas, parpadeadores, planeadores, ...).
+ *
+ * Uso: CENSO [--motor nombre] [--n filas] [--m columnas] [--prob p] [--seed s]
+ *            [--gens generaciones] [--hilos h] [--frontera fija|toroidal] [--lista]
+ *
+ * Con --lista se imprime además cada componente con su caja, celdas y hash.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "componentes.h"
+#include "engine.h"
+
+// Opciones del censo
+struct OpcionesCenso {
+    std::string motor = "bits";
+    int N = 1000;
+    int M = 1000;
+    int probTrue = 30;
+    unsigned long long seed = 1998;
+    int gens = 2000;
+    int hilos = 0;
+    Frontera frontera = FRONTERA_FIJA;
+    bool lista = false;
+};
+
+/**
+ * Lee las opciones de la línea de comandos.
+ */
+OpcionesCenso leerOpciones(int argc, char *argv[]) {
+    OpcionesCenso op;
+    for (int i = 1; i < argc; i++) {
+        bool valor = i + 1 < argc;
+        if (strcmp(argv[i], "--motor") == 0 && valor) op.motor = argv[++i];
+        else if (strcmp(argv[i], "--n") == 0 && valor) op.N = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--m") == 0 && valor) op.M = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--prob") == 0 && valor) op.probTrue = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && valor) op.seed = strtoull(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--gens") == 0 && valor) op.gens = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--hilos") == 0 && valor) op.hilos = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--frontera") == 0 && valor) {
+            op.frontera = strcmp(argv[++i], "fija") == 0 ? FRONTERA_FIJA : FRONTERA_TOROIDAL;
+        } else if (strcmp(argv[i], "--lista") == 0) op.lista = true;
+        else {
+            printf("Opción desconocida: %s\n", argv[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (op.M == 1000 && op.N != 1000) op.M = op.N;
+    return op;
+}
+
+/**
+ * Corre el censo.
+ */
+int main(int argc, char *argv[]) {
+    OpcionesCenso op = leerOpciones(argc, argv);
+    GOLEngine *motor;
+    try {
+        motor = crearMotor(op.motor, op.hilos);
+        motor->inicializar(op.N, op.M, op.probTrue, op.seed, op.frontera);
+    } catch (const std::exception &e) {
+        printf("%s\n", e.what());
+        return EXIT_FAILURE;
+    }
+    motor->avanzar(op.gens);
+    printf("Tablero %dx%d, densidad %d%%, semilla %llu, %d generaciones en %.3f s\n", op.N, op.M, op.probTrue,
+           op.seed, op.gens, motor->estadisticas().tiempo);
+
+    std::unique_ptr<bool[]> tablero(new bool[(size_t) op.N * op.M]);
+    motor->leerVentana(0, 0, op.N, op.M, tablero.get());
+    delete motor;
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    std::vector<Componente> componentes = etiquetarComponentes(tablero.get(), op.N, op.M, (size_t) op.M, op.hilos);
+    std::map<std::string, long long> conteo = censo(componentes);
+    double tiempo = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    printf("%zu componentes en %.3f s\n", componentes.size(), tiempo);
+    for (auto &c : conteo) printf("%10lld  %s\n", c.second, c.first.c_str());
+    if (op.lista) {
+        for (const Componente &c : componentes) {
+            printf("(%d, %d) %dx%d %lld celdas %016llx %s\n", c.i0, c.j0, c.alto, c.ancho, c.celdas,
+                   (unsigned long long) c.hash, nombreObjeto(c.hash).c_str());
+        }
+    }
+    return 0;
+}
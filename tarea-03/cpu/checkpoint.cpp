@@ -0,0 +1,327 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Checkpoints comprimidos con escritura atómica.
+ *
+ * Formato (enteros de largo variable LEB128 salvo la firma y el hash):
+ *   "GOLCKPT1", versión, N, M, frontera, generación, largo y texto de la regla,
+ *   filas con celdas vivas, y por cada una: salto desde la fila anterior, cantidad de corridas
+ *   y por corrida el espacio desde el fin de la anterior y su largo.
+ *   Al final el hash FNV-1a de 64 bits de todos los bytes anteriores.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <climits>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include "checkpoint.h"
+#include "engines.h"
+
+#ifdef _WIN32
+#include <io.h>
+#include <process.h>
+#define getpid _getpid
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Firma y versión del formato
+static const char FIRMA[8] = {'G', 'O', 'L', 'C', 'K', 'P', 'T', '1'};
+#define VERSION_CHECKPOINT 1
+
+/**
+ * Hash FNV-1a de 64 bits, continúa desde h.
+ */
+static uint64_t fnv(uint64_t h, const uint8_t *datos, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        h ^= datos[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/**
+ * Agrega un entero sin signo de largo variable.
+ */
+static void agregarVarint(std::vector<uint8_t> &salida, uint64_t v) {
+    while (v >= 0x80) {
+        salida.push_back((uint8_t) (v | 0x80));
+        v >>= 7;
+    }
+    salida.push_back((uint8_t) v);
+}
+
+/**
+ * Lee enteros de largo variable de un buffer, lanza std::runtime_error si se termina o si un
+ * valor queda fuera de su rango. Los rangos se revisan antes de convertir a int, así un archivo
+ * con el hash correcto tampoco escribe fuera del tablero.
+ */
+class LectorVarint {
+private:
+
+    const uint8_t *p;
+    const uint8_t *fin;
+
+public:
+
+    LectorVarint(const uint8_t *p, const uint8_t *fin) : p(p), fin(fin) {
+    }
+
+    uint64_t leer() {
+        uint64_t v = 0;
+        for (int desplazamiento = 0; desplazamiento < 64; desplazamiento += 7) {
+            if (p >= fin) throw std::runtime_error("Checkpoint truncado");
+            uint8_t b = *p++;
+            v |= (uint64_t) (b & 0x7F) << desplazamiento;
+            if (!(b & 0x80)) return v;
+        }
+        throw std::runtime_error("Checkpoint dañado");
+    }
+
+    uint64_t leer(uint64_t minimo, uint64_t maximo) {
+        uint64_t v = leer();
+        if (v < minimo || v > maximo) throw std::runtime_error("Checkpoint dañado");
+        return v;
+    }
+
+    const uint8_t *posicion() const {
+        return p;
+    }
+
+    void saltar(size_t n) {
+        if ((size_t) (fin - p) < n) throw std::runtime_error("Checkpoint truncado");
+        p += n;
+    }
+
+};
+
+/**
+ * Escribe un archivo completo de forma atómica: archivo temporal, fsync, rename y fsync del
+ * directorio. El temporal lleva el pid y un contador, así dos escritores del mismo checkpoint
+ * no truncan el temporal del otro.
+ */
+static void escribirAtomico(const std::string &archivo, const std::vector<uint8_t> &datos) {
+    static std::atomic<int> temporales(0);
+    std::string temporal = archivo + "." + std::to_string((long long) getpid()) + "-" +
+                           std::to_string(temporales++) + ".tmp";
+#ifdef _WIN32
+    FILE *f = fopen(temporal.c_str(), "wb");
+    bool ok = f && fwrite(datos.data(), 1, datos.size(), f) == datos.size() && fflush(f) == 0 &&
+              _commit(_fileno(f)) == 0;
+    if (f && fclose(f) != 0) ok = false;
+    if (ok) {
+        remove(archivo.c_str());
+        ok = rename(temporal.c_str(), archivo.c_str()) == 0;
+    }
+#else
+    int fd = open(temporal.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    bool ok = fd >= 0;
+    size_t escrito = 0;
+    while (ok && escrito < datos.size()) {
+        ssize_t n = write(fd, datos.data() + escrito, datos.size() - escrito);
+        if (n <= 0) ok = false;
+        else escrito += (size_t) n;
+    }
+    if (ok && fsync(fd) != 0) ok = false;
+    if (fd >= 0 && close(fd) != 0) ok = false;
+    if (ok) ok = rename(temporal.c_str(), archivo.c_str()) == 0;
+
+    // El rename queda en disco recién al sincronizar el directorio
+    if (ok) {
+        size_t barra = archivo.find_last_of('/');
+        std::string directorio = barra == std::string::npos ? "." : (barra == 0 ? "/" : archivo.substr(0, barra));
+        int dir = open(directorio.c_str(), O_RDONLY);
+        if (dir >= 0) {
+            fsync(dir);
+            close(dir);
+        }
+    }
+#endif
+    if (!ok) {
+        remove(temporal.c_str());
+        throw std::runtime_error("No se pudo escribir el checkpoint " + archivo);
+    }
+}
+
+/**
+ * Guarda el tablero del motor, leyendo una fila a la vez.
+ *
+ * @param motor Motor
+ * @param archivo Ruta del checkpoint
+ * @param regla Regla
+ * @return Datos del checkpoint
+ */
+InfoCheckpoint guardarCheckpoint(GOLEngine &motor, const std::string &archivo, const std::string &regla) {
+    InfoCheckpoint info;
+    info.N = motor.getFilas();
+    info.M = motor.getColumnas();
+    info.frontera = motor.getFrontera();
+    info.generacion = motor.getGeneracion();
+    info.regla = regla;
+    info.vivas = 0;
+
+    // Las corridas de cada fila van en un buffer aparte hasta saber cuántas son
+    std::vector<uint8_t> corridas, filas;
+    std::unique_ptr<bool[]> fila(new bool[info.M]);
+    long long filasVivas = 0;
+    int filaAnterior = 0;
+    for (int i = 0; i < info.N; i++) {
+        motor.leerVentana(i, 0, 1, info.M, fila.get());
+        corridas.clear();
+        int cantidad = 0, finAnterior = 0;
+        for (int j = 0; j < info.M;) {
+            if (!fila[j]) {
+                j++;
+                continue;
+            }
+            int k = j;
+            while (k < info.M && fila[k]) k++;
+            agregarVarint(corridas, (uint64_t) (j - finAnterior));
+            agregarVarint(corridas, (uint64_t) (k - j));
+            info.vivas += k - j;
+            cantidad++;
+            finAnterior = k;
+            j = k;
+        }
+        if (cantidad == 0) continue;
+        agregarVarint(filas, (uint64_t) (i - filaAnterior));
+        agregarVarint(filas, (uint64_t) cantidad);
+        filas.insert(filas.end(), corridas.begin(), corridas.end());
+        filaAnterior = i;
+        filasVivas++;
+    }
+
+    std::vector<uint8_t> datos(FIRMA, FIRMA + 8);
+    agregarVarint(datos, VERSION_CHECKPOINT);
+    agregarVarint(datos, (uint64_t) info.N);
+    agregarVarint(datos, (uint64_t) info.M);
+    agregarVarint(datos, (uint64_t) info.frontera);
+    agregarVarint(datos, (uint64_t) info.generacion);
+    agregarVarint(datos, regla.size());
+    datos.insert(datos.end(), regla.begin(), regla.end());
+    agregarVarint(datos, (uint64_t) filasVivas);
+    datos.insert(datos.end(), filas.begin(), filas.end());
+
+    uint64_t h = fnv(14695981039346656037ULL, datos.data(), datos.size());
+    for (int b = 0; b < 8; b++) datos.push_back((uint8_t) (h >> (8 * b)));
+
+    escribirAtomico(archivo, datos);
+    info.bytes = datos.size();
+    return info;
+}
+
+/**
+ * Carga un checkpoint en el motor.
+ *
+ * @param motor Motor
+ * @param archivo Ruta del checkpoint
+ * @return Datos del checkpoint
+ */
+InfoCheckpoint cargarCheckpoint(GOLEngine &motor, const std::string &archivo) {
+    FILE *f = fopen(archivo.c_str(), "rb");
+    if (!f) {
+        throw std::runtime_error("No se pudo abrir el checkpoint " + archivo);
+    }
+    std::vector<uint8_t> datos;
+    uint8_t bloque[65536];
+    size_t n;
+    while ((n = fread(bloque, 1, sizeof(bloque), f)) > 0) datos.insert(datos.end(), bloque, bloque + n);
+    fclose(f);
+
+    if (datos.size() < 16 || memcmp(datos.data(), FIRMA, 8) != 0) {
+        throw std::runtime_error(archivo + " no es un checkpoint");
+    }
+    uint64_t h = 0;
+    for (int b = 0; b < 8; b++) h |= (uint64_t) datos[datos.size() - 8 + b] << (8 * b);
+    if (h != fnv(14695981039346656037ULL, datos.data(), datos.size() - 8)) {
+        throw std::runtime_error("Checkpoint dañado: " + archivo);
+    }
+
+    LectorVarint lector(datos.data() + 8, datos.data() + datos.size() - 8);
+    if (lector.leer() != VERSION_CHECKPOINT) {
+        throw std::runtime_error("Versión de checkpoint no soportada: " + archivo);
+    }
+    InfoCheckpoint info;
+    info.N = (int) lector.leer(1, INT_MAX);
+    info.M = (int) lector.leer(1, INT_MAX);
+    info.frontera = (Frontera) lector.leer(FRONTERA_FIJA, FRONTERA_TOROIDAL);
+    info.generacion = (long long) lector.leer(0, LLONG_MAX);
+    size_t largoRegla = (size_t) lector.leer();
+    const uint8_t *regla = lector.posicion();
+    lector.saltar(largoRegla);
+    info.regla.assign((const char *) regla, largoRegla);
+    info.vivas = 0;
+    info.bytes = datos.size();
+
+    std::vector<Corrida> corridas;
+    // Cada fila queda en [0, N) y cada corrida de al menos una celda en [0, M)
+    uint64_t filasVivas = lector.leer(0, (uint64_t) info.N);
+    int i = 0;
+    for (uint64_t k = 0; k < filasVivas; k++) {
+        i += (int) lector.leer(k == 0 ? 0 : 1, (uint64_t) (info.N - 1 - i));
+        uint64_t cantidad = lector.leer(1, (uint64_t) info.M);
+        int j = 0;
+        for (uint64_t c = 0; c < cantidad; c++) {
+            if (j >= info.M) throw std::runtime_error("Checkpoint dañado: " + archivo);
+            Corrida corrida;
+            corrida.i = i;
+            corrida.j = j + (int) lector.leer(0, (uint64_t) (info.M - 1 - j));
+            corrida.n = (int) lector.leer(1, (uint64_t) (info.M - corrida.j));
+            corridas.push_back(corrida);
+            info.vivas += corrida.n;
+            j = corrida.j + corrida.n;
+        }
+    }
+
+    // Sin la regla guardada la corrida no continúa igual
+    GOLScalar *escalar = dynamic_cast<GOLScalar *>(&motor);
+    std::string mayusculas = info.regla;
+    std::transform(mayusculas.begin(), mayusculas.end(), mayusculas.begin(), ::toupper);
+    if (escalar) {
+        try {
+            escalar->setRegla(info.regla);
+        } catch (const std::invalid_argument &) {
+            throw std::runtime_error("Checkpoint con regla inválida: " + archivo);
+        }
+    } else if (mayusculas != "B3/S23") {
+        throw std::runtime_error("El motor " + motor.nombre() + " no puede usar la regla " + info.regla + " de " +
+                                 archivo);
+    }
+
+    motor.cargarTablero(info.N, info.M, info.frontera, info.generacion, corridas);
+    return info;
+}
+
+/**
+ * Avanza n generaciones con checkpoints periódicos.
+ *
+ * @param motor Motor
+ * @param n Generaciones
+ * @param cada Generaciones entre checkpoints
+ * @param archivo Ruta del checkpoint
+ * @param regla Regla del motor
+ * @return Checkpoints escritos
+ */
+int avanzarConCheckpoints(GOLEngine &motor, int n, int cada, const std::string &archivo, const std::string &regla) {
+    if (cada < 1) {
+        motor.avanzar(n);
+        return 0;
+    }
+    int escritos = 0;
+    long long fin = motor.getGeneracion() + n;
+    while (motor.getGeneracion() < fin) {
+        long long siguiente = (motor.getGeneracion() / cada + 1) * cada;
+        long long hasta = std::min(siguiente, fin);
+        motor.avanzar((int) (hasta - motor.getGeneracion()));
+        if (motor.getGeneracion() % cada == 0) {
+            guardarCheckpoint(motor, archivo, regla);
+            escritos++;
+        }
+    }
+    return escritos;
+}
@@ -0,0 +1,59 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Checkpoints comprimidos para reanudar simulaciones largas. Guardan la generación, la regla,
+ * la condición de borde y las corridas de celdas vivas, codificadas con enteros de largo
+ * variable. La escritura usa un archivo temporal, fsync y rename, así un corte nunca deja un
+ * checkpoint a medias.
+ */
+
+#ifndef GAMEOFLIFECPU_CHECKPOINT_H
+#define GAMEOFLIFECPU_CHECKPOINT_H
+
+#include <string>
+#include <vector>
+#include "engine.h"
+
+// Datos de un checkpoint
+struct InfoCheckpoint {
+    int N;                  // Número de filas
+    int M;                  // Número de columnas
+    Frontera frontera;      // Condición de borde
+    long long generacion;   // Generación guardada
+    std::string regla;      // Regla, por ejemplo "B3/S23"
+    long long vivas;        // Celdas vivas
+    size_t bytes;           // Tamaño del archivo
+};
+
+/* Guarda el tablero del motor. Lanza std::runtime_error si no se puede escribir.
+ *
+ * @Param motor: Motor.
+ * @Param archivo: Ruta del checkpoint.
+ * @Param regla: Regla que se guarda.
+ * @Return: Datos del checkpoint escrito.
+ */
+InfoCheckpoint guardarCheckpoint(GOLEngine &motor, const std::string &archivo, const std::string &regla = "B3/S23");
+
+/* Carga un checkpoint en el motor, que continúa desde la generación guardada con la regla
+ * guardada (los motores escalares la aplican, los demás sólo aceptan B3/S23). Lanza
+ * std::runtime_error si el archivo no existe, está dañado, no es un checkpoint o el motor no
+ * puede usar su regla.
+ *
+ * @Param motor: Motor, puede ser distinto al que guardó el checkpoint.
+ * @Param archivo: Ruta del checkpoint.
+ */
+InfoCheckpoint cargarCheckpoint(GOLEngine &motor, const std::string &archivo);
+
+/* Avanza n generaciones guardando un checkpoint cada "cada" generaciones (contadas desde la
+ * generación 0, así al reanudar se mantiene el mismo calendario).
+ *
+ * @Param motor: Motor.
+ * @Param n: Generaciones.
+ * @Param cada: Generaciones entre checkpoints.
+ * @Param archivo: Ruta del checkpoint.
+ * @Param regla: Regla que usa el motor, se guarda en cada checkpoint.
+ * @Return: Checkpoints escritos.
+ */
+int avanzarConCheckpoints(GOLEngine &motor, int n, int cada, const std::string &archivo,
+                          const std::string &regla = "B3/S23");
+
+#endif // GAMEOFLIFECPU_CHECKPOINT_H
@@ -0,0 +1,314 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Etiquetado de componentes conexas y censo de objetos.
+ *
+ * El union-find trabaja sobre corridas horizontales de celdas vivas en vez de celdas, así la
+ * memoria depende de las celdas vivas y no del tamaño del tablero. Dos corridas de filas
+ * consecutivas se unen si se tocan en diagonal o se traslapan. Las raíces siempre son la corrida
+ * de menor índice, por lo que un solo recorrido en orden deja cada corrida apuntando a su raíz.
+ */
+
+#include <algorithm>
+#include <unordered_map>
+#include "componentes.h"
+#include "paralelo.h"
+#include "reglas.h"
+#include "rng.h"
+
+// Corrida de celdas vivas [j0, j1) de la fila i
+struct Tramo {
+    int i;
+    int j0;
+    int j1;
+};
+
+// Hash de un mapa de bits con sus dimensiones, para la cache de formas chicas
+struct HashBits {
+    size_t operator()(const std::pair<uint64_t, int> &b) const {
+        return (size_t) ((b.first ^ (uint64_t) b.second << 52) * 0x9E3779B97F4A7C15ULL >> 16);
+    }
+};
+
+/**
+ * Raíz de k, acorta el camino a la mitad.
+ */
+static uint32_t buscar(std::vector<uint32_t> &padre, uint32_t k) {
+    while (padre[k] != k) {
+        padre[k] = padre[padre[k]];
+        k = padre[k];
+    }
+    return k;
+}
+
+/**
+ * Une los conjuntos de a y b, la raíz de mayor índice queda bajo la de menor índice.
+ */
+static void unir(std::vector<uint32_t> &padre, uint32_t a, uint32_t b) {
+    a = buscar(padre, a);
+    b = buscar(padre, b);
+    if (a < b) padre[b] = a;
+    else if (b < a) padre[a] = b;
+}
+
+/**
+ * Primera celda desde j igual a valor (0 o 1), M si no hay. Lee 8 celdas a la vez, el primer
+ * byte distinto de una palabra es su bit en uno menos significativo (little endian).
+ */
+static inline int buscarCelda(const uint8_t *p, int j, int M, uint8_t valor) {
+    uint64_t invertir = valor ? 0 : BYTES_UNO;
+    while (j + 8 <= M) {
+        uint64_t v = cargar8(p + j) ^ invertir;
+        if (v) return j + (primerBit(v) >> 3);
+        j += 8;
+    }
+    while (j < M && p[j] != valor) j++;
+    return j;
+}
+
+/**
+ * Agrega las corridas de celdas vivas de una fila.
+ */
+static void tramosFila(const bool *fila, int M, int i, std::vector<Tramo> &tramos) {
+    const uint8_t *p = (const uint8_t *) fila;
+    int j = buscarCelda(p, 0, M, 1);
+    while (j < M) {
+        int k = buscarCelda(p, j, M, 0);
+        tramos.push_back({i, j, k});
+        j = buscarCelda(p, k, M, 1);
+    }
+}
+
+/**
+ * Une las corridas [a0, a1) de una fila con las corridas [b0, b1) de la fila siguiente.
+ */
+static void unirFilas(const std::vector<Tramo> &tramos, std::vector<uint32_t> &padre, int a0, int a1, int b0,
+                      int b1) {
+    while (a0 < a1 && b0 < b1) {
+        const Tramo &a = tramos[a0], &b = tramos[b0];
+        if (a.j0 <= b.j1 && b.j0 <= a.j1) unir(padre, (uint32_t) a0, (uint32_t) b0);
+        if (a.j1 < b.j1) a0++;
+        else b0++;
+    }
+}
+
+/**
+ * Hash de una forma dada por sus corridas relativas a la caja, el mínimo entre sus 8 rotaciones
+ * y reflexiones. El hash de cada orientación es la suma de las celdas mezcladas, así no depende
+ * del orden y las 8 orientaciones se calculan en una sola pasada.
+ *
+ * @param forma Corridas de la forma, (0, 0) es la esquina de la caja
+ * @param alto Filas de la caja
+ * @param ancho Columnas de la caja
+ */
+static uint64_t hashForma(const std::vector<Tramo> &forma, int alto, int ancho) {
+    unsigned long long sumas[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    unsigned long long h = (unsigned long long) alto, w = (unsigned long long) ancho;
+    for (const Tramo &tr : forma) {
+        unsigned long long y = (unsigned long long) tr.i, yr = h - 1 - y;
+        for (int j = tr.j0; j < tr.j1; j++) {
+            unsigned long long x = (unsigned long long) j, xr = w - 1 - x;
+            sumas[0] += mezclarSplitMix(y * w + x);     // Original
+            sumas[1] += mezclarSplitMix(x * h + yr);    // 90°
+            sumas[2] += mezclarSplitMix(yr * w + xr);   // 180°
+            sumas[3] += mezclarSplitMix(xr * h + y);    // 270°
+            sumas[4] += mezclarSplitMix(y * w + xr);    // Reflejo y sus rotaciones
+            sumas[5] += mezclarSplitMix(xr * h + yr);
+            sumas[6] += mezclarSplitMix(yr * w + x);
+            sumas[7] += mezclarSplitMix(x * h + y);
+        }
+    }
+    unsigned long long mejor = ~0ULL;
+    for (int t = 0; t < 8; t++) {
+        unsigned long long dimensiones = t & 1 ? w << 32 | h : h << 32 | w;
+        mejor = std::min(mejor, mezclarSplitMix(sumas[t] ^ mezclarSplitMix(dimensiones)));
+    }
+    return mejor;
+}
+
+/**
+ * Etiqueta las componentes conexas de un tablero.
+ *
+ * @param celdas Primera celda
+ * @param N Número de filas
+ * @param M Número de columnas
+ * @param stride Celdas entre el inicio de dos filas
+ * @param nHilos Cantidad de hilos
+ * @return Componentes
+ */
+std::vector<Componente> etiquetarComponentes(const bool *celdas, int N, int M, size_t stride, int nHilos) {
+    std::vector<Componente> componentes;
+    if (N <= 0 || M <= 0) return componentes;
+    if (nHilos < 1) nHilos = hilosDisponibles();
+    int bandas = std::min(nHilos, N);
+
+    // Corridas de cada banda, en paralelo
+    std::vector<std::vector<Tramo>> tramosBanda(bandas);
+    std::vector<int> inicioBanda(bandas + 1, N);
+    paraleloBandasIndice(0, N, bandas, [&](int t, int a, int b) {
+        inicioBanda[t] = a;
+        for (int i = a; i < b; i++) tramosFila(celdas + (size_t) i * stride, M, i, tramosBanda[t]);
+    });
+
+    // Junta las corridas, inicioFila[i] es la primera corrida de la fila i
+    std::vector<Tramo> tramos;
+    for (const std::vector<Tramo> &v : tramosBanda) tramos.insert(tramos.end(), v.begin(), v.end());
+    tramosBanda.clear();
+    std::vector<int> inicioFila(N + 1, 0);
+    for (const Tramo &t : tramos) inicioFila[t.i + 1]++;
+    for (int i = 0; i < N; i++) inicioFila[i + 1] += inicioFila[i];
+
+    // Une las filas dentro de cada banda en paralelo, cada banda sólo toca sus corridas, y luego
+    // los bordes entre bandas
+    std::vector<uint32_t> padre(tramos.size());
+    for (size_t k = 0; k < padre.size(); k++) padre[k] = (uint32_t) k;
+    paraleloBandasIndice(0, N, bandas, [&](int t, int a, int b) {
+        (void) t;
+        for (int i = a + 1; i < b; i++) {
+            unirFilas(tramos, padre, inicioFila[i - 1], inicioFila[i], inicioFila[i], inicioFila[i + 1]);
+        }
+    });
+    for (int t = 1; t < bandas; t++) {
+        int i = inicioBanda[t];
+        unirFilas(tramos, padre, inicioFila[i - 1], inicioFila[i], inicioFila[i], inicioFila[i + 1]);
+    }
+
+    // Cada corrida queda con el índice de su componente, en el orden de su primera celda
+    std::vector<uint32_t> id(tramos.size());
+    for (size_t k = 0; k < tramos.size(); k++) {
+        padre[k] = padre[padre[k]];
+        if (padre[k] == k) {
+            id[k] = (uint32_t) componentes.size();
+            Componente c = {tramos[k].i, tramos[k].j0, 0, 0, 0, 0};
+            componentes.push_back(c);
+        } else {
+            id[k] = id[padre[k]];
+        }
+    }
+
+    // Cajas y celdas, las corridas están en orden de filas
+    std::vector<int> filaFin(componentes.size()), columnaFin(componentes.size(), 0);
+    for (size_t k = 0; k < tramos.size(); k++) {
+        Componente &c = componentes[id[k]];
+        const Tramo &t = tramos[k];
+        c.j0 = std::min(c.j0, t.j0);
+        c.celdas += t.j1 - t.j0;
+        filaFin[id[k]] = t.i + 1;
+        columnaFin[id[k]] = std::max(columnaFin[id[k]], t.j1);
+    }
+    for (size_t c = 0; c < componentes.size(); c++) {
+        componentes[c].alto = filaFin[c] - componentes[c].i0;
+        componentes[c].ancho = columnaFin[c] - componentes[c].j0;
+    }
+
+    // Agrupa las corridas por componente y calcula los hashes en paralelo
+    std::vector<int> inicioComponente(componentes.size() + 1, 0), orden(tramos.size());
+    for (size_t k = 0; k < tramos.size(); k++) inicioComponente[id[k] + 1]++;
+    for (size_t c = 0; c < componentes.size(); c++) inicioComponente[c + 1] += inicioComponente[c];
+    std::vector<int> siguiente(inicioComponente.begin(), inicioComponente.end() - 1);
+    for (size_t k = 0; k < tramos.size(); k++) orden[siguiente[id[k]]++] = (int) k;
+
+    paraleloBandasIndice(0, (int) componentes.size(), bandas, [&](int t, int a, int b) {
+        (void) t;
+        std::vector<Tramo> forma;
+
+        // Las formas de hasta 64 celdas de caja se repiten mucho (bloques, colmenas, ...), su
+        // hash se guarda por mapa de bits y dimensiones
+        std::unordered_map<std::pair<uint64_t, int>, uint64_t, HashBits> cache;
+        for (int c = a; c < b; c++) {
+            Componente &comp = componentes[c];
+            forma.clear();
+            for (int k = inicioComponente[c]; k < inicioComponente[c + 1]; k++) {
+                const Tramo &tr = tramos[orden[k]];
+                forma.push_back({tr.i - comp.i0, tr.j0 - comp.j0, tr.j1 - comp.j0});
+            }
+            if (comp.alto * comp.ancho > 64) {
+                comp.hash = hashForma(forma, comp.alto, comp.ancho);
+                continue;
+            }
+            std::pair<uint64_t, int> bits(0, comp.alto * 64 + comp.ancho);
+            for (const Tramo &tr : forma) {
+                int n = tr.j1 - tr.j0;
+                bits.first |= (n == 64 ? ~0ULL : (1ULL << n) - 1) << (tr.i * comp.ancho + tr.j0);
+            }
+            std::unordered_map<std::pair<uint64_t, int>, uint64_t, HashBits>::iterator it = cache.find(bits);
+            if (it != cache.end()) {
+                comp.hash = it->second;
+            } else {
+                comp.hash = hashForma(forma, comp.alto, comp.ancho);
+                cache[bits] = comp.hash;
+            }
+        }
+    });
+    return componentes;
+}
+
+/**
+ * Etiqueta las componentes de un tablero.
+ *
+ * @param game Tablero
+ * @param nHilos Cantidad de hilos
+ * @return Componentes
+ */
+std::vector<Componente> etiquetarComponentes(const GOL &game, int nHilos) {
+    int N = game.getFilas();
+    size_t stride = N > 1 ? (size_t) (game.getFila(1) - game.getFila(0)) : (size_t) game.getColumnas();
+    return etiquetarComponentes(game.getFila(0), N, game.getColumnas(), stride, nHilos);
+}
+
+/**
+ * Hash de una forma escrita con 'O' para las celdas vivas.
+ */
+static uint64_t hashTexto(const std::vector<std::string> &filas) {
+    std::vector<Tramo> forma;
+    for (size_t i = 0; i < filas.size(); i++) {
+        for (size_t j = 0; j < filas[i].size(); j++) {
+            if (filas[i][j] == 'O') forma.push_back({(int) i, (int) j, (int) j + 1});
+        }
+    }
+    return hashForma(forma, (int) filas.size(), (int) filas[0].size());
+}
+
+/**
+ * Nombre del objeto con la forma dada.
+ *
+ * @param hash Hash de la forma
+ */
+std::string nombreObjeto(uint64_t hash) {
+    static const std::map<uint64_t, std::string> objetos = {
+            {hashTexto({"OO", "OO"}),                       "bloque"},
+            {hashTexto({".OO.", "O..O", ".OO."}),           "colmena"},
+            {hashTexto({".OO.", "O..O", ".O.O", "..O."}),   "pan"},
+            {hashTexto({"OO.", "O.O", ".O."}),              "bote"},
+            {hashTexto({".O.", "O.O", ".O."}),              "tina"},
+            {hashTexto({"OO.", "O.O", ".OO"}),              "barco"},
+            {hashTexto({".OO.", "O..O", "O..O", ".OO."}),   "estanque"},
+            {hashTexto({"OOO"}),                            "parpadeador"},
+            {hashTexto({".O.", "..O", "OOO"}),              "planeador"},
+            {hashTexto({"O.O", ".OO", ".O."}),              "planeador"},
+    };
+    std::map<uint64_t, std::string>::const_iterator it = objetos.find(hash);
+    return it == objetos.end() ? "" : it->second;
+}
+
+/**
+ * Cuenta las componentes por objeto.
+ *
+ * @param componentes Componentes del tablero
+ * @return Cantidad por nombre
+ */
+std::map<std::string, long long> censo(const std::vector<Componente> &componentes) {
+    // Primero por hash, los nombres se buscan una vez por forma
+    std::unordered_map<uint64_t, std::pair<long long, long long>> formas;
+    for (const Componente &c : componentes) {
+        std::pair<long long, long long> &f = formas[c.hash];
+        f.first++;
+        f.second = c.celdas;
+    }
+    std::map<std::string, long long> conteo;
+    for (auto &f : formas) {
+        std::string nombre = nombreObjeto(f.first);
+        if (nombre.empty()) nombre = "otro (" + std::to_string(f.second.second) + " celdas)";
+        conteo[nombre] += f.second.first;
+    }
+    return conteo;
+}
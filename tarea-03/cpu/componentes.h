@@ -0,0 +1,57 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Etiquetado de componentes conexas (vecindad de 8) con union-find en paralelo, y censo de los
+ * objetos del tablero (bloques, parpadeadores, planeadores, ...) por su forma canónica.
+ */
+
+#ifndef GAMEOFLIFECPU_COMPONENTES_H
+#define GAMEOFLIFECPU_COMPONENTES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "GOL.h"
+
+// Componente conexa del tablero
+struct Componente {
+    int i0;             // Primera fila de la caja
+    int j0;             // Primera columna de la caja
+    int alto;           // Filas de la caja
+    int ancho;          // Columnas de la caja
+    long long celdas;   // Celdas vivas
+    uint64_t hash;      // Hash de la forma, igual para traslaciones, rotaciones y reflexiones
+};
+
+/* Etiqueta las componentes conexas de un tablero. Cada banda de filas arma sus corridas de
+ * celdas vivas y las une con las de la fila anterior en un hilo; luego se unen las corridas de
+ * los bordes entre bandas. El tablero no se considera periódico.
+ *
+ * @Param celdas: Primera celda.
+ * @Param N: Número de filas.
+ * @Param M: Número de columnas.
+ * @Param stride: Celdas entre el inicio de dos filas.
+ * @Param nHilos: Cantidad de hilos, 0 usa todos los núcleos.
+ * @Return: Componentes ordenadas por su primera celda (fila y luego columna).
+ */
+std::vector<Componente> etiquetarComponentes(const bool *celdas, int N, int M, size_t stride, int nHilos = 0);
+
+// Etiqueta las componentes de las celdas reales de un tablero
+std::vector<Componente> etiquetarComponentes(const GOL &game, int nHilos = 0);
+
+/* Nombre del objeto con la forma dada (bloque, colmena, pan, bote, tina, barco, estanque,
+ * parpadeador o planeador), vacío si no es conocido.
+ *
+ * @Param hash: Hash de la forma (Componente::hash).
+ */
+std::string nombreObjeto(uint64_t hash);
+
+/* Cuenta las componentes por objeto, las desconocidas se agrupan como "otro (n celdas)".
+ *
+ * @Param componentes: Componentes del tablero.
+ * @Return: Cantidad por nombre.
+ */
+std::map<std::string, long long> censo(const std::vector<Componente> &componentes);
+
+#endif // GAMEOFLIFECPU_COMPONENTES_H
@@ -0,0 +1,319 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Diario de cambios entre generaciones.
+ *
+ * Formato: "GOLDIAR1" y luego registros, todos con enteros de largo variable (LEB128):
+ *   base:    'B', generación, N, M
+ *   cambios: 'D', generación, cantidad de corridas, bytes de las corridas, y por corrida el
+ *            salto de fila, el espacio desde el fin de la corrida anterior de la fila y su largo.
+ * Los cambios se aplican invirtiendo las celdas, por lo que el mismo registro sirve para avanzar
+ * y para retroceder.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "diario.h"
+#include "reglas.h"
+
+#ifdef _WIN32
+#include <io.h>
+#define ftruncate _chsize_s
+#define fileno _fileno
+#else
+#include <unistd.h>
+#endif
+
+// Firma del archivo
+static const char FIRMA[8] = {'G', 'O', 'L', 'D', 'I', 'A', 'R', '1'};
+
+/**
+ * Agrega un entero sin signo de largo variable.
+ */
+static void agregarVarint(std::vector<uint8_t> &salida, uint64_t v) {
+    while (v >= 0x80) {
+        salida.push_back((uint8_t) (v | 0x80));
+        v >>= 7;
+    }
+    salida.push_back((uint8_t) v);
+}
+
+/**
+ * Lee un entero de largo variable, lanza std::runtime_error si el archivo se termina.
+ */
+static uint64_t leerVarint(FILE *f) {
+    uint64_t v = 0;
+    for (int desplazamiento = 0; desplazamiento < 64; desplazamiento += 7) {
+        int b = fgetc(f);
+        if (b == EOF) throw std::runtime_error("Diario truncado");
+        v |= (uint64_t) (b & 0x7F) << desplazamiento;
+        if (!(b & 0x80)) return v;
+    }
+    throw std::runtime_error("Diario dañado");
+}
+
+/**
+ * Constructor.
+ *
+ * @param archivo Ruta del diario
+ */
+GOLDiario::GOLDiario(const std::string &archivo) {
+    this->archivo = archivo;
+    this->N = 0;
+    this->M = 0;
+    this->W = 0;
+    f = fopen(archivo.c_str(), "rb+");
+    if (f) {
+        leerIndice();
+        return;
+    }
+    f = fopen(archivo.c_str(), "wb+");
+    if (!f || fwrite(FIRMA, 1, 8, f) != 8 || fflush(f) != 0) {
+        if (f) fclose(f);
+        throw std::runtime_error("No se pudo crear el diario " + archivo);
+    }
+    fin = 8;
+}
+
+/**
+ * Destructor.
+ */
+GOLDiario::~GOLDiario() {
+    fclose(f);
+}
+
+/**
+ * Lee el índice de un diario existente. Un registro incompleto al final (un corte durante la
+ * escritura) se descarta y el archivo se trunca antes de él, así un registro nuevo más corto no
+ * deja bytes viejos que se lean como registros al reabrir.
+ */
+void GOLDiario::leerIndice() {
+    char firma[8];
+    if (fread(firma, 1, 8, f) != 8 || memcmp(firma, FIRMA, 8) != 0) {
+        fclose(f);
+        throw std::runtime_error(archivo + " no es un diario");
+    }
+    long long total = getBytes();
+    fin = 8;
+    while (true) {
+        int tipo = fgetc(f);
+        if (tipo != 'B' && tipo != 'D') break;
+        try {
+            long long generacion = (long long) leerVarint(f);
+            if (tipo == 'B') {
+                N = (int) leerVarint(f);
+                M = (int) leerVarint(f);
+            } else {
+                leerVarint(f);
+                long long largo = (long long) leerVarint(f);
+                if (ftell(f) + largo > total) break;
+                fseek(f, largo, SEEK_CUR);
+            }
+            generaciones.push_back(generacion);
+            posiciones.push_back(fin);
+            bases.push_back(tipo == 'B');
+            fin = ftell(f);
+        } catch (const std::runtime_error &) {
+            break;
+        }
+    }
+    if (fin < total && (fseek(f, fin, SEEK_SET) != 0 || ftruncate(fileno(f), fin) != 0)) {
+        fclose(f);
+        throw std::runtime_error("No se pudo descartar el registro incompleto de " + archivo);
+    }
+}
+
+/**
+ * Escribe el registro armado en cuerpo al final del archivo.
+ *
+ * @param base Registro base
+ * @param generacion Generación del tablero
+ * @param cantidad Corridas en cuerpo
+ */
+void GOLDiario::escribirRegistro(bool base, long long generacion, int cantidad) {
+    registro.clear();
+    registro.push_back(base ? 'B' : 'D');
+    agregarVarint(registro, (uint64_t) generacion);
+    if (base) {
+        agregarVarint(registro, (uint64_t) N);
+        agregarVarint(registro, (uint64_t) M);
+    } else {
+        agregarVarint(registro, (uint64_t) cantidad);
+        agregarVarint(registro, cuerpo.size());
+        registro.insert(registro.end(), cuerpo.begin(), cuerpo.end());
+    }
+    fseek(f, fin, SEEK_SET);
+    if (fwrite(registro.data(), 1, registro.size(), f) != registro.size() || fflush(f) != 0) {
+        throw std::runtime_error("No se pudo escribir el diario " + archivo);
+    }
+    generaciones.push_back(generacion);
+    posiciones.push_back(fin);
+    bases.push_back(base);
+    fin += (long long) registro.size();
+}
+
+/**
+ * Registra el tablero del motor, compara cada fila con la registrada palabra por palabra.
+ *
+ * @param motor Motor
+ */
+void GOLDiario::registrar(GOLEngine &motor) {
+    long long generacion = motor.getGeneracion();
+    bool mismas = motor.getFilas() == N && motor.getColumnas() == M;
+    if (!tablero.empty() && mismas && generacion <= getUltima()) {
+        throw std::invalid_argument("La generación " + std::to_string(generacion) + " ya está en el diario");
+    }
+
+    // Sin tablero previo se parte una cadena nueva, salvo que el motor esté en la última
+    // generación de un diario existente
+    bool base = tablero.empty() || !mismas;
+    bool continuar = tablero.empty() && mismas && generacion == getUltima();
+    if (base) {
+        N = motor.getFilas();
+        M = motor.getColumnas();
+        W = (M + 63) / 64;
+        tablero.assign((size_t) N * W, 0);
+        fila.reset(new bool[M]);
+    }
+
+    cuerpo.clear();
+    int cantidad = 0, filaAnterior = 0;
+    for (int i = 0; i < N; i++) {
+        motor.leerVentana(i, 0, 1, M, fila.get());
+        uint64_t *registrada = tablero.data() + (size_t) i * W;
+        corridas.clear();
+        for (int k = 0; k < W; k++) {
+            uint64_t palabra = 0;
+            int j0 = k * 64, j1 = std::min(M, j0 + 64);
+            for (int j = j0; j < j1; j++) palabra |= (uint64_t) fila[j] << (j - j0);
+            uint64_t cambios = palabra ^ registrada[k];
+            registrada[k] = palabra;
+            if (base) continue;
+
+            // Corridas de bits en uno, una corrida puede seguir en la palabra siguiente
+            while (cambios) {
+                int b = primerBit(cambios);
+                uint64_t resto = ~(cambios >> b);
+                int n = resto ? std::min(primerBit(resto), 64 - b) : 64;
+                cambios &= b + n == 64 ? (1ULL << b) - 1 : ~(((1ULL << n) - 1) << b);
+                if (!corridas.empty() && corridas.back().j + corridas.back().n == j0 + b) {
+                    corridas.back().n += n;
+                } else {
+                    corridas.push_back({i, j0 + b, n});
+                }
+            }
+        }
+
+        int finAnterior = 0;
+        for (const Corrida &c : corridas) {
+            agregarVarint(cuerpo, (uint64_t) (c.i - filaAnterior));
+            agregarVarint(cuerpo, (uint64_t) (c.j - finAnterior));
+            agregarVarint(cuerpo, (uint64_t) c.n);
+            filaAnterior = c.i;
+            finAnterior = c.j + c.n;
+            cantidad++;
+        }
+    }
+
+    if (!base) escribirRegistro(false, generacion, cantidad);
+    else if (!continuar) escribirRegistro(true, generacion, 0);
+}
+
+/**
+ * Lee las corridas de un registro de cambios.
+ *
+ * @param k Índice del registro
+ */
+void GOLDiario::leerRegistro(size_t k) {
+    corridas.clear();
+    fseek(f, posiciones[k], SEEK_SET);
+    fgetc(f);
+    leerVarint(f);
+    uint64_t cantidad = leerVarint(f);
+    leerVarint(f);
+    int i = 0;
+    for (uint64_t c = 0, finFila = 0; c < cantidad; c++) {
+        uint64_t salto = leerVarint(f);
+        if (salto > 0) finFila = 0;
+        i += (int) salto;
+        Corrida corrida;
+        corrida.i = i;
+        corrida.j = (int) (finFila + leerVarint(f));
+        corrida.n = (int) leerVarint(f);
+        if (corrida.i >= N || corrida.j + corrida.n > M) {
+            throw std::runtime_error("Diario dañado: " + archivo);
+        }
+        finFila = (uint64_t) (corrida.j + corrida.n);
+        corridas.push_back(corrida);
+    }
+}
+
+/**
+ * Lleva el motor a otra generación de la misma cadena.
+ *
+ * @param motor Motor
+ * @param generacion Generación a la que se lleva el motor
+ * @return Celdas invertidas
+ */
+long long GOLDiario::irA(GOLEngine &motor, long long generacion) {
+    long long actual = motor.getGeneracion();
+    long long k = (long long) generaciones.size() - 1;
+    while (k >= 0 && generaciones[k] != actual) k--;
+    if (k < 0 || motor.getFilas() != N || motor.getColumnas() != M) {
+        throw std::invalid_argument("La generación " + std::to_string(actual) + " no está en el diario");
+    }
+
+    // Primero verifica que se pueda llegar, sin cruzar un registro base
+    long long destino = k;
+    if (generacion < actual) {
+        while (destino >= 0 && generaciones[destino] > generacion && !bases[destino]) destino--;
+    } else {
+        while (destino + 1 < (long long) generaciones.size() && !bases[destino + 1] &&
+               generaciones[destino + 1] <= generacion)
+            destino++;
+    }
+    if (destino < 0 || generaciones[destino] != generacion) {
+        throw std::invalid_argument("No se puede llegar a la generación " + std::to_string(generacion));
+    }
+
+    long long invertidas = 0;
+    if (destino < k) {
+        for (long long r = k; r > destino; r--) {
+            leerRegistro((size_t) r);
+            for (const Corrida &c : corridas) invertidas += c.n;
+            motor.invertirCeldas(corridas, generaciones[r - 1]);
+        }
+    } else {
+        for (long long r = k + 1; r <= destino; r++) {
+            leerRegistro((size_t) r);
+            for (const Corrida &c : corridas) invertidas += c.n;
+            motor.invertirCeldas(corridas, generaciones[r]);
+        }
+    }
+    return invertidas;
+}
+
+/**
+ * Cantidad de registros.
+ */
+size_t GOLDiario::getRegistros() const {
+    return generaciones.size();
+}
+
+/**
+ * Generación del último registro.
+ */
+long long GOLDiario::getUltima() const {
+    return generaciones.empty() ? -1 : generaciones.back();
+}
+
+/**
+ * Tamaño del archivo en bytes.
+ */
+long long GOLDiario::getBytes() {
+    long long posicion = ftell(f);
+    fseek(f, 0, SEEK_END);
+    long long bytes = ftell(f);
+    fseek(f, posicion, SEEK_SET);
+    return bytes;
+}
@@ -0,0 +1,98 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Diario de cambios entre generaciones. Cada registro guarda sólo las corridas de celdas que
+ * cambiaron, así desde cualquier generación registrada (por ejemplo un checkpoint recién cargado)
+ * se puede ir hacia atrás o hacia adelante con un costo proporcional a los cambios.
+ */
+
+#ifndef GAMEOFLIFECPU_DIARIO_H
+#define GAMEOFLIFECPU_DIARIO_H
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "engine.h"
+
+class GOLDiario {
+private:
+
+    // Archivo del diario, sólo se escribe al final
+    std::string archivo;
+    FILE *f;
+
+    // Fin del último registro válido, el siguiente se escribe ahí
+    long long fin;
+
+    // Dimensiones y palabras por fila del tablero registrado
+    int N;
+    int M;
+    int W;
+
+    // Último tablero registrado, en bits empaquetados, y fila leída desde el motor
+    std::vector<uint64_t> tablero;
+    std::unique_ptr<bool[]> fila;
+
+    // Generación, posición en el archivo y tipo de cada registro. Un registro base inicia una
+    // cadena nueva y no tiene cambios
+    std::vector<long long> generaciones;
+    std::vector<long long> posiciones;
+    std::vector<bool> bases;
+
+    // Buffers de un registro, se reutilizan
+    std::vector<uint8_t> cuerpo;
+    std::vector<uint8_t> registro;
+    std::vector<Corrida> corridas;
+
+    // Lee el índice de un diario existente
+    void leerIndice();
+
+    // Escribe un registro al final del archivo
+    void escribirRegistro(bool base, long long generacion, int cantidad);
+
+    // Lee las corridas del registro k
+    void leerRegistro(size_t k);
+
+public:
+
+    /* Constructor, abre el diario o lo crea si no existe. Lanza std::runtime_error si no se
+     * puede abrir o no es un diario.
+     *
+     * @Param archivo: Ruta del diario.
+     */
+    explicit GOLDiario(const std::string &archivo);
+
+    // Destructor, cierra el archivo
+    virtual ~GOLDiario();
+
+    /* Registra el tablero del motor. La primera vez (o si cambian las dimensiones) escribe un
+     * registro base, después los cambios respecto al último tablero registrado. Lanza
+     * std::invalid_argument si la generación no es posterior a la última registrada.
+     *
+     * @Param motor: Motor.
+     */
+    void registrar(GOLEngine &motor);
+
+    /* Lleva el motor a otra generación de la misma cadena aplicando los cambios registrados,
+     * hacia atrás o hacia adelante. El motor debe estar en una generación registrada, por
+     * ejemplo tras cargarCheckpoint. Lanza std::invalid_argument si no se puede llegar.
+     *
+     * @Param motor: Motor.
+     * @Param generacion: Generación a la que se lleva el motor.
+     * @Return: Celdas invertidas.
+     */
+    long long irA(GOLEngine &motor, long long generacion);
+
+    // Cantidad de registros
+    size_t getRegistros() const;
+
+    // Generación del último registro, -1 si está vacío
+    long long getUltima() const;
+
+    // Tamaño del archivo en bytes
+    long long getBytes();
+
+};
+
+#endif // GAMEOFLIFECPU_DIARIO_H
@@ -0,0 +1,220 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Interfaz común de los motores y fábrica.
+ */
+
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <stdexcept>
+#include "engine.h"
+#include "engines.h"
+#include "fijo.h"
+
+/**
+ * Constructor.
+ */
+GOLEngine::GOLEngine() {
+    N = 0;
+    M = 0;
+    frontera = FRONTERA_TOROIDAL;
+    generacion = 0;
+    tiempo = 0;
+}
+
+/**
+ * Destructor.
+ */
+GOLEngine::~GOLEngine() = default;
+
+/**
+ * Crea el tablero.
+ *
+ * @param N Número de filas
+ * @param M Número de columnas
+ * @param probTrue Probabilidad de que una celda sea verdadera
+ * @param seed Semilla
+ * @param frontera Condición de borde
+ */
+void GOLEngine::inicializar(int N, int M, int probTrue, unsigned long long seed, Frontera frontera) {
+    this->N = N;
+    this->M = M;
+    this->frontera = frontera;
+    this->generacion = 0;
+    this->tiempo = 0;
+    crearTablero(probTrue, seed);
+}
+
+/**
+ * Crea un tablero vacío con las corridas dadas vivas.
+ *
+ * @param N Número de filas
+ * @param M Número de columnas
+ * @param frontera Condición de borde
+ * @param generacion Generación del tablero
+ * @param corridas Corridas de celdas vivas
+ */
+void GOLEngine::cargarTablero(int N, int M, Frontera frontera, long long generacion,
+                              const std::vector<Corrida> &corridas) {
+    inicializar(N, M, 0, 0, frontera);
+    escribirCorridas(corridas, false);
+    this->generacion = generacion;
+}
+
+/**
+ * Invierte el estado de las corridas.
+ *
+ * @param corridas Corridas de celdas que cambian
+ * @param generacion Generación del tablero resultante
+ */
+void GOLEngine::invertirCeldas(const std::vector<Corrida> &corridas, long long generacion) {
+    escribirCorridas(corridas, true);
+    this->generacion = generacion;
+}
+
+/**
+ * Avanza n generaciones midiendo el tiempo.
+ *
+ * @param n Generaciones
+ */
+void GOLEngine::avanzar(int n) {
+    if (n <= 0) return;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    avanzarGeneraciones(n);
+    tiempo += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    generacion += n;
+}
+
+/**
+ * Por defecto el motor no guarda sus filas como bytes.
+ */
+const uint8_t *GOLEngine::filaDirecta(int) {
+    return nullptr;
+}
+
+/**
+ * Retorna las estadísticas del motor.
+ */
+GOLStats GOLEngine::estadisticas() {
+    GOLStats s;
+    s.generacion = generacion;
+    s.poblacion = poblacion();
+    s.tiempo = tiempo;
+    s.celdasPorSegundo = tiempo > 0 ? (double) N * M * generacion / tiempo : 0;
+    s.memoria = memoria();
+    return s;
+}
+
+/**
+ * Retorna las generaciones avanzadas.
+ */
+long long GOLEngine::getGeneracion() const {
+    return generacion;
+}
+
+/**
+ * Retorna el número de filas reales.
+ */
+int GOLEngine::getFilas() const {
+    return N;
+}
+
+/**
+ * Retorna el número de columnas reales.
+ */
+int GOLEngine::getColumnas() const {
+    return M;
+}
+
+/**
+ * Retorna la condición de borde.
+ */
+Frontera GOLEngine::getFrontera() const {
+    return frontera;
+}
+
+/**
+ * Lee el número al final del nombre de un motor, como el k de halo-k o el lado de tiled-lado.
+ *
+ * @param nombre Nombre del motor
+ * @param inicio Posición del número
+ * @return Número, lanza std::invalid_argument si no es un entero >= 1
+ */
+static int leerSufijo(const std::string &nombre, size_t inicio) {
+    const char *texto = nombre.c_str() + inicio;
+    char *fin = nullptr;
+    errno = 0;
+    long v = strtol(texto, &fin, 10);
+    if (*texto < '0' || *texto > '9' || *fin != '\0' || errno != 0 || v < 1 || v > INT_MAX) {
+        throw std::invalid_argument("Motor desconocido: " + nombre);
+    }
+    return (int) v;
+}
+
+/**
+ * Crea un motor por nombre.
+ *
+ * @param nombre Nombre del motor
+ * @param nHilos Hilos de los motores multihilo
+ * @return Motor, se debe borrar con delete
+ */
+GOLEngine *crearMotor(const std::string &nombre, int nHilos) {
+    if (nombre == "scalar") return new GOLScalar();
+    if (nombre == "inplace") return new GOLScalar(true, nHilos);
+    if (nombre == "simd") return new GOLSimd();
+    if (nombre == "threaded") return new GOLThreaded(nHilos);
+    if (nombre == "wavefront") return new GOLWavefront(nHilos);
+    if (nombre == "halo") return new GOLHalo(HALO_K, nHilos);
+    if (nombre.compare(0, 5, "halo-") == 0) return new GOLHalo(leerSufijo(nombre, 5), nHilos);
+    if (nombre == "bits") return new GOLBits();
+    if (nombre == "tiled") return new GOLTiled();
+    if (nombre.compare(0, 6, "tiled-") == 0) return new GOLTiled(leerSufijo(nombre, 6));
+    if (nombre == "fijo-32") return new GOLFijo<32, 32>();
+    if (nombre == "fijo-64") return new GOLFijo<64, 64>();
+    if (nombre == "fijo-128") return new GOLFijo<128, 128>();
+    if (nombre == "fijo-256") return new GOLFijo<256, 256>();
+#ifdef GOL_MMAP
+    if (nombre == "mmap") return new GOLMmap();
+#endif
+#ifdef GOL_OPENCL
+    if (nombre.compare(0, 6, "opencl") == 0) return crearMotorOpenCL(nombre);
+#endif
+    throw std::invalid_argument("Motor desconocido: " + nombre);
+}
+
+/**
+ * Retorna los nombres de los motores compilados.
+ */
+std::vector<std::string> motoresDisponibles() {
+    std::vector<std::string> motores = {"scalar", "inplace", "simd", "threaded", "wavefront", "halo", "bits", "tiled"};
+#ifdef GOL_MMAP
+    motores.push_back("mmap");
+#endif
+#ifdef GOL_OPENCL
+    motores.push_back("opencl");
+    motores.push_back("opencl-if");
+    motores.push_back("opencl-multi");
+#endif
+    return motores;
+}
+
+/**
+ * Hash FNV-1a del tablero completo, se lee una fila a la vez.
+ *
+ * @param motor Motor
+ * @return Hash
+ */
+unsigned long long hashMotor(GOLEngine &motor) {
+    unsigned long long h = 14695981039346656037ULL;
+    bool *celdas = new bool[motor.getColumnas()];
+    for (int i = 0; i < motor.getFilas(); i++) {
+        motor.leerVentana(i, 0, 1, motor.getColumnas(), celdas);
+        for (int j = 0; j < motor.getColumnas(); j++) {
+            h ^= celdas[j] ? 1 : 0;
+            h *= 1099511628211ULL;
+        }
+    }
+    delete[] celdas;
+    return h;
+}
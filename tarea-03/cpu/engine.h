@@ -0,0 +1,154 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Interfaz común de los motores del juego de la vida y fábrica para elegirlos en tiempo de
+ * ejecución (escalar, en sitio, SIMD, multihilo, bits empaquetados, archivo mapeado y
+ * OpenCL).
+ */
+
+#ifndef GAMEOFLIFECPU_ENGINE_H
+#define GAMEOFLIFECPU_ENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GOL.h"
+
+// Corrida de n celdas desde la celda (i, j), sin contar las filas fantasmas
+struct Corrida {
+    int i;
+    int j;
+    int n;
+};
+
+// Estadísticas de un motor
+struct GOLStats {
+    long long generacion;       // Generaciones avanzadas desde inicializar
+    long long poblacion;        // Celdas vivas
+    double tiempo;              // Tiempo acumulado en avanzar [s]
+    double celdasPorSegundo;    // Celdas actualizadas por segundo
+    size_t memoria;             // Bytes usados por el tablero
+};
+
+class GOLEngine {
+protected:
+
+    // Dimensiones sin contar las filas fantasmas
+    int N;
+    int M;
+
+    // Condición de borde
+    Frontera frontera;
+
+    // Generaciones avanzadas y tiempo acumulado
+    long long generacion;
+    double tiempo;
+
+    // Crea el tablero, lo implementa cada motor. Con probTrue 0 debe quedar vacío sin recorrerlo
+    virtual void crearTablero(int probTrue, unsigned long long seed) = 0;
+
+    // Marca vivas (o invierte) las corridas y actualiza las celdas fantasmas
+    virtual void escribirCorridas(const std::vector<Corrida> &corridas, bool invertir) = 0;
+
+    // Avanza n generaciones, lo implementa cada motor
+    virtual void avanzarGeneraciones(int n) = 0;
+
+    // Bytes usados por el tablero
+    virtual size_t memoria() const = 0;
+
+public:
+
+    // Constructor
+    GOLEngine();
+
+    // Destructor
+    virtual ~GOLEngine();
+
+    // Nombre del motor, el mismo que recibe crearMotor
+    virtual std::string nombre() const = 0;
+
+    /* Crea un tablero NxM inicializado con el generador de rng.h.
+     *
+     * @Param N: Número de filas.
+     * @Param M: Número de columnas.
+     * @Param probTrue: Probabilidad de que una celda sea verdadera.
+     * @Param seed: Semilla.
+     * @Param frontera: Condición de borde, con FRONTERA_FIJA el borde está muerto.
+     */
+    void inicializar(int N, int M, int probTrue, unsigned long long seed, Frontera frontera = FRONTERA_TOROIDAL);
+
+    /* Crea un tablero vacío y marca vivas las corridas, por ejemplo al cargar un checkpoint. El
+     * costo depende de las corridas y no del área del tablero.
+     *
+     * @Param N: Número de filas.
+     * @Param M: Número de columnas.
+     * @Param frontera: Condición de borde.
+     * @Param generacion: Generación del tablero.
+     * @Param corridas: Corridas de celdas vivas.
+     */
+    void cargarTablero(int N, int M, Frontera frontera, long long generacion, const std::vector<Corrida> &corridas);
+
+    /* Invierte el estado de las corridas dadas, el costo depende de las celdas cambiadas y no
+     * del tamaño del tablero. Sirve para rehacer o deshacer generaciones desde un diario.
+     *
+     * @Param corridas: Corridas de celdas que cambian.
+     * @Param generacion: Generación del tablero resultante.
+     */
+    void invertirCeldas(const std::vector<Corrida> &corridas, long long generacion);
+
+    // Avanza n generaciones
+    void avanzar(int n);
+
+    /* Copia una ventana del tablero, fila por fila.
+     *
+     * @Param i0: Primera fila.
+     * @Param j0: Primera columna.
+     * @Param alto: Número de filas.
+     * @Param ancho: Número de columnas.
+     * @Param destino: Arreglo de alto * ancho celdas.
+     */
+    virtual void leerVentana(int i0, int j0, int alto, int ancho, bool *destino) = 0;
+
+    // Cuenta las celdas vivas
+    virtual long long poblacion() = 0;
+
+    /* Retorna las celdas de la fila i sin copiarlas, un byte 0 o 1 por celda. Sólo es válida
+     * hasta el siguiente avanzar(); es nullptr si el motor no guarda una celda por byte.
+     *
+     * @Param i: Fila.
+     */
+    virtual const uint8_t *filaDirecta(int i);
+
+    // Retorna las estadísticas del motor
+    GOLStats estadisticas();
+
+    // Generaciones avanzadas desde inicializar
+    long long getGeneracion() const;
+
+    // Número de filas sin contar las filas fantasmas
+    int getFilas() const;
+
+    // Número de columnas sin contar las columnas fantasmas
+    int getColumnas() const;
+
+    // Condición de borde
+    Frontera getFrontera() const;
+
+};
+
+/* Crea un motor por nombre, lanza std::invalid_argument si no existe y std::runtime_error si
+ * no se puede crear (por ejemplo, sin dispositivo OpenCL).
+ *
+ * @Param nombre: Nombre del motor, ver motoresDisponibles(). Además halo-k, tiled-lado y los de
+ *                tamaño fijo fijo-32, fijo-64, fijo-128 y fijo-256 (fijo.h).
+ * @Param nHilos: Hilos de los motores multihilo, 0 usa todos los núcleos.
+ */
+GOLEngine *crearMotor(const std::string &nombre, int nHilos = 0);
+
+// Nombres de los motores compilados
+std::vector<std::string> motoresDisponibles();
+
+// Hash FNV-1a del tablero completo, igual para todos los motores
+unsigned long long hashMotor(GOLEngine &motor);
+
+#endif // GAMEOFLIFECPU_ENGINE_H
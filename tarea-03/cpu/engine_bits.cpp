@@ -0,0 +1,172 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Motor de bits empaquetados, 64 celdas por palabra.
+ */
+
+#include <algorithm>
+#include "engines.h"
+#include "paralelo.h"
+#include "reglas.h"
+#include "rng.h"
+
+/**
+ * Constructor.
+ */
+GOLBits::GOLBits() {
+    W = 0;
+    actual = nullptr;
+    siguiente = nullptr;
+}
+
+/**
+ * Nombre del motor.
+ */
+std::string GOLBits::nombre() const {
+    return "bits";
+}
+
+/**
+ * Crea el tablero.
+ *
+ * @param probTrue Probabilidad
+ * @param seed Semilla
+ */
+void GOLBits::crearTablero(int probTrue, unsigned long long seed) {
+    W = (M + 2 + 63) / 64;
+    bufferA.assign((size_t) (N + 2) * W, 0);
+    bufferB.assign((size_t) (N + 2) * W, 0);
+    actual = bufferA.data();
+    siguiente = bufferB.data();
+
+    // Sólo las posiciones [1, M] son celdas reales
+    mascara.assign((size_t) W, 0);
+    for (int p = 1; p <= M; p++) {
+        mascara[p >> 6] |= 1ULL << (p & 63);
+    }
+
+    if (probTrue > 0) {
+        paraleloBandas(1, N + 1, 0, [this, probTrue, seed](int a, int b) {
+            for (int i = a; i < b; i++) {
+                uint64_t *fila = actual + (size_t) i * W;
+                unsigned long long base = (unsigned long long) (i - 1) * M;
+                for (int j = 0; j < M; j++) {
+                    if (celdaAleatoria(seed, base + j, probTrue)) {
+                        fila[(j + 1) >> 6] |= 1ULL << ((j + 1) & 63);
+                    }
+                }
+                corregirFila(fila);
+            }
+        });
+    }
+    actualizarFilasFantasmas(actual);
+}
+
+/**
+ * Marca en uno (o invierte) los bits [p, p + n) de una fila.
+ */
+static void marcarBits(uint64_t *fila, int p, int n, bool invertir) {
+    while (n > 0) {
+        int bit = p & 63, k = std::min(n, 64 - bit);
+        uint64_t mascara = k == 64 ? ~0ULL : ((1ULL << k) - 1) << bit;
+        if (invertir) fila[p >> 6] ^= mascara;
+        else fila[p >> 6] |= mascara;
+        p += k;
+        n -= k;
+    }
+}
+
+/**
+ * Marca vivas o invierte las corridas y actualiza las celdas fantasmas.
+ *
+ * @param corridas Corridas de celdas
+ * @param invertir Invierte las celdas en vez de marcarlas vivas
+ */
+void GOLBits::escribirCorridas(const std::vector<Corrida> &corridas, bool invertir) {
+    for (const Corrida &c : corridas) {
+        uint64_t *fila = actual + (size_t) (c.i + 1) * W;
+        marcarBits(fila, c.j + 1, c.n, invertir);
+
+        // Los bits fantasmas sólo dependen de la primera y la última columna
+        if (!invertir || c.j == 0 || c.j + c.n == M) corregirFila(fila);
+    }
+    actualizarFilasFantasmas(actual);
+}
+
+/**
+ * Borra los bits fuera del tablero y, con frontera toroidal, copia las columnas opuestas en los
+ * bits fantasmas 0 y M + 1.
+ *
+ * @param fila Fila
+ */
+void GOLBits::corregirFila(uint64_t *fila) {
+    for (int k = 0; k < W; k++) {
+        fila[k] &= mascara[k];
+    }
+    if (frontera == FRONTERA_TOROIDAL) {
+        fila[0] |= (fila[M >> 6] >> (M & 63)) & 1ULL;
+        fila[(M + 1) >> 6] |= ((fila[0] >> 1) & 1ULL) << ((M + 1) & 63);
+    }
+}
+
+/**
+ * Copia las filas reales opuestas en las filas fantasmas, sólo con frontera toroidal.
+ *
+ * @param matriz Matriz
+ */
+void GOLBits::actualizarFilasFantasmas(uint64_t *matriz) {
+    if (frontera != FRONTERA_TOROIDAL) return;
+    std::copy(matriz + (size_t) N * W, matriz + (size_t) (N + 1) * W, matriz);
+    std::copy(matriz + W, matriz + 2 * W, matriz + (size_t) (N + 1) * W);
+}
+
+/**
+ * Avanza n generaciones.
+ *
+ * @param n Generaciones
+ */
+void GOLBits::avanzarGeneraciones(int n) {
+    for (int g = 0; g < n; g++) {
+        for (int i = 1; i <= N; i++) {
+            uint64_t *fila = siguiente + (size_t) i * W;
+            reglasFilaBits(actual + (size_t) (i - 1) * W, actual + (size_t) i * W, actual + (size_t) (i + 1) * W,
+                           fila, W);
+            corregirFila(fila);
+        }
+        actualizarFilasFantasmas(siguiente);
+        std::swap(actual, siguiente);
+    }
+}
+
+/**
+ * Bytes usados por las dos matrices.
+ */
+size_t GOLBits::memoria() const {
+    return 2 * sizeof(uint64_t) * (size_t) (N + 2) * W;
+}
+
+/**
+ * Copia una ventana del tablero.
+ */
+void GOLBits::leerVentana(int i0, int j0, int alto, int ancho, bool *destino) {
+    for (int i = 0; i < alto; i++) {
+        const uint64_t *fila = actual + (size_t) (i0 + i + 1) * W;
+        for (int j = 0; j < ancho; j++) {
+            int p = j0 + j + 1;
+            destino[i * ancho + j] = ((fila[p >> 6] >> (p & 63)) & 1ULL) != 0;
+        }
+    }
+}
+
+/**
+ * Cuenta las celdas vivas.
+ */
+long long GOLBits::poblacion() {
+    long long vivas = 0;
+    for (int i = 1; i <= N; i++) {
+        const uint64_t *fila = actual + (size_t) i * W;
+        for (int k = 0; k < W; k++) {
+            vivas += contarBits(fila[k] & mascara[k]);
+        }
+    }
+    return vivas;
+}
@@ -0,0 +1,161 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Motor multihilo con halos anchos, una barrera cada k generaciones.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include "engines.h"
+#include "paralelo.h"
+#include "reglas.h"
+
+/**
+ * Constructor.
+ *
+ * @param k Filas de halo, generaciones entre barreras
+ * @param nHilos Cantidad de hilos, 0 usa todos los núcleos
+ */
+GOLHalo::GOLHalo(int k, int nHilos) : GOLThreaded(nHilos) {
+    this->k = k < 1 ? 1 : k;
+    filasCalculadas = 0;
+    barreras = 0;
+}
+
+/**
+ * Nombre del motor, halo-k si k no es el por defecto.
+ */
+std::string GOLHalo::nombre() const {
+    return k == HALO_K ? "halo" : "halo-" + std::to_string(k);
+}
+
+/**
+ * Crea el tablero y las copias privadas de cada banda.
+ *
+ * @param probTrue Probabilidad
+ * @param seed Semilla
+ */
+void GOLHalo::crearTablero(int probTrue, unsigned long long seed) {
+    GOLSimd::crearTablero(probTrue, seed);
+    int hilos = std::min(nHilos, N);
+    locales.assign((size_t) 2 * hilos, std::vector<uint8_t>());
+    for (int t = 0; t < hilos; t++) {
+        int a = 1 + (int) ((long long) N * t / hilos);
+        int b = 1 + (int) ((long long) N * (t + 1) / hilos);
+        size_t bytes = (size_t) (b - a + 2 * k) * stride;
+        locales[2 * t].assign(bytes, 0);
+        locales[2 * t + 1].assign(bytes, 0);
+    }
+    filasCalculadas = 0;
+    barreras = 0;
+}
+
+/**
+ * Avanza kk generaciones de la banda [a, b). La fila local r corresponde a la fila a - k + r del
+ * tablero; con frontera toroidal se envuelve y con frontera fija las filas fuera del tablero
+ * quedan muertas. En la generación s sólo las filas [s, L - s) siguen siendo válidas.
+ *
+ * @param t Índice de la banda
+ * @param a Primera fila
+ * @param b Fila final (no incluida)
+ * @param kk Generaciones, a lo más k
+ * @param origen Matriz actual
+ * @param destino Matriz donde se escribe la banda
+ * @return Filas calculadas
+ */
+long long GOLHalo::avanzarBanda(int t, int a, int b, int kk, const uint8_t *origen, uint8_t *destino) {
+    bool toroidal = frontera == FRONTERA_TOROIDAL;
+    int L = b - a + 2 * k;
+    uint8_t *local = locales[2 * t].data();
+    uint8_t *localSig = locales[2 * t + 1].data();
+
+    // Fila del tablero de cada fila local, 0 si está fuera con frontera fija
+    auto filaTablero = [this, a, toroidal](int r) {
+        int g = a - k + r;
+        if (toroidal) return ((g - 1) % N + N) % N + 1;
+        return g >= 1 && g <= N ? g : 0;
+    };
+
+    for (int r = 0; r < L; r++) {
+        int g = filaTablero(r);
+        if (g == 0) memset(local + (size_t) r * stride, 0, stride);
+        else memcpy(local + (size_t) r * stride, origen + (size_t) g * stride, stride);
+    }
+
+    long long calculadas = 0;
+    for (int s = 1; s <= kk; s++) {
+        int r0 = k - kk + s, r1 = L - k + kk - s;
+        for (int r = r0; r < r1; r++) {
+            uint8_t *fila = localSig + (size_t) r * stride;
+            if (filaTablero(r) == 0) {
+                memset(fila, 0, stride);
+                continue;
+            }
+            reglasFilaBytes(local + (size_t) (r - 1) * stride, local + (size_t) r * stride,
+                            local + (size_t) (r + 1) * stride, fila, M);
+            fila[0] = toroidal ? fila[M] : 0;
+            fila[M + 1] = toroidal ? fila[1] : 0;
+        }
+        calculadas += r1 - r0;
+        std::swap(local, localSig);
+    }
+
+    std::copy(local + (size_t) k * stride, local + (size_t) (k + b - a) * stride, destino + (size_t) a * stride);
+    if (toroidal) {
+        if (a <= N && N < b) std::copy(destino + (size_t) N * stride, destino + (size_t) (N + 1) * stride, destino);
+        if (a <= 1 && 1 < b) std::copy(destino + stride, destino + 2 * stride, destino + (size_t) (N + 1) * stride);
+    }
+    return calculadas;
+}
+
+/**
+ * Avanza n generaciones en rondas de k. Cada hilo lee su banda con halos de la matriz actual,
+ * avanza en su copia privada y escribe su banda en la siguiente; la única barrera de la ronda
+ * asegura que nadie lea la siguiente matriz antes de que esté completa.
+ *
+ * @param n Generaciones
+ */
+void GOLHalo::avanzarGeneraciones(int n) {
+    int hilos = std::min(nHilos, N);
+    int rondas = (n + k - 1) / k;
+    Barrera barrera(hilos);
+    std::atomic<long long> calculadas(0);
+    paraleloBandasIndice(1, N + 1, hilos, [this, n, rondas, &barrera, &calculadas](int t, int a, int b) {
+        uint8_t *origen = actual;
+        uint8_t *destino = siguiente;
+        long long propias = 0;
+        for (int ronda = 0; ronda < rondas; ronda++) {
+            int kk = std::min(k, n - ronda * k);
+            propias += avanzarBanda(t, a, b, kk, origen, destino);
+            barrera.esperar();
+            std::swap(origen, destino);
+        }
+        calculadas += propias;
+    });
+    if (rondas % 2 == 1) std::swap(actual, siguiente);
+    filasCalculadas += calculadas;
+    barreras += rondas;
+}
+
+/**
+ * Bytes usados por las dos matrices y las copias privadas.
+ */
+size_t GOLHalo::memoria() const {
+    size_t bytes = GOLSimd::memoria();
+    for (const std::vector<uint8_t> &l : locales) bytes += l.size();
+    return bytes;
+}
+
+/**
+ * Fracción de filas calculadas de más. Con bandas de h filas es cercana a (k - 1) / h.
+ */
+double GOLHalo::trabajoRedundante() const {
+    return generacion > 0 ? (double) filasCalculadas / ((double) N * generacion) - 1 : 0;
+}
+
+/**
+ * Barreras por generación, 1 / k salvo la última ronda incompleta.
+ */
+double GOLHalo::barrerasPorGeneracion() const {
+    return generacion > 0 ? (double) barreras / generacion : 0;
+}
@@ -0,0 +1,267 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Motor fuera de memoria, tablero de bits empaquetados en archivos mapeados con mmap.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "engines.h"
+#include "paralelo.h"
+#include "reglas.h"
+#include "rng.h"
+
+// Filas que se piden por adelantado al sistema operativo
+#define FILAS_PREFETCH 1024
+
+/**
+ * Lanza un error con el mensaje de errno.
+ */
+static void errorSistema(const std::string &operacion, const std::string &archivo) {
+    throw std::runtime_error(operacion + " " + archivo + ": " + strerror(errno));
+}
+
+/**
+ * Aplica madvise a los bytes [desde, hasta) de un mapa, alineando al inicio de página. Al
+ * liberar páginas sólo se incluyen las que quedan completas dentro del rango.
+ */
+static void aconsejar(void *mapa, size_t bytes, size_t desde, size_t hasta, int consejo) {
+    static const size_t pagina = (size_t) sysconf(_SC_PAGESIZE);
+    desde -= desde % pagina;
+    if (hasta > bytes) hasta = bytes;
+    if (consejo == MADV_DONTNEED) hasta -= hasta % pagina;
+    if (desde >= hasta) return;
+    madvise((char *) mapa + desde, hasta - desde, consejo);
+}
+
+/**
+ * Constructor.
+ *
+ * @param directorio Directorio de los archivos
+ */
+GOLMmap::GOLMmap(const std::string &directorio) {
+    const char *tmp = getenv("TMPDIR");
+    this->directorio = !directorio.empty() ? directorio : (tmp && *tmp ? tmp : "/tmp");
+    W = 0;
+    bytes = 0;
+    actual = 0;
+    for (int k = 0; k < 2; k++) {
+        fd[k] = -1;
+        mapas[k] = nullptr;
+    }
+}
+
+/**
+ * Destructor.
+ */
+GOLMmap::~GOLMmap() {
+    cerrar();
+}
+
+/**
+ * Nombre del motor.
+ */
+std::string GOLMmap::nombre() const {
+    return "mmap";
+}
+
+/**
+ * Cierra los mapas y borra los archivos.
+ */
+void GOLMmap::cerrar() {
+    for (int k = 0; k < 2; k++) {
+        if (mapas[k]) munmap(mapas[k], bytes);
+        if (fd[k] >= 0) {
+            close(fd[k]);
+            unlink(archivos[k].c_str());
+        }
+        mapas[k] = nullptr;
+        fd[k] = -1;
+    }
+}
+
+/**
+ * Crea los dos archivos, los mapea y escribe el tablero inicial en el primero.
+ *
+ * @param probTrue Probabilidad
+ * @param seed Semilla
+ */
+void GOLMmap::crearTablero(int probTrue, unsigned long long seed) {
+    cerrar();
+    W = (M + 2 + 63) / 64;
+    bytes = sizeof(uint64_t) * (size_t) N * W;
+    actual = 0;
+
+    for (int k = 0; k < 2; k++) {
+        std::string plantilla = directorio + "/GOL-XXXXXX";
+        std::vector<char> ruta(plantilla.begin(), plantilla.end());
+        ruta.push_back('\0');
+        fd[k] = mkstemp(ruta.data());
+        if (fd[k] < 0) errorSistema("No se pudo crear", plantilla);
+        archivos[k] = ruta.data();
+        if (ftruncate(fd[k], (off_t) bytes) != 0) errorSistema("No se pudo reservar", archivos[k]);
+        void *mapa = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd[k], 0);
+        if (mapa == MAP_FAILED) errorSistema("No se pudo mapear", archivos[k]);
+        mapas[k] = (uint64_t *) mapa;
+    }
+
+    mascara.assign((size_t) W, 0);
+    for (int p = 1; p <= M; p++) {
+        mascara[p >> 6] |= 1ULL << (p & 63);
+    }
+    ventana.assign((size_t) 4 * W, 0);
+
+    // El archivo recién truncado está en cero, sólo se escriben las celdas vivas
+    uint64_t *tablero = mapas[actual];
+    if (probTrue <= 0) return;
+    paraleloBandas(0, N, 0, [this, tablero, probTrue, seed](int a, int b) {
+        for (int i = a; i < b; i++) {
+            uint64_t *fila = tablero + (size_t) i * W;
+            unsigned long long base = (unsigned long long) i * M;
+            for (int j = 0; j < M; j++) {
+                if (celdaAleatoria(seed, base + j, probTrue)) {
+                    fila[(j + 1) >> 6] |= 1ULL << ((j + 1) & 63);
+                }
+            }
+        }
+    });
+}
+
+/**
+ * Marca vivas o invierte las corridas en el archivo, los bits fantasmas quedan en 0.
+ *
+ * @param corridas Corridas de celdas
+ * @param invertir Invierte las celdas en vez de marcarlas vivas
+ */
+void GOLMmap::escribirCorridas(const std::vector<Corrida> &corridas, bool invertir) {
+    for (const Corrida &c : corridas) {
+        uint64_t *fila = mapas[actual] + (size_t) c.i * W;
+        for (int p = c.j + 1; p <= c.j + c.n; p++) {
+            if (invertir) fila[p >> 6] ^= 1ULL << (p & 63);
+            else fila[p >> 6] |= 1ULL << (p & 63);
+        }
+    }
+}
+
+/**
+ * Copia una fila a la ventana. Con frontera toroidal copia las columnas opuestas en los bits
+ * fantasmas 0 y M + 1, con frontera fija quedan en 0.
+ *
+ * @param origen Fila del archivo, nullptr para una fila muerta
+ * @param fila Fila de la ventana
+ */
+void GOLMmap::cargarFila(const uint64_t *origen, uint64_t *fila) {
+    if (!origen) {
+        std::fill(fila, fila + W, 0);
+        return;
+    }
+    std::copy(origen, origen + W, fila);
+    if (frontera == FRONTERA_TOROIDAL) {
+        fila[0] |= (fila[M >> 6] >> (M & 63)) & 1ULL;
+        fila[(M + 1) >> 6] |= ((fila[0] >> 1) & 1ULL) << ((M + 1) & 63);
+    }
+}
+
+/**
+ * Avanza n generaciones. Cada fila del archivo de origen se lee una vez en orden; se pide al
+ * sistema operativo el siguiente bloque de filas antes de usarlo y se liberan las páginas ya
+ * recorridas, así la memoria residente se mantiene acotada aunque el tablero no quepa en RAM.
+ *
+ * @param n Generaciones
+ */
+void GOLMmap::avanzarGeneraciones(int n) {
+    size_t bytesFila = sizeof(uint64_t) * W;
+    bool toroidal = frontera == FRONTERA_TOROIDAL;
+
+    for (int g = 0; g < n; g++) {
+        const uint64_t *origen = mapas[actual];
+        uint64_t *destino = mapas[1 - actual];
+        madvise(mapas[actual], bytes, MADV_SEQUENTIAL);
+        madvise(destino, bytes, MADV_SEQUENTIAL);
+        aconsejar(mapas[actual], bytes, 0, 2 * FILAS_PREFETCH * bytesFila, MADV_WILLNEED);
+
+        // La primera fila se guarda porque es la vecina de abajo de la última
+        uint64_t *primera = ventana.data() + 3 * W;
+        uint64_t *arriba = ventana.data();
+        uint64_t *centro = ventana.data() + W;
+        uint64_t *abajo = ventana.data() + 2 * W;
+        cargarFila(origen, primera);
+        cargarFila(toroidal ? origen + (size_t) (N - 1) * W : nullptr, arriba);
+        std::copy(primera, primera + W, centro);
+
+        for (int i = 0; i < N; i++) {
+            // Pide el bloque siguiente y libera el anterior
+            if (i % FILAS_PREFETCH == 0 && i > 0) {
+                size_t bloque = (size_t) i * bytesFila;
+                aconsejar(mapas[actual], bytes, bloque + FILAS_PREFETCH * bytesFila,
+                          bloque + 2 * FILAS_PREFETCH * bytesFila, MADV_WILLNEED);
+                aconsejar(mapas[actual], bytes, 0, bloque - bytesFila, MADV_DONTNEED);
+                aconsejar(destino, bytes, 0, bloque - bytesFila, MADV_DONTNEED);
+            }
+
+            if (i + 1 < N) cargarFila(origen + (size_t) (i + 1) * W, abajo);
+            else if (toroidal) std::copy(primera, primera + W, abajo);
+            else cargarFila(nullptr, abajo);
+
+            uint64_t *fila = destino + (size_t) i * W;
+            reglasFilaBits(arriba, centro, abajo, fila, W);
+            for (int k = 0; k < W; k++) {
+                fila[k] &= mascara[k];
+            }
+
+            uint64_t *libre = arriba;
+            arriba = centro;
+            centro = abajo;
+            abajo = libre;
+        }
+
+        // Comienza a escribir en disco sin esperar
+        msync(destino, bytes, MS_ASYNC);
+        actual = 1 - actual;
+    }
+}
+
+/**
+ * Bytes de los dos archivos mapeados, la memoria residente es sólo la ventana y los bloques
+ * pedidos por adelantado.
+ */
+size_t GOLMmap::memoria() const {
+    return 2 * bytes;
+}
+
+/**
+ * Copia una ventana del tablero.
+ */
+void GOLMmap::leerVentana(int i0, int j0, int alto, int ancho, bool *destino) {
+    for (int i = 0; i < alto; i++) {
+        const uint64_t *fila = mapas[actual] + (size_t) (i0 + i) * W;
+        for (int j = 0; j < ancho; j++) {
+            int p = j0 + j + 1;
+            destino[i * ancho + j] = ((fila[p >> 6] >> (p & 63)) & 1ULL) != 0;
+        }
+    }
+}
+
+/**
+ * Cuenta las celdas vivas.
+ */
+long long GOLMmap::poblacion() {
+    long long vivas = 0;
+    const uint64_t *tablero = mapas[actual];
+    for (size_t k = 0; k < (size_t) N * W; k++) {
+        vivas += contarBits(tablero[k]);
+    }
+    return vivas;
+}
+
+/**
+ * Retorna la ruta del archivo con la generación actual.
+ */
+std::string GOLMmap::getArchivo() const {
+    return archivos[actual];
+}
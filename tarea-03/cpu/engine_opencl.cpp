@@ -0,0 +1,121 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Motor OpenCL, envuelve la clase GOLOpenCL. Sólo se compila si CMake encuentra OpenCL.
+ */
+
+#include <stdexcept>
+#include "engines.h"
+#include "../opencl/GOLOpenCL.h"
+
+#define OPENCL_LOCAL_SIZE 16    // Tamaño local de los kernels
+#define OPENCL_GENS 4           // Generaciones por lanzamiento de opencl-multi
+
+/**
+ * Motor OpenCL, usa el primer dispositivo disponible. Los kernels sólo implementan la frontera
+ * toroidal.
+ */
+class GOLOpenCLEngine : public GOLEngine {
+private:
+
+    GOLOpenCL *game;
+    KernelGOL kernel;
+    std::string nombreMotor;
+
+    // La matriz en la CPU corresponde a la generación actual
+    bool leida;
+
+    // Copia la matriz a la CPU si cambió
+    void sincronizar() {
+        if (!leida) {
+            game->terminar();
+            game->leerMatriz();
+            leida = true;
+        }
+    }
+
+protected:
+
+    void crearTablero(int probTrue, unsigned long long seed) override {
+        if (frontera != FRONTERA_TOROIDAL) {
+            throw std::invalid_argument("El motor OpenCL sólo soporta frontera toroidal");
+        }
+        delete game;
+        game = nullptr;
+        game = new GOLOpenCL(N, M, OPENCL_LOCAL_SIZE, kernel, OPENCL_GENS, CL_DEVICE_TYPE_ALL, GOL_KERNELS);
+        game->inicializarMatrizRandom(probTrue, seed);
+        leida = false;
+    }
+
+    void escribirCorridas(const std::vector<Corrida> &corridas, bool invertir) override {
+        sincronizar();
+        int *matriz = game->getMatriz();
+        for (const Corrida &c : corridas) {
+            for (int j = c.j; j < c.j + c.n; j++) {
+                int &celda = matriz[(c.i + 1) * (M + 2) + j + 1];
+                celda = invertir ? 1 - celda : 1;
+            }
+        }
+        game->escribirMatriz();
+    }
+
+    void avanzarGeneraciones(int n) override {
+        game->avanzar(n);
+        game->terminar();
+        leida = false;
+    }
+
+    size_t memoria() const override {
+        return 2 * sizeof(int) * (size_t) (N + 2) * (M + 2);
+    }
+
+public:
+
+    GOLOpenCLEngine(const std::string &nombre, KernelGOL kernel) {
+        this->game = nullptr;
+        this->kernel = kernel;
+        this->nombreMotor = nombre;
+        this->leida = false;
+    }
+
+    ~GOLOpenCLEngine() override {
+        delete game;
+    }
+
+    std::string nombre() const override {
+        return nombreMotor;
+    }
+
+    void leerVentana(int i0, int j0, int alto, int ancho, bool *destino) override {
+        sincronizar();
+        for (int i = 0; i < alto; i++) {
+            for (int j = 0; j < ancho; j++) {
+                destino[i * ancho + j] = game->getCelda(i0 + i, j0 + j);
+            }
+        }
+    }
+
+    long long poblacion() override {
+        sincronizar();
+        long long vivas = 0;
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j < M; j++) {
+                vivas += game->getCelda(i, j);
+            }
+        }
+        return vivas;
+    }
+
+};
+
+/**
+ * Crea un motor OpenCL.
+ *
+ * @param nombre opencl, opencl-if u opencl-multi
+ * @return Motor
+ */
+GOLEngine *crearMotorOpenCL(const std::string &nombre) {
+    if (nombre == "opencl") return new GOLOpenCLEngine(nombre, KERNEL_GOL);
+    if (nombre == "opencl-if") return new GOLOpenCLEngine(nombre, KERNEL_GOL_IF);
+    if (nombre == "opencl-multi") return new GOLOpenCLEngine(nombre, KERNEL_GOL_MULTI);
+    throw std::invalid_argument("Motor desconocido: " + nombre);
+}
@@ -0,0 +1,119 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Motor escalar, envuelve la clase GOL con dos matrices (scalar) o en sitio (inplace).
+ */
+
+#include "engines.h"
+
+/**
+ * Constructor.
+ *
+ * @param enSitio Usa el modo en sitio de GOL
+ * @param nHilos Bandas en paralelo del modo en sitio
+ */
+GOLScalar::GOLScalar(bool enSitio, int nHilos) {
+    game = nullptr;
+    this->enSitio = enSitio;
+    this->nHilos = nHilos;
+    this->regla = "B3/S23";
+}
+
+/**
+ * Destructor.
+ */
+GOLScalar::~GOLScalar() {
+    delete game;
+}
+
+/**
+ * Nombre del motor.
+ */
+std::string GOLScalar::nombre() const {
+    return enSitio ? "inplace" : "scalar";
+}
+
+/**
+ * Cambia la regla de los siguientes tableros.
+ *
+ * @param regla Regla, por ejemplo "B36/S23"
+ */
+void GOLScalar::setRegla(const std::string &regla) {
+    GOL prueba(1, 1);
+    prueba.setRegla(regla); // Lanza invalid_argument si no es válida
+    this->regla = regla;
+}
+
+/**
+ * Crea el tablero, las filas fantasmas parten muertas. Si el tamaño no cambia se reutiliza el
+ * tablero anterior.
+ *
+ * @param probTrue Probabilidad
+ * @param seed Semilla
+ */
+void GOLScalar::crearTablero(int probTrue, unsigned long long seed) {
+    if (!game || game->getFilas() != N || game->getColumnas() != M) {
+        delete game;
+        game = new GOL(N, M, enSitio, nHilos);
+    }
+    game->setRegla(regla);
+    game->setMatrizToFalse();
+    game->setFrontera(frontera);
+    if (probTrue > 0) game->inicializarMatrizRandom(probTrue, seed);
+}
+
+/**
+ * Marca vivas o invierte las corridas.
+ *
+ * @param corridas Corridas de celdas
+ * @param invertir Invierte las celdas en vez de marcarlas vivas
+ */
+void GOLScalar::escribirCorridas(const std::vector<Corrida> &corridas, bool invertir) {
+    for (const Corrida &c : corridas) {
+        if (invertir) game->invertirCeldas(c.i, c.j, c.n);
+        else game->setCeldas(c.i, c.j, c.n, true);
+    }
+}
+
+/**
+ * Avanza n generaciones.
+ *
+ * @param n Generaciones
+ */
+void GOLScalar::avanzarGeneraciones(int n) {
+    for (int g = 0; g < n; g++) {
+        game->aplicarReglas();
+    }
+}
+
+/**
+ * Bytes usados por las matrices.
+ */
+size_t GOLScalar::memoria() const {
+    return game ? game->memoria() : 0;
+}
+
+/**
+ * Copia una ventana del tablero.
+ */
+void GOLScalar::leerVentana(int i0, int j0, int alto, int ancho, bool *destino) {
+    for (int i = 0; i < alto; i++) {
+        for (int j = 0; j < ancho; j++) {
+            destino[i * ancho + j] = game->getCelda(i0 + i, j0 + j);
+        }
+    }
+}
+
+/**
+ * Fila del tablero de GOL, un bool ocupa un byte con valor 0 o 1.
+ */
+const uint8_t *GOLScalar::filaDirecta(int i) {
+    static_assert(sizeof(bool) == 1, "GOL guarda una celda por byte");
+    return reinterpret_cast<const uint8_t *>(game->getFila(i));
+}
+
+/**
+ * Cuenta las celdas vivas.
+ */
+long long GOLScalar::poblacion() {
+    return game->contarPoblacion();
+}
@@ -0,0 +1,166 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Motor SIMD, una celda por byte y 8 celdas por operación.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include "engines.h"
+#include "paralelo.h"
+#include "reglas.h"
+#include "rng.h"
+
+/**
+ * Constructor.
+ */
+GOLSimd::GOLSimd() {
+    stride = 0;
+    actual = nullptr;
+    siguiente = nullptr;
+}
+
+/**
+ * Nombre del motor.
+ */
+std::string GOLSimd::nombre() const {
+    return "simd";
+}
+
+/**
+ * Crea el tablero.
+ *
+ * @param probTrue Probabilidad
+ * @param seed Semilla
+ */
+void GOLSimd::crearTablero(int probTrue, unsigned long long seed) {
+    // reglasFilaBytes lee hasta el byte M + 8 de cada fila
+    stride = ((M + 10 + 7) / 8) * 8;
+    bufferA.assign((size_t) (N + 2) * stride, 0);
+    bufferB.assign((size_t) (N + 2) * stride, 0);
+    actual = bufferA.data();
+    siguiente = bufferB.data();
+
+    if (probTrue > 0) {
+        paraleloBandas(1, N + 1, 0, [this, probTrue, seed](int a, int b) {
+            for (int i = a; i < b; i++) {
+                unsigned long long base = (unsigned long long) (i - 1) * M;
+                for (int j = 1; j <= M; j++) {
+                    actual[(size_t) i * stride + j] = celdaAleatoria(seed, base + j - 1, probTrue) ? 1 : 0;
+                }
+            }
+        });
+    }
+    actualizarFantasmas(actual);
+}
+
+/**
+ * Marca vivas o invierte las corridas y actualiza las celdas fantasmas.
+ *
+ * @param corridas Corridas de celdas
+ * @param invertir Invierte las celdas en vez de marcarlas vivas
+ */
+void GOLSimd::escribirCorridas(const std::vector<Corrida> &corridas, bool invertir) {
+    for (const Corrida &c : corridas) {
+        uint8_t *celda = actual + (size_t) (c.i + 1) * stride + c.j + 1;
+        if (!invertir) {
+            memset(celda, 1, (size_t) c.n);
+            continue;
+        }
+        for (int k = 0; k < c.n; k++) celda[k] ^= 1;
+    }
+    actualizarFantasmas(actual);
+}
+
+/**
+ * Calcula las filas [i0, i1) y actualiza sus columnas fantasmas. Con frontera toroidal la banda
+ * que contiene la última (primera) fila real también la copia en la fila fantasma opuesta.
+ *
+ * @param origen Matriz actual
+ * @param destino Matriz de la siguiente generación
+ * @param i0 Primera fila
+ * @param i1 Fila final (no incluida)
+ */
+void GOLSimd::calcularFilas(const uint8_t *origen, uint8_t *destino, int i0, int i1) {
+    bool toroidal = frontera == FRONTERA_TOROIDAL;
+    for (int i = i0; i < i1; i++) {
+        uint8_t *fila = destino + (size_t) i * stride;
+        reglasFilaBytes(origen + (size_t) (i - 1) * stride, origen + (size_t) i * stride,
+                        origen + (size_t) (i + 1) * stride, fila, M);
+        fila[0] = toroidal ? fila[M] : 0;
+        fila[M + 1] = toroidal ? fila[1] : 0;
+    }
+    if (toroidal) {
+        if (i0 <= N && N < i1) std::copy(destino + (size_t) N * stride, destino + (size_t) (N + 1) * stride, destino);
+        if (i0 <= 1 && 1 < i1) std::copy(destino + stride, destino + 2 * stride, destino + (size_t) (N + 1) * stride);
+    }
+}
+
+/**
+ * Actualiza todas las celdas fantasmas.
+ *
+ * @param matriz Matriz
+ */
+void GOLSimd::actualizarFantasmas(uint8_t *matriz) {
+    bool toroidal = frontera == FRONTERA_TOROIDAL;
+    for (int i = 1; i <= N; i++) {
+        uint8_t *fila = matriz + (size_t) i * stride;
+        fila[0] = toroidal ? fila[M] : 0;
+        fila[M + 1] = toroidal ? fila[1] : 0;
+    }
+    if (toroidal) {
+        std::copy(matriz + (size_t) N * stride, matriz + (size_t) (N + 1) * stride, matriz);
+        std::copy(matriz + stride, matriz + 2 * stride, matriz + (size_t) (N + 1) * stride);
+    }
+}
+
+/**
+ * Avanza n generaciones.
+ *
+ * @param n Generaciones
+ */
+void GOLSimd::avanzarGeneraciones(int n) {
+    for (int g = 0; g < n; g++) {
+        calcularFilas(actual, siguiente, 1, N + 1);
+        std::swap(actual, siguiente);
+    }
+}
+
+/**
+ * Bytes usados por las dos matrices.
+ */
+size_t GOLSimd::memoria() const {
+    return 2 * (size_t) (N + 2) * stride;
+}
+
+/**
+ * Copia una ventana del tablero.
+ */
+void GOLSimd::leerVentana(int i0, int j0, int alto, int ancho, bool *destino) {
+    for (int i = 0; i < alto; i++) {
+        const uint8_t *fila = actual + (size_t) (i0 + i + 1) * stride + j0 + 1;
+        for (int j = 0; j < ancho; j++) {
+            destino[i * ancho + j] = fila[j] != 0;
+        }
+    }
+}
+
+/**
+ * Fila de la matriz actual, sin la columna fantasma.
+ */
+const uint8_t *GOLSimd::filaDirecta(int i) {
+    return actual + (size_t) (i + 1) * stride + 1;
+}
+
+/**
+ * Cuenta las celdas vivas.
+ */
+long long GOLSimd::poblacion() {
+    long long vivas = 0;
+    for (int i = 1; i <= N; i++) {
+        const uint8_t *fila = actual + (size_t) i * stride;
+        for (int j = 1; j <= M; j++) {
+            vivas += fila[j];
+        }
+    }
+    return vivas;
+}
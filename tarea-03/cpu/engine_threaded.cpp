@@ -0,0 +1,45 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Motor multihilo, bandas de filas con una barrera por generación.
+ */
+
+#include <algorithm>
+#include "engines.h"
+#include "paralelo.h"
+
+/**
+ * Constructor.
+ *
+ * @param nHilos Cantidad de hilos, 0 usa todos los núcleos
+ */
+GOLThreaded::GOLThreaded(int nHilos) {
+    this->nHilos = nHilos < 1 ? hilosDisponibles() : nHilos;
+}
+
+/**
+ * Nombre del motor.
+ */
+std::string GOLThreaded::nombre() const {
+    return "threaded";
+}
+
+/**
+ * Avanza n generaciones. Cada hilo calcula su banda y espera a los demás antes de la siguiente
+ * generación, las filas fantasmas las copia el hilo dueño de la fila real.
+ *
+ * @param n Generaciones
+ */
+void GOLThreaded::avanzarGeneraciones(int n) {
+    int hilos = std::min(nHilos, N);
+    Barrera barrera(hilos);
+    paraleloBandas(1, N + 1, hilos, [this, n, &barrera](int i0, int i1) {
+        uint8_t *origen = actual;
+        uint8_t *destino = siguiente;
+        for (int g = 0; g < n; g++) {
+            calcularFilas(origen, destino, i0, i1);
+            barrera.esperar();
+            std::swap(origen, destino);
+        }
+    });
+    if (n % 2 == 1) std::swap(actual, siguiente);
+}
@@ -0,0 +1,227 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Motor por teselas, cada tesela contigua en memoria con su borde fantasma y en orden Z.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include "engines.h"
+#include "reglas.h"
+#include "rng.h"
+
+/**
+ * Intercala los bits de ti y tj, código de Morton de la tesela.
+ */
+static unsigned long long codigoMorton(int ti, int tj) {
+    unsigned long long z = 0;
+    for (int b = 0; b < 31; b++) {
+        z |= (unsigned long long) (ti >> b & 1) << (2 * b + 1) | (unsigned long long) (tj >> b & 1) << (2 * b);
+    }
+    return z;
+}
+
+/**
+ * Constructor.
+ *
+ * @param lado Celdas por lado de tesela
+ */
+GOLTiled::GOLTiled(int lado) {
+    this->lado = lado < 8 ? 8 : lado;
+    stride = 0;
+    bytesTesela = 0;
+    teselasI = 0;
+    teselasJ = 0;
+    actual = nullptr;
+    siguiente = nullptr;
+}
+
+/**
+ * Nombre del motor, tiled-lado si el lado no es el por defecto.
+ */
+std::string GOLTiled::nombre() const {
+    return lado == TESELA_LADO ? "tiled" : "tiled-" + std::to_string(lado);
+}
+
+/**
+ * Primera celda de una tesela, incluye su borde.
+ */
+uint8_t *GOLTiled::tesela(uint8_t *matriz, int ti, int tj) const {
+    return matriz + (size_t) orden[(size_t) ti * teselasJ + tj] * bytesTesela;
+}
+
+/**
+ * Celda del tablero.
+ *
+ * @param matriz Matriz de teselas
+ * @param i Fila, puede salir del tablero
+ * @param j Columna, puede salir del tablero
+ * @return Celda, nullptr fuera del tablero con frontera fija
+ */
+uint8_t *GOLTiled::celda(uint8_t *matriz, int i, int j) const {
+    if (frontera == FRONTERA_TOROIDAL) {
+        i = (i + N) % N;
+        j = (j + M) % M;
+    } else if (i < 0 || j < 0 || i >= N || j >= M) {
+        return nullptr;
+    }
+    return tesela(matriz, i / lado, j / lado) + (size_t) (i % lado + 1) * stride + j % lado + 1;
+}
+
+/**
+ * Crea el tablero.
+ *
+ * @param probTrue Probabilidad
+ * @param seed Semilla
+ */
+void GOLTiled::crearTablero(int probTrue, unsigned long long seed) {
+    // reglasFilaBytes lee hasta el byte lado + 8 de cada fila
+    stride = ((lado + 10 + 7) / 8) * 8;
+    bytesTesela = (size_t) (lado + 2) * stride;
+    teselasI = (N + lado - 1) / lado;
+    teselasJ = (M + lado - 1) / lado;
+
+    // Las teselas se guardan ordenadas por su código de Morton
+    int teselas = teselasI * teselasJ;
+    recorrido.resize((size_t) teselas);
+    for (int t = 0; t < teselas; t++) recorrido[t] = t;
+    std::sort(recorrido.begin(), recorrido.end(), [this](int a, int b) {
+        return codigoMorton(a / teselasJ, a % teselasJ) < codigoMorton(b / teselasJ, b % teselasJ);
+    });
+    orden.resize((size_t) teselas);
+    for (int k = 0; k < teselas; k++) orden[recorrido[k]] = k;
+
+    bufferA.assign((size_t) teselas * bytesTesela, 0);
+    bufferB.assign((size_t) teselas * bytesTesela, 0);
+    actual = bufferA.data();
+    siguiente = bufferB.data();
+
+    if (probTrue > 0) {
+        for (int i = 0; i < N; i++) {
+            for (int tj = 0; tj < teselasJ; tj++) {
+                uint8_t *fila = celda(actual, i, tj * lado);
+                int ancho = std::min(lado, M - tj * lado);
+                unsigned long long base = (unsigned long long) i * M + (unsigned long long) tj * lado;
+                for (int j = 0; j < ancho; j++) fila[j] = celdaAleatoria(seed, base + j, probTrue) ? 1 : 0;
+            }
+        }
+    }
+}
+
+/**
+ * Marca vivas o invierte las corridas, una corrida puede cruzar varias teselas.
+ *
+ * @param corridas Corridas de celdas
+ * @param invertir Invierte las celdas en vez de marcarlas vivas
+ */
+void GOLTiled::escribirCorridas(const std::vector<Corrida> &corridas, bool invertir) {
+    for (const Corrida &c : corridas) {
+        for (int j = c.j; j < c.j + c.n;) {
+            int n = std::min(c.j + c.n, (j / lado + 1) * lado) - j;
+            uint8_t *p = celda(actual, c.i, j);
+            if (invertir) {
+                for (int k = 0; k < n; k++) p[k] ^= 1;
+            } else {
+                memset(p, 1, (size_t) n);
+            }
+            j += n;
+        }
+    }
+}
+
+/**
+ * Copia los bordes fantasmas de cada tesela. Las filas de borde salen de una sola tesela vecina
+ * salvo las esquinas; las columnas de borde salen de la tesela vecina de la misma fila de
+ * teselas, que tiene la misma altura.
+ *
+ * @param matriz Matriz de teselas
+ */
+void GOLTiled::actualizarBordes(uint8_t *matriz) {
+    for (int t : recorrido) {
+        int ti = t / teselasJ, tj = t % teselasJ;
+        int i0 = ti * lado, j0 = tj * lado;
+        int alto = std::min(lado, N - i0), ancho = std::min(lado, M - j0);
+        uint8_t *base = tesela(matriz, ti, tj);
+
+        // Filas de arriba y abajo con sus esquinas
+        int filas[2] = {i0 - 1, i0 + alto};
+        uint8_t *destinos[2] = {base, base + (size_t) (alto + 1) * stride};
+        for (int k = 0; k < 2; k++) {
+            const uint8_t *centro = celda(matriz, filas[k], j0);
+            const uint8_t *izquierda = celda(matriz, filas[k], j0 - 1);
+            const uint8_t *derecha = celda(matriz, filas[k], j0 + ancho);
+            if (centro) memcpy(destinos[k] + 1, centro, (size_t) ancho);
+            else memset(destinos[k] + 1, 0, (size_t) ancho);
+            destinos[k][0] = izquierda ? *izquierda : 0;
+            destinos[k][ancho + 1] = derecha ? *derecha : 0;
+        }
+
+        // Columnas izquierda y derecha
+        const uint8_t *izquierda = celda(matriz, i0, j0 - 1);
+        const uint8_t *derecha = celda(matriz, i0, j0 + ancho);
+        for (int k = 0; k < alto; k++) {
+            uint8_t *fila = base + (size_t) (k + 1) * stride;
+            fila[0] = izquierda ? izquierda[(size_t) k * stride] : 0;
+            fila[ancho + 1] = derecha ? derecha[(size_t) k * stride] : 0;
+        }
+    }
+}
+
+/**
+ * Avanza n generaciones.
+ *
+ * @param n Generaciones
+ */
+void GOLTiled::avanzarGeneraciones(int n) {
+    for (int g = 0; g < n; g++) {
+        actualizarBordes(actual);
+        for (int t : recorrido) {
+            int ti = t / teselasJ, tj = t % teselasJ;
+            int alto = std::min(lado, N - ti * lado), ancho = std::min(lado, M - tj * lado);
+            const uint8_t *origen = tesela(actual, ti, tj);
+            uint8_t *destino = tesela(siguiente, ti, tj);
+            for (int k = 1; k <= alto; k++) {
+                reglasFilaBytes(origen + (size_t) (k - 1) * stride, origen + (size_t) k * stride,
+                                origen + (size_t) (k + 1) * stride, destino + (size_t) k * stride, ancho);
+            }
+        }
+        std::swap(actual, siguiente);
+    }
+}
+
+/**
+ * Bytes usados por las dos matrices de teselas.
+ */
+size_t GOLTiled::memoria() const {
+    return bufferA.size() + bufferB.size();
+}
+
+/**
+ * Copia una ventana del tablero.
+ */
+void GOLTiled::leerVentana(int i0, int j0, int alto, int ancho, bool *destino) {
+    for (int i = 0; i < alto; i++) {
+        for (int j = 0; j < ancho;) {
+            int n = std::min(ancho, ((j0 + j) / lado + 1) * lado - j0) - j;
+            const uint8_t *p = celda(actual, i0 + i, j0 + j);
+            for (int k = 0; k < n; k++) destino[i * ancho + j + k] = p[k] != 0;
+            j += n;
+        }
+    }
+}
+
+/**
+ * Cuenta las celdas vivas.
+ */
+long long GOLTiled::poblacion() {
+    long long vivas = 0;
+    for (int ti = 0; ti < teselasI; ti++) {
+        for (int tj = 0; tj < teselasJ; tj++) {
+            int alto = std::min(lado, N - ti * lado), ancho = std::min(lado, M - tj * lado);
+            const uint8_t *base = tesela(actual, ti, tj);
+            for (int k = 1; k <= alto; k++) {
+                for (int j = 1; j <= ancho; j++) vivas += base[(size_t) k * stride + j];
+            }
+        }
+    }
+    return vivas;
+}
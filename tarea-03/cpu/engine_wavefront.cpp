@@ -0,0 +1,56 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Motor multihilo sin barreras, las bandas avanzan en frente de onda con contadores atómicos.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include "engines.h"
+#include "paralelo.h"
+
+/**
+ * Constructor.
+ *
+ * @param nHilos Cantidad de hilos, 0 usa todos los núcleos
+ */
+GOLWavefront::GOLWavefront(int nHilos) : GOLThreaded(nHilos) {
+}
+
+/**
+ * Nombre del motor.
+ */
+std::string GOLWavefront::nombre() const {
+    return "wavefront";
+}
+
+/**
+ * Avanza n generaciones. La generación g está en la matriz g % 2; para escribir g + 1 sobre la
+ * matriz de g - 1 basta que las vecinas hayan completado g, ya que así terminaron de leer g - 1.
+ * Con frontera toroidal la primera y la última banda también son vecinas, por las filas
+ * fantasmas que copia cada una.
+ *
+ * @param n Generaciones
+ */
+void GOLWavefront::avanzarGeneraciones(int n) {
+    int hilos = std::min(nHilos, N);
+    bool toroidal = frontera == FRONTERA_TOROIDAL;
+    std::unique_ptr<std::atomic<int>[]> progreso(new std::atomic<int>[hilos]);
+    for (int t = 0; t < hilos; t++) progreso[t].store(0);
+
+    paraleloBandasIndice(1, N + 1, hilos, [this, n, hilos, toroidal, &progreso](int t, int i0, int i1) {
+        uint8_t *matrices[2] = {actual, siguiente};
+        int arriba = t > 0 ? t - 1 : (toroidal ? hilos - 1 : -1);
+        int abajo = t < hilos - 1 ? t + 1 : (toroidal ? 0 : -1);
+        for (int g = 0; g < n; g++) {
+            while ((arriba >= 0 && progreso[arriba].load(std::memory_order_acquire) < g) ||
+                   (abajo >= 0 && progreso[abajo].load(std::memory_order_acquire) < g)) {
+                std::this_thread::yield();
+            }
+            calcularFilas(matrices[g % 2], matrices[(g + 1) % 2], i0, i1);
+            progreso[t].store(g + 1, std::memory_order_release);
+        }
+    });
+    if (n % 2 == 1) std::swap(actual, siguiente);
+}
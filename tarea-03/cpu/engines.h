@@ -0,0 +1,356 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Motores concretos del juego de la vida, se crean con crearMotor (engine.h).
+ */
+
+#ifndef GAMEOFLIFECPU_ENGINES_H
+#define GAMEOFLIFECPU_ENGINES_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "engine.h"
+
+/**
+ * Motor escalar, usa la clase GOL original. En sitio (inplace) usa una sola matriz.
+ */
+class GOLScalar : public GOLEngine {
+private:
+
+    GOL *game;
+
+    // Modo en sitio y bandas en paralelo
+    bool enSitio;
+    int nHilos;
+
+    // Regla en formato B/S, se aplica al crear el tablero
+    std::string regla;
+
+protected:
+
+    void crearTablero(int probTrue, unsigned long long seed) override;
+
+    void escribirCorridas(const std::vector<Corrida> &corridas, bool invertir) override;
+
+    void avanzarGeneraciones(int n) override;
+
+    size_t memoria() const override;
+
+public:
+
+    explicit GOLScalar(bool enSitio = false, int nHilos = 1);
+
+    ~GOLScalar() override;
+
+    std::string nombre() const override;
+
+    void leerVentana(int i0, int j0, int alto, int ancho, bool *destino) override;
+
+    long long poblacion() override;
+
+    const uint8_t *filaDirecta(int i) override;
+
+    // Cambia la regla (B/S) de los siguientes tableros, los demás motores sólo usan B3/S23
+    void setRegla(const std::string &regla);
+
+};
+
+/**
+ * Motor SIMD, una celda por byte y 8 celdas por operación (reglasFilaBytes).
+ */
+class GOLSimd : public GOLEngine {
+protected:
+
+    // Bytes por fila, incluye las columnas fantasmas y el relleno que lee reglasFilaBytes
+    int stride;
+
+    // Matrices, incluyen las filas fantasmas
+    std::vector<uint8_t> bufferA;
+    std::vector<uint8_t> bufferB;
+    uint8_t *actual;
+    uint8_t *siguiente;
+
+    // Calcula las filas [i0, i1) de origen en destino y actualiza sus celdas fantasmas
+    void calcularFilas(const uint8_t *origen, uint8_t *destino, int i0, int i1);
+
+    // Actualiza todas las celdas fantasmas de una matriz
+    void actualizarFantasmas(uint8_t *matriz);
+
+    void crearTablero(int probTrue, unsigned long long seed) override;
+
+    void escribirCorridas(const std::vector<Corrida> &corridas, bool invertir) override;
+
+    void avanzarGeneraciones(int n) override;
+
+    size_t memoria() const override;
+
+public:
+
+    GOLSimd();
+
+    std::string nombre() const override;
+
+    void leerVentana(int i0, int j0, int alto, int ancho, bool *destino) override;
+
+    long long poblacion() override;
+
+    const uint8_t *filaDirecta(int i) override;
+
+};
+
+/**
+ * Motor multihilo, divide el tablero en bandas de filas con una barrera por generación.
+ */
+class GOLThreaded : public GOLSimd {
+protected:
+
+    // Cantidad de hilos
+    int nHilos;
+
+    void avanzarGeneraciones(int n) override;
+
+public:
+
+    explicit GOLThreaded(int nHilos = 0);
+
+    std::string nombre() const override;
+
+};
+
+/**
+ * Motor multihilo sin barreras: cada banda publica la última generación que completó en un
+ * contador atómico y avanza a la generación g + 1 apenas sus dos bandas vecinas completaron g.
+ * Las bandas quedan a lo más una generación desfasadas, así un hilo lento sólo frena a sus
+ * vecinos y no a todo el tablero.
+ */
+class GOLWavefront : public GOLThreaded {
+protected:
+
+    void avanzarGeneraciones(int n) override;
+
+public:
+
+    explicit GOLWavefront(int nHilos = 0);
+
+    std::string nombre() const override;
+
+};
+
+// Filas de halo por defecto del motor halo
+#define HALO_K 4
+
+/**
+ * Motor multihilo con halos anchos: cada banda copia k filas extra a cada lado y avanza k
+ * generaciones en su copia privada antes de escribir su banda, con una barrera cada k
+ * generaciones en vez de una por generación. Las filas del halo se calculan de más.
+ */
+class GOLHalo : public GOLThreaded {
+protected:
+
+    // Filas de halo a cada lado, generaciones entre barreras
+    int k;
+
+    // Copias privadas de cada banda con sus halos, dos por banda
+    std::vector<std::vector<uint8_t>> locales;
+
+    // Filas calculadas (incluye las redundantes) y barreras esperadas
+    long long filasCalculadas;
+    long long barreras;
+
+    // Avanza kk generaciones de la banda [a, b) y la escribe en destino, retorna las filas calculadas
+    long long avanzarBanda(int t, int a, int b, int kk, const uint8_t *origen, uint8_t *destino);
+
+    void crearTablero(int probTrue, unsigned long long seed) override;
+
+    void avanzarGeneraciones(int n) override;
+
+    size_t memoria() const override;
+
+public:
+
+    explicit GOLHalo(int k = HALO_K, int nHilos = 0);
+
+    std::string nombre() const override;
+
+    // Fracción de filas calculadas de más respecto a las N filas por generación
+    double trabajoRedundante() const;
+
+    // Barreras por generación
+    double barrerasPorGeneracion() const;
+
+};
+
+/**
+ * Motor de bits empaquetados, 64 celdas por palabra (reglasFilaBits).
+ */
+class GOLBits : public GOLEngine {
+protected:
+
+    // Palabras por fila, el bit p corresponde a la columna p - 1 (0 y M + 1 son fantasmas)
+    int W;
+
+    // Matrices, incluyen las filas fantasmas
+    std::vector<uint64_t> bufferA;
+    std::vector<uint64_t> bufferB;
+    uint64_t *actual;
+    uint64_t *siguiente;
+
+    // Máscara de los bits de celdas reales en cada palabra
+    std::vector<uint64_t> mascara;
+
+    // Corrige los bits fantasmas y el relleno de una fila
+    void corregirFila(uint64_t *fila);
+
+    // Actualiza las filas fantasmas de una matriz
+    void actualizarFilasFantasmas(uint64_t *matriz);
+
+    void crearTablero(int probTrue, unsigned long long seed) override;
+
+    void escribirCorridas(const std::vector<Corrida> &corridas, bool invertir) override;
+
+    void avanzarGeneraciones(int n) override;
+
+    size_t memoria() const override;
+
+public:
+
+    GOLBits();
+
+    std::string nombre() const override;
+
+    void leerVentana(int i0, int j0, int alto, int ancho, bool *destino) override;
+
+    long long poblacion() override;
+
+};
+
+// Lado por defecto de las teselas del motor tiled
+#define TESELA_LADO 64
+
+/**
+ * Motor por teselas: el tablero se guarda en teselas cuadradas de lado x lado celdas (una por
+ * byte), cada una contigua en memoria con su propio borde fantasma y en orden Z (Morton). Así
+ * los vecinos verticales de una celda quedan a lado + 2 bytes y no a una fila completa del
+ * tablero. Cada generación primero copia los bordes desde las teselas vecinas y luego aplica
+ * reglasFilaBytes a cada tesela.
+ */
+class GOLTiled : public GOLEngine {
+protected:
+
+    // Celdas reales por lado de tesela, bytes por fila de tesela y bytes por tesela
+    int lado;
+    int stride;
+    size_t bytesTesela;
+
+    // Teselas por columna y por fila del tablero
+    int teselasI;
+    int teselasJ;
+
+    // Posición en memoria de la tesela ti * teselasJ + tj y teselas en orden Z
+    std::vector<int> orden;
+    std::vector<int> recorrido;
+
+    // Matrices de teselas
+    std::vector<uint8_t> bufferA;
+    std::vector<uint8_t> bufferB;
+    uint8_t *actual;
+    uint8_t *siguiente;
+
+    // Primera celda (borde incluido) de la tesela (ti, tj)
+    uint8_t *tesela(uint8_t *matriz, int ti, int tj) const;
+
+    // Celda (i, j) del tablero, envuelve con frontera toroidal y es nullptr fuera con frontera fija
+    uint8_t *celda(uint8_t *matriz, int i, int j) const;
+
+    // Copia los bordes fantasmas de todas las teselas desde sus vecinas
+    void actualizarBordes(uint8_t *matriz);
+
+    void crearTablero(int probTrue, unsigned long long seed) override;
+
+    void escribirCorridas(const std::vector<Corrida> &corridas, bool invertir) override;
+
+    void avanzarGeneraciones(int n) override;
+
+    size_t memoria() const override;
+
+public:
+
+    explicit GOLTiled(int lado = TESELA_LADO);
+
+    std::string nombre() const override;
+
+    void leerVentana(int i0, int j0, int alto, int ancho, bool *destino) override;
+
+    long long poblacion() override;
+
+};
+
+#ifdef GOL_MMAP
+
+/**
+ * Motor fuera de memoria, el tablero de bits empaquetados vive en un archivo mapeado con mmap.
+ * Cada generación recorre el archivo en orden con una ventana de tres filas y escribe la
+ * siguiente en un segundo archivo mapeado, por lo que la memoria residente no depende de N.
+ */
+class GOLMmap : public GOLEngine {
+protected:
+
+    // Palabras por fila, igual que GOLBits. Las filas del archivo tienen los bits fantasmas en 0
+    int W;
+
+    // Directorio de los archivos, archivos y mapas de la generación actual y la siguiente
+    std::string directorio;
+    std::string archivos[2];
+    int fd[2];
+    uint64_t *mapas[2];
+    size_t bytes;
+    int actual;
+
+    // Máscara de los bits de celdas reales en cada palabra
+    std::vector<uint64_t> mascara;
+
+    // Ventana de filas: anterior, actual, siguiente y la primera fila (vecina de la última)
+    std::vector<uint64_t> ventana;
+
+    // Cierra y borra los archivos
+    void cerrar();
+
+    // Copia una fila del archivo a la ventana y corrige sus bits fantasmas
+    void cargarFila(const uint64_t *origen, uint64_t *fila);
+
+    void crearTablero(int probTrue, unsigned long long seed) override;
+
+    void escribirCorridas(const std::vector<Corrida> &corridas, bool invertir) override;
+
+    void avanzarGeneraciones(int n) override;
+
+    size_t memoria() const override;
+
+public:
+
+    // Constructor, con directorio vacío se usa TMPDIR o /tmp
+    explicit GOLMmap(const std::string &directorio = "");
+
+    ~GOLMmap() override;
+
+    std::string nombre() const override;
+
+    void leerVentana(int i0, int j0, int alto, int ancho, bool *destino) override;
+
+    long long poblacion() override;
+
+    // Ruta del archivo con la generación actual
+    std::string getArchivo() const;
+
+};
+
+#endif
+
+#ifdef GOL_OPENCL
+
+// Crea un motor OpenCL (opencl, opencl-if u opencl-multi), definido en engine_opencl.cpp
+GOLEngine *crearMotorOpenCL(const std::string &nombre);
+
+#endif
+
+#endif // GAMEOFLIFECPU_ENGINES_H
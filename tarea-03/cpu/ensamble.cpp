@@ -0,0 +1,156 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Ensambles de Monte Carlo con robo de trabajo entre hilos.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include "ensamble.h"
+#include "paralelo.h"
+
+// Cola de corridas de un hilo, el dueño toma del final y los demás roban del inicio
+struct ColaEnsamble {
+    std::mutex mutex;
+    std::deque<size_t> corridas;
+};
+
+/**
+ * Arma las corridas.
+ *
+ * @param tamanos Lados de los tableros
+ * @param densidades Densidades iniciales
+ * @param seed Primera semilla
+ * @param semillas Semillas por combinación
+ * @return Corridas sin series
+ */
+std::vector<CorridaEnsamble> armarEnsamble(const std::vector<int> &tamanos, const std::vector<int> &densidades,
+                                           unsigned long long seed, int semillas) {
+    std::vector<CorridaEnsamble> corridas;
+    for (int N : tamanos) {
+        for (int p : densidades) {
+            for (int s = 0; s < semillas; s++) {
+                corridas.push_back({N, p, seed + (unsigned long long) s, std::vector<long long>()});
+            }
+        }
+    }
+    return corridas;
+}
+
+/**
+ * Corre una corrida.
+ */
+static void correrUna(CorridaEnsamble &c, GOLEngine &motor, const OpcionesEnsamble &op) {
+    motor.inicializar(c.N, c.N, c.probTrue, c.seed, op.frontera);
+    c.serie.clear();
+    c.serie.push_back(motor.poblacion());
+    for (int g = 0; g < op.gens; g += op.cada) {
+        motor.avanzar(std::min(op.cada, op.gens - g));
+        c.serie.push_back(motor.poblacion());
+    }
+}
+
+/**
+ * Corre el ensamble.
+ *
+ * @param corridas Corridas
+ * @param opciones Configuración
+ * @return Corridas robadas
+ */
+long long correrEnsamble(std::vector<CorridaEnsamble> &corridas, const OpcionesEnsamble &opciones) {
+    OpcionesEnsamble op = opciones;
+    op.cada = std::max(1, op.cada);
+    op.gens = std::max(0, op.gens);
+    int hilos = op.nHilos < 1 ? hilosDisponibles() : op.nHilos;
+    hilos = std::max(1, std::min(hilos, (int) corridas.size()));
+
+    // Reparte por turnos de la más cara a la más barata, cada cola queda ordenada igual
+    std::vector<size_t> orden(corridas.size());
+    for (size_t k = 0; k < orden.size(); k++) orden[k] = k;
+    std::stable_sort(orden.begin(), orden.end(), [&corridas](size_t a, size_t b) {
+        return corridas[a].N > corridas[b].N;
+    });
+    std::vector<ColaEnsamble> colas((size_t) hilos);
+    for (size_t k = 0; k < orden.size(); k++) colas[k % hilos].corridas.push_front(orden[k]);
+
+    std::mutex mutexError;
+    std::exception_ptr error;
+    std::vector<long long> robadas((size_t) hilos, 0);
+    paraleloBandasIndice(0, hilos, hilos, [&](int t, int, int) {
+        std::map<int, std::unique_ptr<GOLEngine>> motores;
+        while (true) {
+            // Toma la corrida más cara de su cola o roba la más barata de otra
+            size_t k = corridas.size();
+            {
+                std::lock_guard<std::mutex> lock(colas[t].mutex);
+                if (!colas[t].corridas.empty()) {
+                    k = colas[t].corridas.back();
+                    colas[t].corridas.pop_back();
+                }
+            }
+            for (int v = 1; v < hilos && k == corridas.size(); v++) {
+                ColaEnsamble &otra = colas[(t + v) % hilos];
+                std::lock_guard<std::mutex> lock(otra.mutex);
+                if (!otra.corridas.empty()) {
+                    k = otra.corridas.front();
+                    otra.corridas.pop_front();
+                    robadas[t]++;
+                }
+            }
+            if (k == corridas.size()) return;
+
+            try {
+                CorridaEnsamble &c = corridas[k];
+                std::unique_ptr<GOLEngine> &motor = motores[c.N];
+                if (!motor) {
+                    std::string nombre = op.motor == "fijo" ? "fijo-" + std::to_string(c.N) : op.motor;
+                    motor.reset(crearMotor(nombre, 1));
+                }
+                correrUna(c, *motor, op);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutexError);
+                if (!error) error = std::current_exception();
+            }
+        }
+    });
+    if (error) std::rethrow_exception(error);
+
+    long long total = 0;
+    for (long long r : robadas) total += r;
+    return total;
+}
+
+/**
+ * Guarda las series en un CSV.
+ *
+ * @param archivo Ruta del archivo o "-"
+ * @param corridas Corridas
+ * @param cada Generaciones entre muestras
+ * @param gens Generaciones por corrida
+ */
+void guardarCSVEnsamble(const std::string &archivo, const std::vector<CorridaEnsamble> &corridas, int cada,
+                        int gens) {
+    FILE *f = archivo == "-" ? stdout : fopen(archivo.c_str(), "w");
+    if (!f) {
+        throw std::runtime_error("No se pudo abrir " + archivo);
+    }
+    cada = std::max(1, cada);
+    fprintf(f, "n,prob,semilla,generacion,poblacion\n");
+    for (const CorridaEnsamble &c : corridas) {
+        for (size_t k = 0; k < c.serie.size(); k++) {
+            long long generacion = std::min((long long) k * cada, (long long) gens);
+            fprintf(f, "%d,%d,%llu,%lld,%lld\n", c.N, c.probTrue, c.seed, generacion, c.serie[k]);
+        }
+    }
+    bool ok = !ferror(f);
+    if (f == stdout) fflush(f);
+    else if (fclose(f) != 0) ok = false;
+    if (!ok) {
+        throw std::runtime_error("No se pudo escribir " + archivo);
+    }
+}
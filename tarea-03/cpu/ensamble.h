@@ -0,0 +1,63 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Ensambles de Monte Carlo: muchas corridas independientes (tamaño x densidad x semilla) repartidas
+ * entre todos los núcleos con robo de trabajo, cada una guarda la serie de su población y los
+ * resultados se juntan en memoria en un solo CSV.
+ */
+
+#ifndef GAMEOFLIFECPU_ENSAMBLE_H
+#define GAMEOFLIFECPU_ENSAMBLE_H
+
+#include <string>
+#include <vector>
+#include "engine.h"
+
+// Corrida de un ensamble
+struct CorridaEnsamble {
+    int N;                          // Filas y columnas del tablero
+    int probTrue;                   // Densidad inicial
+    unsigned long long seed;        // Semilla
+    std::vector<long long> serie;   // Población en las generaciones 0, cada, 2 * cada, ..., gens
+};
+
+// Configuración de un ensamble
+struct OpcionesEnsamble {
+    int gens = 500;                         // Generaciones por corrida
+    int cada = 10;                          // Generaciones entre muestras de la población
+    std::string motor = "simd";             // Motor, "fijo" usa fijo-N si existe para el tamaño
+    Frontera frontera = FRONTERA_TOROIDAL;  // Condición de borde
+    int nHilos = 0;                         // Hilos, 0 usa todos los núcleos
+};
+
+/* Arma las corridas de todas las combinaciones, ordenadas por tamaño, densidad y semilla.
+ *
+ * @Param tamanos: Lados de los tableros.
+ * @Param densidades: Densidades iniciales (0 a 100).
+ * @Param seed: Primera semilla.
+ * @Param semillas: Semillas por combinación, seed, seed + 1, ...
+ */
+std::vector<CorridaEnsamble> armarEnsamble(const std::vector<int> &tamanos, const std::vector<int> &densidades,
+                                           unsigned long long seed, int semillas);
+
+/* Corre todas las corridas y llena sus series. Cada hilo parte con las corridas que le tocan en
+ * una cola propia (las más caras primero) y al vaciarla roba la corrida más barata de otro hilo.
+ * Cada hilo reutiliza un motor por tamaño. Lanza la primera excepción de un motor.
+ *
+ * @Param corridas: Corridas, se escriben sus series.
+ * @Param opciones: Configuración.
+ * @Return: Corridas robadas a otro hilo.
+ */
+long long correrEnsamble(std::vector<CorridaEnsamble> &corridas, const OpcionesEnsamble &opciones);
+
+/* Guarda las series en un CSV con columnas n,prob,semilla,generacion,poblacion. Lanza
+ * std::runtime_error si no se puede escribir.
+ *
+ * @Param archivo: Ruta del archivo, "-" escribe en la salida estándar.
+ * @Param corridas: Corridas ya corridas.
+ * @Param cada: Generaciones entre muestras.
+ * @Param gens: Generaciones por corrida.
+ */
+void guardarCSVEnsamble(const std::string &archivo, const std::vector<CorridaEnsamble> &corridas, int cada,
+                        int gens);
+
+#endif // GAMEOFLIFECPU_ENSAMBLE_H
@@ -0,0 +1,374 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Exportación de generaciones a PBM, PNG o cuadros de 1 bit.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <stdexcept>
+#include "exportador.h"
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+// Bytes máximos de un bloque deflate sin compresión
+#define BLOQUE_DEFLATE 65535
+
+/**
+ * CRC32 de PNG (polinomio 0xEDB88320), continúa desde crc.
+ */
+static uint32_t crc32(uint32_t crc, const uint8_t *datos, size_t n) {
+    static uint32_t tabla[256];
+    static bool lista = false;
+    if (!lista) {
+        for (uint32_t k = 0; k < 256; k++) {
+            uint32_t c = k;
+            for (int b = 0; b < 8; b++) c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            tabla[k] = c;
+        }
+        lista = true;
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < n; i++) crc = tabla[(crc ^ datos[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+/**
+ * Escribe un entero de 32 bits en big endian.
+ */
+static void escribirBE(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t) (v >> 24);
+    p[1] = (uint8_t) (v >> 16);
+    p[2] = (uint8_t) (v >> 8);
+    p[3] = (uint8_t) v;
+}
+
+/**
+ * Nombre del archivo de un cuadro. La ruta debe tener una sola conversión %lld o %d, con relleno
+ * de ceros y ancho opcionales (por ejemplo %06lld); se expande a mano para no usar la ruta como
+ * formato de printf.
+ *
+ * @param ruta Ruta con la conversión
+ * @param generacion Generación del cuadro
+ * @return Nombre, lanza std::invalid_argument si la ruta tiene otra conversión o más de una
+ */
+static std::string nombreCuadro(const std::string &ruta, long long generacion) {
+    size_t inicio = ruta.find('%'), k = inicio + 1;
+    bool ceros = k < ruta.size() && ruta[k] == '0';
+    if (ceros) k++;
+    size_t ancho = 0;
+    while (k < ruta.size() && isdigit((unsigned char) ruta[k]) && ancho < 100) ancho = ancho * 10 + (ruta[k++] - '0');
+    size_t largo = ruta.compare(k, 3, "lld") == 0 ? 3 : ruta.compare(k, 1, "d") == 0 ? 1 : 0;
+    if (inicio == std::string::npos || largo == 0 || ancho >= 100 || ruta.find('%', k) != std::string::npos) {
+        throw std::invalid_argument("La ruta debe tener una sola conversión %lld o %d: " + ruta);
+    }
+    std::string numero = std::to_string(generacion);
+    if (numero.size() < ancho) numero.insert(0, ancho - numero.size(), ceros ? '0' : ' ');
+    return ruta.substr(0, inicio) + numero + ruta.substr(k + largo);
+}
+
+/**
+ * Constructor.
+ *
+ * @param ruta Archivo, "-" o "|comando"
+ * @param formato Formato de los cuadros
+ * @param cada Exporta una de cada "cada" generaciones
+ * @param paso Exporta una de cada "paso" filas y columnas
+ */
+GOLExportador::GOLExportador(const std::string &ruta, FormatoExport formato, int cada, int paso) {
+    this->ruta = ruta;
+    this->formato = formato;
+    this->cada = std::max(1, cada);
+    this->paso = std::max(1, paso);
+    this->salida = nullptr;
+    this->esPipe = false;
+    this->anchoFila = 0;
+    this->cuadros = 0;
+
+    // Sin patrón se usa una sola salida para todos los cuadros. El patrón se valida al crear el
+    // exportador y no en el primer cuadro
+    this->porCuadro = ruta != "-" && (ruta.empty() || ruta[0] != '|') && ruta.find('%') != std::string::npos;
+    if (porCuadro) nombreCuadro(ruta, 0);
+    else abrir(0);
+}
+
+/**
+ * Destructor.
+ */
+GOLExportador::~GOLExportador() {
+    cerrar();
+}
+
+/**
+ * Abre la salida.
+ *
+ * @param generacion Generación, para las rutas con patrón
+ */
+void GOLExportador::abrir(long long generacion) {
+    if (ruta == "-") {
+        salida = stdout;
+        return;
+    }
+    if (!ruta.empty() && ruta[0] == '|') {
+#ifdef SIGPIPE
+        // Si el comando termina antes, fwrite falla con EPIPE en vez de matar el proceso
+        signal(SIGPIPE, SIG_IGN);
+#endif
+        salida = popen(ruta.c_str() + 1, "w");
+        esPipe = true;
+    } else if (porCuadro) {
+        salida = fopen(nombreCuadro(ruta, generacion).c_str(), "wb");
+    } else {
+        salida = fopen(ruta.c_str(), "wb");
+    }
+    if (!salida) {
+        throw std::runtime_error("No se pudo abrir " + ruta);
+    }
+}
+
+/**
+ * Cierra la salida.
+ *
+ * @return Falso si falló la escritura pendiente o el cierre
+ */
+bool GOLExportador::cerrar() {
+    if (!salida) return true;
+    bool ok;
+    if (salida == stdout) ok = fflush(stdout) == 0 && !ferror(stdout);
+    else if (esPipe) ok = pclose(salida) != -1;
+    else ok = fclose(salida) == 0;
+    salida = nullptr;
+    return ok;
+}
+
+/**
+ * Escribe n bytes en la salida, lanza std::runtime_error si no se escriben todos.
+ */
+void GOLExportador::escribirBytes(const void *datos, size_t n) {
+    if (fwrite(datos, 1, n, salida) != n) {
+        throw std::runtime_error("No se pudo escribir en " + ruta + ": " + strerror(errno));
+    }
+}
+
+/**
+ * Prepara el cuadro para un tablero NxM ya submuestreado.
+ *
+ * @return Bytes por fila, sin el byte de filtro de PNG
+ */
+int GOLExportador::preparar(int N, int M) {
+    int bytesFila = (M + 7) / 8;
+    size_t bytes = (size_t) N * (bytesFila + (formato == EXPORT_PNG ? 1 : 0));
+    if (cuadro.size() != bytes) cuadro.assign(bytes, 0);
+    return bytesFila;
+}
+
+/**
+ * Empaqueta una fila, el bit más significativo es la primera columna. En PBM y raw el 1 es la
+ * celda viva, en PNG se invierte porque el 0 es negro.
+ *
+ * @param celdas Fila del tablero
+ * @param M Columnas del tablero sin submuestrear
+ * @param k Fila del cuadro
+ * @param bytesFila Bytes por fila empaquetada
+ */
+void GOLExportador::empaquetarFila(const bool *celdas, int M, int k, int bytesFila) {
+    bool png = formato == EXPORT_PNG;
+    uint8_t *destino = cuadro.data() + (size_t) k * (bytesFila + (png ? 1 : 0));
+    if (png) *destino++ = 0; // Filtro None
+
+    int columnas = (M + paso - 1) / paso;
+    for (int b = 0; b < bytesFila; b++) {
+        int j0 = b * 8, j1 = std::min(columnas, j0 + 8);
+        uint8_t byte = 0;
+        if (paso == 1 && j1 - j0 == 8) {
+            const bool *c = celdas + j0;
+            byte = (uint8_t) (c[0] << 7 | c[1] << 6 | c[2] << 5 | c[3] << 4 | c[4] << 3 | c[5] << 2 | c[6] << 1 | c[7]);
+        } else {
+            for (int j = j0; j < j1; j++) byte |= (uint8_t) (celdas[(size_t) j * paso] << (7 - (j - j0)));
+        }
+
+        // Al invertir, los bits de relleno de la última columna quedan en blanco
+        if (png) byte = (uint8_t) ~byte;
+        destino[b] = byte;
+    }
+}
+
+/**
+ * Escribe el cuadro empaquetado, lanza std::runtime_error si la escritura falla (disco lleno,
+ * pipe cerrado).
+ */
+void GOLExportador::escribir(int N, int M, long long generacion) {
+    if (porCuadro) abrir(generacion);
+    try {
+        if (formato == EXPORT_PBM) {
+            char encabezado[32];
+            int largo = snprintf(encabezado, sizeof(encabezado), "P4\n%d %d\n", M, N);
+            escribirBytes(encabezado, (size_t) largo);
+            escribirBytes(cuadro.data(), cuadro.size());
+        } else if (formato == EXPORT_PNG) {
+            escribirPNG(N, M);
+        } else {
+            escribirBytes(cuadro.data(), cuadro.size());
+        }
+    } catch (const std::runtime_error &) {
+        if (porCuadro) cerrar();
+        throw;
+    }
+    bool ok = porCuadro ? cerrar() : fflush(salida) == 0 && !ferror(salida);
+    if (!ok) {
+        throw std::runtime_error("No se pudo escribir en " + ruta + ": " + strerror(errno));
+    }
+    cuadros++;
+}
+
+/**
+ * Escribe el cuadro como PNG en escala de grises de 1 bit. El flujo zlib usa bloques deflate
+ * sin compresión que apuntan directo a las filas empaquetadas, sin copiarlas.
+ */
+void GOLExportador::escribirPNG(int N, int M) {
+    static const uint8_t firma[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    escribirBytes(firma, 8);
+
+    // IHDR: ancho, alto, 1 bit, escala de grises, sin entrelazado
+    uint8_t ihdr[4 + 4 + 13 + 4];
+    escribirBE(ihdr, 13);
+    memcpy(ihdr + 4, "IHDR", 4);
+    escribirBE(ihdr + 8, (uint32_t) M);
+    escribirBE(ihdr + 12, (uint32_t) N);
+    ihdr[16] = 1;
+    ihdr[17] = 0;
+    ihdr[18] = 0;
+    ihdr[19] = 0;
+    ihdr[20] = 0;
+    escribirBE(ihdr + 21, crc32(0, ihdr + 4, 17));
+    escribirBytes(ihdr, sizeof(ihdr));
+
+    // IDAT: encabezado zlib, bloques sin compresión y Adler-32
+    size_t datos = cuadro.size();
+    size_t bloques = std::max((size_t) 1, (datos + BLOQUE_DEFLATE - 1) / BLOQUE_DEFLATE);
+    uint8_t cabeza[4 + 4 + 2];
+    escribirBE(cabeza, (uint32_t) (2 + 5 * bloques + datos + 4));
+    memcpy(cabeza + 4, "IDAT", 4);
+    cabeza[8] = 0x78;
+    cabeza[9] = 0x01;
+    escribirBytes(cabeza, sizeof(cabeza));
+    uint32_t crc = crc32(0, cabeza + 4, 6);
+
+    uint32_t a = 1, b = 0;
+    for (size_t k = 0; k < bloques; k++) {
+        size_t inicio = k * BLOQUE_DEFLATE, largo = std::min((size_t) BLOQUE_DEFLATE, datos - inicio);
+        uint8_t bloque[5] = {(uint8_t) (k + 1 == bloques ? 1 : 0), (uint8_t) largo, (uint8_t) (largo >> 8),
+                             (uint8_t) ~largo, (uint8_t) (~largo >> 8)};
+        escribirBytes(bloque, 5);
+        escribirBytes(cuadro.data() + inicio, largo);
+        crc = crc32(crc, bloque, 5);
+        crc = crc32(crc, cuadro.data() + inicio, largo);
+        for (size_t i = inicio; i < inicio + largo; i++) {
+            a = (a + cuadro[i]) % 65521;
+            b = (b + a) % 65521;
+        }
+    }
+    uint8_t cola[4 + 4];
+    escribirBE(cola, (b << 16) | a);
+    crc = crc32(crc, cola, 4);
+    escribirBE(cola + 4, crc);
+    escribirBytes(cola, sizeof(cola));
+
+    // IEND
+    static const uint8_t iend[12] = {0, 0, 0, 0, 'I', 'E', 'N', 'D', 0xAE, 0x42, 0x60, 0x82};
+    escribirBytes(iend, sizeof(iend));
+}
+
+/**
+ * Exporta un tablero si la generación corresponde.
+ *
+ * @param celdas Primera celda real
+ * @param N Número de filas
+ * @param M Número de columnas
+ * @param stride Celdas entre filas
+ * @param generacion Generación
+ * @return Verdadero si se escribió
+ */
+bool GOLExportador::exportar(const bool *celdas, int N, int M, size_t stride, long long generacion) {
+    if (generacion % cada != 0) return false;
+    int filas = (N + paso - 1) / paso, columnas = (M + paso - 1) / paso;
+    int bytesFila = preparar(filas, columnas);
+    for (int k = 0; k < filas; k++) {
+        empaquetarFila(celdas + (size_t) k * paso * stride, M, k, bytesFila);
+    }
+    escribir(filas, columnas, generacion);
+    return true;
+}
+
+/**
+ * Exporta el tablero de un motor, lee sólo las filas que se exportan.
+ *
+ * @param motor Motor
+ * @return Verdadero si se escribió
+ */
+bool GOLExportador::exportar(GOLEngine &motor) {
+    long long generacion = motor.getGeneracion();
+    if (generacion % cada != 0) return false;
+    int N = motor.getFilas(), M = motor.getColumnas();
+    if (anchoFila != M) {
+        fila.reset(new bool[M]);
+        anchoFila = M;
+    }
+    int filas = (N + paso - 1) / paso, columnas = (M + paso - 1) / paso;
+    int bytesFila = preparar(filas, columnas);
+    for (int k = 0; k < filas; k++) {
+        motor.leerVentana(k * paso, 0, 1, M, fila.get());
+        empaquetarFila(fila.get(), M, k, bytesFila);
+    }
+    escribir(filas, columnas, generacion);
+    return true;
+}
+
+/**
+ * Cuadros escritos.
+ */
+long long GOLExportador::getCuadros() const {
+    return cuadros;
+}
+
+/**
+ * Formato por nombre.
+ *
+ * @param nombre pbm, png o raw
+ */
+FormatoExport formatoExport(const std::string &nombre) {
+    if (nombre == "pbm") return EXPORT_PBM;
+    if (nombre == "png") return EXPORT_PNG;
+    if (nombre == "raw") return EXPORT_RAW;
+    throw std::invalid_argument("Formato desconocido: " + nombre);
+}
+
+/**
+ * Guarda un mapa de densidad como PGM binario.
+ *
+ * @param archivo Ruta del archivo
+ * @param valores Densidades de 0 a 255
+ * @param filas Filas del mapa
+ * @param columnas Columnas del mapa
+ */
+void guardarMapaDensidad(const std::string &archivo, const uint8_t *valores, int filas, int columnas) {
+    FILE *f = fopen(archivo.c_str(), "wb");
+    if (!f) {
+        throw std::runtime_error("No se pudo abrir " + archivo);
+    }
+    fprintf(f, "P5\n%d %d\n255\n", columnas, filas);
+    std::vector<uint8_t> fila((size_t) columnas);
+    bool ok = true;
+    for (int y = 0; y < filas && ok; y++) {
+        for (int x = 0; x < columnas; x++) fila[x] = (uint8_t) (255 - valores[(size_t) y * columnas + x]);
+        ok = fwrite(fila.data(), 1, fila.size(), f) == fila.size();
+    }
+    if (fclose(f) != 0 || !ok) {
+        throw std::runtime_error("No se pudo escribir " + archivo);
+    }
+}
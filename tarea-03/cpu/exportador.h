@@ -0,0 +1,119 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Exporta generaciones como PBM binario (P4), PNG mínimo o una secuencia de cuadros de 1 bit,
+ * empaquetando los bits directamente desde el tablero.
+ */
+
+#ifndef GAMEOFLIFECPU_EXPORTADOR_H
+#define GAMEOFLIFECPU_EXPORTADOR_H
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "engine.h"
+
+// Formato de los cuadros
+enum FormatoExport {
+    EXPORT_PBM,     // P4, una imagen tras otra, la celda viva es negra
+    EXPORT_PNG,     // Escala de grises de 1 bit sin comprimir, la celda viva es negra
+    EXPORT_RAW      // Sólo los bits, filas de (M + 7) / 8 bytes, bit más significativo primero
+};
+
+class GOLExportador {
+private:
+
+    // Salida: archivo, salida estándar ("-") o comando ("|comando")
+    std::string ruta;
+    FILE *salida;
+    bool esPipe;
+
+    // Se abre un archivo por cuadro, la ruta tiene una conversión %lld o %d
+    bool porCuadro;
+
+    // Formato, se exporta una de cada "cada" generaciones y una de cada "paso" celdas
+    FormatoExport formato;
+    int cada;
+    int paso;
+
+    // Cuadro empaquetado (con el byte de filtro de cada fila en PNG) y fila leída desde un
+    // motor, se reutilizan entre cuadros
+    std::vector<uint8_t> cuadro;
+    std::unique_ptr<bool[]> fila;
+    int anchoFila;
+    long long cuadros;
+
+    // Abre la salida, con porCuadro abre el archivo de la generación
+    void abrir(long long generacion);
+
+    // Cierra la salida, retorna falso si falló
+    bool cerrar();
+
+    // Escribe n bytes, lanza std::runtime_error si no se escriben todos
+    void escribirBytes(const void *datos, size_t n);
+
+    // Prepara el cuadro para un tablero NxM, retorna los bytes por fila empaquetada
+    int preparar(int N, int M);
+
+    // Empaqueta una fila del tablero en la fila k del cuadro
+    void empaquetarFila(const bool *celdas, int M, int k, int bytesFila);
+
+    // Escribe el cuadro empaquetado
+    void escribir(int N, int M, long long generacion);
+
+    // Escribe el cuadro como PNG, los datos van en bloques deflate sin compresión
+    void escribirPNG(int N, int M);
+
+public:
+
+    /* Constructor.
+     *
+     * @Param ruta: Archivo, "-" para la salida estándar o "|comando" para un pipe (SIGPIPE se
+     *              ignora, un comando que termina antes hace fallar exportar). Con %lld o %d
+     *              (se permite %06lld) en la ruta de un archivo se escribe un archivo por cuadro,
+     *              con la generación en el nombre. Lanza std::invalid_argument si la ruta tiene
+     *              otra conversión o más de una.
+     * @Param formato: Formato de los cuadros.
+     * @Param cada: Exporta una de cada "cada" generaciones.
+     * @Param paso: Exporta una de cada "paso" filas y columnas.
+     */
+    GOLExportador(const std::string &ruta, FormatoExport formato, int cada = 1, int paso = 1);
+
+    // Destructor, cierra la salida
+    virtual ~GOLExportador();
+
+    /* Exporta un tablero si la generación corresponde.
+     *
+     * @Param celdas: Primera celda real.
+     * @Param N: Número de filas.
+     * @Param M: Número de columnas.
+     * @Param stride: Celdas entre el inicio de dos filas.
+     * @Param generacion: Generación del tablero.
+     * @Return: Verdadero si se escribió el cuadro. Lanza std::runtime_error si la escritura
+     *          falla.
+     */
+    bool exportar(const bool *celdas, int N, int M, size_t stride, long long generacion);
+
+    // Exporta el tablero de un motor, leyendo una fila a la vez
+    bool exportar(GOLEngine &motor);
+
+    // Cuadros escritos
+    long long getCuadros() const;
+
+};
+
+// Formato por nombre (pbm, png o raw), lanza std::invalid_argument si no existe
+FormatoExport formatoExport(const std::string &nombre);
+
+/* Guarda un mapa de densidad (GOL::mapaDensidad) como PGM binario (P5). Igual que en los
+ * cuadros, las zonas vivas quedan oscuras. Lanza std::runtime_error si no se puede escribir.
+ *
+ * @Param archivo: Ruta del archivo.
+ * @Param valores: Densidades de 0 a 255, fila por fila.
+ * @Param filas: Filas del mapa.
+ * @Param columnas: Columnas del mapa.
+ */
+void guardarMapaDensidad(const std::string &archivo, const uint8_t *valores, int filas, int columnas);
+
+#endif // GAMEOFLIFECPU_EXPORTADOR_H
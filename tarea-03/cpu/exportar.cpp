@@ -0,0 +1,117 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Corre un motor y exporta sus generaciones como PBM, PNG o cuadros de 1 bit, por ejemplo para
+ * armar un video con ffmpeg sin pasar por texto.
+ *
+ * Uso: EXPORTAR [--motor nombre] [--n filas] [--m columnas] [--prob p] [--seed s]
+ *               [--gens generaciones] [--hilos h] [--frontera fija|toroidal]
+ *               [--formato pbm|png|raw] [--cada k] [--paso s] [--salida archivo|-|"|comando"]
+ *               [--checkpoint archivo [--cada-checkpoint k] [--reanudar]] [--diario archivo]
+ *
+ * Con --checkpoint se guarda el tablero cada k generaciones; con --reanudar la corrida continúa
+ * desde el checkpoint (si existe) hasta completar --gens generaciones en total. Con --diario se
+ * registran los cambios de cada generación (ver diario.h).
+ *
+ * Ejemplo: EXPORTAR --formato pbm --salida "|ffmpeg -f image2pipe -c:v pbm -i - GOL.mp4"
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "checkpoint.h"
+#include "diario.h"
+#include "engine.h"
+#include "exportador.h"
+
+// Opciones de la exportación
+struct OpcionesExportar {
+    std::string motor = "bits";
+    int N = 512;
+    int M = 512;
+    int probTrue = 30;
+    unsigned long long seed = 1998;
+    int gens = 100;
+    int hilos = 0;
+    Frontera frontera = FRONTERA_TOROIDAL;
+    std::string formato = "pbm";
+    int cada = 1;
+    int paso = 1;
+    std::string salida = "GOL.pbm";
+    std::string checkpoint;
+    int cadaCheckpoint = 1000;
+    bool reanudar = false;
+    std::string diario;
+};
+
+/**
+ * Lee las opciones de la línea de comandos.
+ */
+OpcionesExportar leerOpciones(int argc, char *argv[]) {
+    OpcionesExportar op;
+    for (int i = 1; i < argc; i++) {
+        bool valor = i + 1 < argc;
+        if (strcmp(argv[i], "--motor") == 0 && valor) op.motor = argv[++i];
+        else if (strcmp(argv[i], "--n") == 0 && valor) op.N = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--m") == 0 && valor) op.M = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--prob") == 0 && valor) op.probTrue = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && valor) op.seed = strtoull(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--gens") == 0 && valor) op.gens = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--hilos") == 0 && valor) op.hilos = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--frontera") == 0 && valor) {
+            op.frontera = strcmp(argv[++i], "fija") == 0 ? FRONTERA_FIJA : FRONTERA_TOROIDAL;
+        } else if (strcmp(argv[i], "--formato") == 0 && valor) op.formato = argv[++i];
+        else if (strcmp(argv[i], "--cada") == 0 && valor) op.cada = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--paso") == 0 && valor) op.paso = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--salida") == 0 && valor) op.salida = argv[++i];
+        else if (strcmp(argv[i], "--checkpoint") == 0 && valor) op.checkpoint = argv[++i];
+        else if (strcmp(argv[i], "--cada-checkpoint") == 0 && valor) op.cadaCheckpoint = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--reanudar") == 0) op.reanudar = true;
+        else if (strcmp(argv[i], "--diario") == 0 && valor) op.diario = argv[++i];
+        else {
+            fprintf(stderr, "Opción desconocida: %s\n", argv[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    return op;
+}
+
+/**
+ * Corre la exportación, los mensajes van a stderr para no mezclarse con la salida estándar.
+ */
+int main(int argc, char *argv[]) {
+    OpcionesExportar op = leerOpciones(argc, argv);
+    GOLEngine *motor = nullptr;
+    try {
+        GOLExportador exportador(op.salida, formatoExport(op.formato), op.cada, op.paso);
+        motor = crearMotor(op.motor, op.hilos);
+        FILE *existe = op.reanudar ? fopen(op.checkpoint.c_str(), "rb") : nullptr;
+        std::string regla = "B3/S23";
+        if (existe) {
+            fclose(existe);
+            InfoCheckpoint info = cargarCheckpoint(*motor, op.checkpoint);
+            regla = info.regla;
+            fprintf(stderr, "Reanudando desde la generación %lld (%s)\n", info.generacion, info.regla.c_str());
+        } else {
+            motor->inicializar(op.N, op.M, op.probTrue, op.seed, op.frontera);
+        }
+        std::unique_ptr<GOLDiario> diario(op.diario.empty() ? nullptr : new GOLDiario(op.diario));
+        exportador.exportar(*motor);
+        if (diario) diario->registrar(*motor);
+        while (motor->getGeneracion() < op.gens) {
+            if (op.checkpoint.empty()) motor->avanzar(1);
+            else avanzarConCheckpoints(*motor, 1, op.cadaCheckpoint, op.checkpoint, regla);
+            exportador.exportar(*motor);
+            if (diario) diario->registrar(*motor);
+        }
+        fprintf(stderr, "%lld cuadros exportados en %s\n", exportador.getCuadros(), op.salida.c_str());
+    } catch (const std::exception &e) {
+        fprintf(stderr, "%s\n", e.what());
+        delete motor;
+        return EXIT_FAILURE;
+    }
+    delete motor;
+    return 0;
+}
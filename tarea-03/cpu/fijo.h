@@ -0,0 +1,138 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Motor de tamaño fijo: las dimensiones son parámetros del template, así los recorridos, el
+ * stride y las matrices son constantes de compilación. Las matrices son miembros del objeto,
+ * por lo que un GOLFijo declarado como variable local vive completo en la pila. Se llama
+ * GOLFijo y no GOL<N, M> porque GOL ya es la clase del tablero dinámico.
+ */
+
+#ifndef GAMEOFLIFECPU_FIJO_H
+#define GAMEOFLIFECPU_FIJO_H
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "engine.h"
+#include "reglas.h"
+#include "rng.h"
+
+template<int FILAS, int COLUMNAS>
+class GOLFijo : public GOLEngine {
+    static_assert(FILAS > 0 && COLUMNAS > 0, "El tablero debe tener al menos una celda");
+
+protected:
+
+    // Bytes por fila, incluye las columnas fantasmas y el relleno que lee reglasFilaBytes
+    static constexpr int STRIDE = ((COLUMNAS + 10 + 7) / 8) * 8;
+    static constexpr size_t BYTES = (size_t) (FILAS + 2) * STRIDE;
+
+    // Matrices, incluyen las filas fantasmas
+    std::array<uint8_t, BYTES> bufferA;
+    std::array<uint8_t, BYTES> bufferB;
+    uint8_t *actual;
+    uint8_t *siguiente;
+
+    // Actualiza las celdas fantasmas de una matriz
+    void actualizarFantasmas(uint8_t *matriz) {
+        bool toroidal = frontera == FRONTERA_TOROIDAL;
+        for (int i = 1; i <= FILAS; i++) {
+            uint8_t *fila = matriz + i * STRIDE;
+            fila[0] = toroidal ? fila[COLUMNAS] : 0;
+            fila[COLUMNAS + 1] = toroidal ? fila[1] : 0;
+        }
+        if (toroidal) {
+            memcpy(matriz, matriz + FILAS * STRIDE, STRIDE);
+            memcpy(matriz + (FILAS + 1) * STRIDE, matriz + STRIDE, STRIDE);
+        } else {
+            memset(matriz, 0, STRIDE);
+            memset(matriz + (FILAS + 1) * STRIDE, 0, STRIDE);
+        }
+    }
+
+    void crearTablero(int probTrue, unsigned long long seed) override {
+        if (N != FILAS || M != COLUMNAS) {
+            throw std::invalid_argument("El motor " + nombre() + " sólo acepta tableros de " + std::to_string(FILAS) +
+                                        "x" + std::to_string(COLUMNAS));
+        }
+        bufferA.fill(0);
+        bufferB.fill(0);
+        actual = bufferA.data();
+        siguiente = bufferB.data();
+        if (probTrue > 0) {
+            for (int i = 0; i < FILAS; i++) {
+                for (int j = 0; j < COLUMNAS; j++) {
+                    actual[(i + 1) * STRIDE + j + 1] =
+                            celdaAleatoria(seed, (unsigned long long) i * COLUMNAS + j, probTrue) ? 1 : 0;
+                }
+            }
+        }
+        actualizarFantasmas(actual);
+    }
+
+    void escribirCorridas(const std::vector<Corrida> &corridas, bool invertir) override {
+        for (const Corrida &c : corridas) {
+            uint8_t *celda = actual + (c.i + 1) * STRIDE + c.j + 1;
+            if (!invertir) {
+                memset(celda, 1, (size_t) c.n);
+                continue;
+            }
+            for (int k = 0; k < c.n; k++) celda[k] ^= 1;
+        }
+        actualizarFantasmas(actual);
+    }
+
+    void avanzarGeneraciones(int n) override {
+        for (int g = 0; g < n; g++) {
+            for (int i = 1; i <= FILAS; i++) {
+                reglasFilaBytes(actual + (i - 1) * STRIDE, actual + i * STRIDE, actual + (i + 1) * STRIDE,
+                                siguiente + i * STRIDE, COLUMNAS);
+            }
+            actualizarFantasmas(siguiente);
+            std::swap(actual, siguiente);
+        }
+    }
+
+    size_t memoria() const override {
+        return 2 * BYTES;
+    }
+
+public:
+
+    GOLFijo() {
+        actual = bufferA.data();
+        siguiente = bufferB.data();
+    }
+
+    // Los punteros apuntan a las matrices propias, no se puede copiar
+    GOLFijo(const GOLFijo &) = delete;
+
+    GOLFijo &operator=(const GOLFijo &) = delete;
+
+    std::string nombre() const override {
+        return "fijo-" + std::to_string(FILAS) + (FILAS == COLUMNAS ? "" : "x" + std::to_string(COLUMNAS));
+    }
+
+    void leerVentana(int i0, int j0, int alto, int ancho, bool *destino) override {
+        for (int i = 0; i < alto; i++) {
+            const uint8_t *fila = actual + (i0 + i + 1) * STRIDE + j0 + 1;
+            for (int j = 0; j < ancho; j++) destino[i * ancho + j] = fila[j] != 0;
+        }
+    }
+
+    long long poblacion() override {
+        long long vivas = 0;
+        for (int i = 1; i <= FILAS; i++) {
+            for (int j = 1; j <= COLUMNAS; j++) vivas += actual[i * STRIDE + j];
+        }
+        return vivas;
+    }
+
+    const uint8_t *filaDirecta(int i) override {
+        return actual + (i + 1) * STRIDE + 1;
+    }
+
+};
+
+#endif // GAMEOFLIFECPU_FIJO_H
@@ -0,0 +1,74 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Imprime la población cada "cada" generaciones recorriendo el flujo de generaciones.h.
+ *
+ * Uso: FLUJO [--motor nombre] [--n filas] [--m columnas] [--prob p] [--seed s]
+ *            [--cada generaciones] [--veces v] [--hilos h] [--adelantar]
+ *
+ * Con --adelantar el motor avanza el siguiente paso mientras se cuenta la población.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "engine.h"
+#include "generaciones.h"
+
+// Opciones del flujo
+struct OpcionesFlujo {
+    std::string motor = "simd";
+    int N = 1024;
+    int M = 1024;
+    int probTrue = 30;
+    unsigned long long seed = 1998;
+    int cada = 10;
+    long long veces = 10;
+    int hilos = 0;
+    bool adelantar = false;
+};
+
+/**
+ * Lee las opciones de la línea de comandos.
+ */
+OpcionesFlujo leerOpciones(int argc, char *argv[]) {
+    OpcionesFlujo op;
+    for (int i = 1; i < argc; i++) {
+        bool valor = i + 1 < argc;
+        if (strcmp(argv[i], "--motor") == 0 && valor) op.motor = argv[++i];
+        else if (strcmp(argv[i], "--n") == 0 && valor) op.N = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--m") == 0 && valor) op.M = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--prob") == 0 && valor) op.probTrue = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && valor) op.seed = strtoull(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--cada") == 0 && valor) op.cada = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--veces") == 0 && valor) op.veces = atoll(argv[++i]);
+        else if (strcmp(argv[i], "--hilos") == 0 && valor) op.hilos = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--adelantar") == 0) op.adelantar = true;
+        else {
+            std::cout << "Opción desconocida: " << argv[i] << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (op.M == 1024 && op.N != 1024) op.M = op.N;
+    return op;
+}
+
+/**
+ * Recorre el flujo.
+ */
+int main(int argc, char *argv[]) {
+    OpcionesFlujo op = leerOpciones(argc, argv);
+    std::unique_ptr<GOLEngine> motor(crearMotor(op.motor, op.hilos));
+    motor->inicializar(op.N, op.M, op.probTrue, op.seed, FRONTERA_TOROIDAL);
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (const VistaTablero &vista : generaciones(*motor, op.cada, op.veces, op.adelantar)) {
+        printf("%lld %lld\n", vista.getGeneracion(), vista.poblacion());
+    }
+    double tiempo = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    fprintf(stderr, "%s: %.3f s en total, %.3f s avanzando\n", op.motor.c_str(), tiempo, motor->estadisticas().tiempo);
+    return 0;
+}
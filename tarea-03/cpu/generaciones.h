@@ -0,0 +1,205 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Flujo de generaciones con corrutinas de C++20:
+ *
+ *   for (const VistaTablero &vista : generaciones(motor, 10, 100)) { ... }
+ *
+ * entrega una vista de sólo lectura del tablero cada 10 generaciones, 100 veces. Si el motor
+ * guarda una celda por byte (filaDirecta) la vista lee sus filas sin copiarlas; si no, o si se
+ * adelanta el siguiente paso en otro hilo, la vista lee una copia del tablero.
+ * Requiere C++20, el resto de los motores compila con C++14.
+ */
+
+#ifndef GAMEOFLIFECPU_GENERACIONES_H
+#define GAMEOFLIFECPU_GENERACIONES_H
+
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "engine.h"
+
+/**
+ * Vista de sólo lectura de una generación, válida hasta que se pide la siguiente.
+ */
+class VistaTablero {
+private:
+
+    GOLEngine *motor;
+
+    // Copia del tablero de N * M bytes, nullptr si se leen las filas del motor
+    const uint8_t *copia;
+
+    long long generacion;
+    int N;
+    int M;
+
+public:
+
+    VistaTablero(GOLEngine &motor, const uint8_t *copia, long long generacion) {
+        this->motor = &motor;
+        this->copia = copia;
+        this->generacion = generacion;
+        this->N = motor.getFilas();
+        this->M = motor.getColumnas();
+    }
+
+    // Celdas de la fila i, un byte 0 o 1 por celda
+    const uint8_t *fila(int i) const {
+        return copia ? copia + (size_t) i * M : motor->filaDirecta(i);
+    }
+
+    // Retorna el valor de una celda
+    bool getCelda(int i, int j) const {
+        return fila(i)[j] != 0;
+    }
+
+    // Cuenta las celdas vivas
+    long long poblacion() const {
+        long long vivas = 0;
+        for (int i = 0; i < N; i++) {
+            const uint8_t *f = fila(i);
+            for (int j = 0; j < M; j++) vivas += f[j];
+        }
+        return vivas;
+    }
+
+    long long getGeneracion() const { return generacion; }
+
+    int getFilas() const { return N; }
+
+    int getColumnas() const { return M; }
+
+};
+
+/**
+ * Generador de vistas, se recorre una sola vez con un for de rango.
+ */
+class FlujoGeneraciones {
+public:
+
+    struct promise_type {
+        const VistaTablero *vista = nullptr;
+        std::exception_ptr error;
+
+        FlujoGeneraciones get_return_object() {
+            return FlujoGeneraciones(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        std::suspend_always yield_value(const VistaTablero &v) noexcept {
+            vista = &v;
+            return {};
+        }
+
+        void return_void() {}
+
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    class iterator {
+    private:
+
+        std::coroutine_handle<promise_type> corrutina;
+
+    public:
+
+        explicit iterator(std::coroutine_handle<promise_type> corrutina = nullptr) : corrutina(corrutina) {}
+
+        const VistaTablero &operator*() const { return *corrutina.promise().vista; }
+
+        const VistaTablero *operator->() const { return corrutina.promise().vista; }
+
+        iterator &operator++() {
+            reanudar(corrutina);
+            return *this;
+        }
+
+        bool operator==(const iterator &otro) const {
+            bool fin = !corrutina || corrutina.done(), finOtro = !otro.corrutina || otro.corrutina.done();
+            return fin && finOtro;
+        }
+
+        bool operator!=(const iterator &otro) const { return !(*this == otro); }
+    };
+
+    explicit FlujoGeneraciones(std::coroutine_handle<promise_type> corrutina) : corrutina(corrutina) {}
+
+    FlujoGeneraciones(FlujoGeneraciones &&otro) noexcept : corrutina(std::exchange(otro.corrutina, nullptr)) {}
+
+    FlujoGeneraciones(const FlujoGeneraciones &) = delete;
+
+    FlujoGeneraciones &operator=(const FlujoGeneraciones &) = delete;
+
+    // Destruir el flujo antes de terminar espera el paso adelantado, si lo hay
+    ~FlujoGeneraciones() {
+        if (corrutina) corrutina.destroy();
+    }
+
+    iterator begin() {
+        reanudar(corrutina);
+        return iterator(corrutina);
+    }
+
+    iterator end() { return iterator(); }
+
+private:
+
+    std::coroutine_handle<promise_type> corrutina;
+
+    // Avanza hasta la siguiente vista y relanza las excepciones del motor
+    static void reanudar(std::coroutine_handle<promise_type> corrutina) {
+        corrutina.resume();
+        if (corrutina.promise().error) std::rethrow_exception(corrutina.promise().error);
+    }
+
+};
+
+/**
+ * Copia el tablero del motor en copia, N * M bytes.
+ */
+inline void copiarVista(GOLEngine &motor, std::vector<uint8_t> &copia) {
+    int N = motor.getFilas(), M = motor.getColumnas();
+    copia.resize((size_t) N * M);
+    std::unique_ptr<bool[]> fila(new bool[M]);
+    for (int i = 0; i < N; i++) {
+        motor.leerVentana(i, 0, 1, M, fila.get());
+        for (int j = 0; j < M; j++) copia[(size_t) i * M + j] = fila[j];
+    }
+}
+
+/**
+ * Avanza el motor y entrega una vista cada "cada" generaciones. Con adelantar, mientras el
+ * consumidor procesa una vista otro hilo ya avanza el motor hasta la siguiente; la vista lee
+ * una copia y el consumidor no debe usar el motor durante el recorrido. Conviene cuando el
+ * motor no ocupa todos los núcleos (scalar, simd, bits, ...).
+ *
+ * @param motor Motor ya inicializado
+ * @param cada Generaciones entre vistas
+ * @param veces Cantidad de vistas, 0 no termina
+ * @param adelantar Avanza el siguiente paso en otro hilo
+ */
+inline FlujoGeneraciones generaciones(GOLEngine &motor, int cada, long long veces = 0, bool adelantar = false) {
+    std::vector<uint8_t> copia;
+    motor.avanzar(cada);
+    for (long long k = 0; veces == 0 || k < veces; k++) {
+        bool directa = !adelantar && motor.filaDirecta(0) != nullptr;
+        if (!directa) copiarVista(motor, copia);
+        VistaTablero vista(motor, directa ? nullptr : copia.data(), motor.getGeneracion());
+
+        // El paso siguiente sólo escribe en el motor, la vista lee la copia
+        std::future<void> siguiente;
+        bool quedan = veces == 0 || k + 1 < veces;
+        if (quedan && adelantar) siguiente = std::async(std::launch::async, [&motor, cada] { motor.avanzar(cada); });
+        co_yield vista;
+        if (siguiente.valid()) siguiente.get();
+        else if (quedan) motor.avanzar(cada);
+    }
+}
+
+#endif // GAMEOFLIFECPU_GENERACIONES_H
@@ -1,10 +1,12 @@
 #include <iostream>
 #include <ctime>
 #include "GOL.h"
+#include "visor.h"
 #include <fstream>
 
 #define T_LIMIT 1               // Tiempo límite de cálculo
 const bool imprimir = false;    // Imprime la matriz
+const bool visor = false;       // Muestra la matriz desde otro hilo sin detener la simulación
 
 /* Rutina Principal */
 int main() {
@@ -40,6 +42,10 @@ int main() {
     // Colocamos los valores iniciales
     game->inicializarBordesMatriz();
 
+    // Visor, dibuja el último tablero publicado cada 100ms
+    GOLVisor *pantalla = visor ? new GOLVisor(N, M) : nullptr;
+    long long generacion = 0;
+
     t0 = static_cast<int>(clock());
     while (time < T_LIMIT) {
         if (imprimir) { // Imprimimos de ser necesario
@@ -49,6 +55,13 @@ int main() {
 
         // Se aplican las reglas del juego
         game->aplicarReglas();
+        generacion++;
+
+        // Se publica el tablero sólo si el visor terminó con el anterior
+        if (pantalla && pantalla->quiereCuadro()) {
+            game->copiarTablero(pantalla->reservar());
+            pantalla->publicar(generacion);
+        }
 
         // Recalculamos valores
         Nevaluaciones += N * M;
@@ -60,6 +73,7 @@ int main() {
     std::cout << "Numero de operaciones efectuadas: " << Nevaluaciones << std::endl;
 
     // Elimina variables
+    delete pantalla;
     delete game;
     return 0;
 
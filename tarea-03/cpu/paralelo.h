@@ -0,0 +1,174 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Utilidades para dividir el trabajo en bandas de filas entre varios hilos.
+ */
+
+#ifndef GAMEOFLIFECPU_PARALELO_H
+#define GAMEOFLIFECPU_PARALELO_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * Retorna la cantidad de hilos por defecto, la cantidad de núcleos de la máquina.
+ */
+inline int hilosDisponibles() {
+    unsigned int n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : (int) n;
+}
+
+/**
+ * Núcleo asignado a cada banda, vacío si los hilos no se fijan. La banda t usa el núcleo
+ * t % size(), ver activarAfinidad en afinidad.h.
+ */
+inline std::vector<int> &nucleosBandas() {
+    static std::vector<int> nucleos;
+    return nucleos;
+}
+
+/**
+ * Fija el hilo actual a un núcleo, retorna falso si el sistema no lo permite.
+ *
+ * @param cpu Núcleo
+ */
+inline bool fijarHiloActual(int cpu) {
+#ifdef __linux__
+    cpu_set_t conjunto;
+    CPU_ZERO(&conjunto);
+    CPU_SET(cpu, &conjunto);
+    return pthread_setaffinity_np(pthread_self(), sizeof(conjunto), &conjunto) == 0;
+#else
+    (void) cpu;
+    return false;
+#endif
+}
+
+/**
+ * Guarda la afinidad del hilo actual y la restaura al destruirse, así el hilo que llama a
+ * paraleloBandasIndice no queda fijado al núcleo de su banda.
+ */
+class AfinidadGuardada {
+private:
+
+#ifdef __linux__
+    cpu_set_t conjunto;
+#endif
+    bool guardada;
+
+public:
+
+    // Constructor, sólo guarda la afinidad si guardar es verdadero
+    explicit AfinidadGuardada(bool guardar) : guardada(false) {
+#ifdef __linux__
+        if (guardar) guardada = pthread_getaffinity_np(pthread_self(), sizeof(conjunto), &conjunto) == 0;
+#else
+        (void) guardar;
+#endif
+    }
+
+    // Destructor, restaura la afinidad
+    ~AfinidadGuardada() {
+#ifdef __linux__
+        if (guardada) pthread_setaffinity_np(pthread_self(), sizeof(conjunto), &conjunto);
+#endif
+    }
+
+    AfinidadGuardada(const AfinidadGuardada &) = delete;
+
+    AfinidadGuardada &operator=(const AfinidadGuardada &) = delete;
+
+};
+
+/**
+ * Divide el rango [inicio, fin) en nHilos bandas contiguas y ejecuta f(t, a, b) para cada una en
+ * un hilo distinto, t es el índice de la banda. La última banda se ejecuta en el hilo que llama.
+ * Si hay núcleos asignados (nucleosBandas) cada hilo se fija al de su banda, incluido el que
+ * llama mientras ejecuta su banda.
+ *
+ * @param inicio Primera fila
+ * @param fin Fila final (no incluida)
+ * @param nHilos Cantidad de hilos, si es menor a 1 se usan todos los núcleos
+ * @param f Función a ejecutar por banda
+ */
+template<class F>
+void paraleloBandasIndice(int inicio, int fin, int nHilos, F f) {
+    if (nHilos < 1) nHilos = hilosDisponibles();
+    int total = fin - inicio;
+    if (total <= 0) return;
+    if (nHilos > total) nHilos = total;
+
+    // Copia de la asignación, se lee desde cada hilo
+    std::vector<int> nucleos = nucleosBandas();
+    auto banda = [&f, &nucleos](int t, int a, int b) {
+        if (!nucleos.empty()) fijarHiloActual(nucleos[t % nucleos.size()]);
+        f(t, a, b);
+    };
+
+    std::vector<std::thread> hilos;
+    for (int t = 0; t < nHilos - 1; t++) {
+        int a = inicio + (int) ((long long) total * t / nHilos);
+        int b = inicio + (int) ((long long) total * (t + 1) / nHilos);
+        hilos.emplace_back(banda, t, a, b);
+    }
+    {
+        AfinidadGuardada afinidad(!nucleos.empty());
+        banda(nHilos - 1, inicio + (int) ((long long) total * (nHilos - 1) / nHilos), fin);
+    }
+    for (auto &h : hilos) h.join();
+}
+
+/**
+ * Divide el rango [inicio, fin) en nHilos bandas contiguas y ejecuta f(a, b) para cada una en
+ * un hilo distinto. La última banda se ejecuta en el hilo que llama.
+ *
+ * @param inicio Primera fila
+ * @param fin Fila final (no incluida)
+ * @param nHilos Cantidad de hilos, si es menor a 1 se usan todos los núcleos
+ * @param f Función a ejecutar por banda
+ */
+template<class F>
+void paraleloBandas(int inicio, int fin, int nHilos, F f) {
+    paraleloBandasIndice(inicio, fin, nHilos, [&f](int, int a, int b) { f(a, b); });
+}
+
+/**
+ * Barrera reutilizable para una cantidad fija de hilos.
+ */
+class Barrera {
+private:
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    int total;
+    int esperando;
+    unsigned long long fase;
+
+public:
+
+    // Constructor, n es la cantidad de hilos que deben llegar
+    explicit Barrera(int n) : total(n), esperando(0), fase(0) {
+    }
+
+    // Espera a que lleguen todos los hilos
+    void esperar() {
+        std::unique_lock<std::mutex> lock(mutex);
+        unsigned long long miFase = fase;
+        if (++esperando == total) {
+            esperando = 0;
+            fase++;
+            cv.notify_all();
+        } else {
+            cv.wait(lock, [this, miFase] { return fase != miFase; });
+        }
+    }
+
+};
+
+#endif // GAMEOFLIFECPU_PARALELO_H
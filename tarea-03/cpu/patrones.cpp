@@ -0,0 +1,381 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Carga y guarda patrones RLE, plaintext y Life 1.06.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include "patrones.h"
+
+// Bytes que se leen del archivo por bloque
+#define BLOQUE_LECTURA 65536
+
+// Largo máximo de una línea de datos RLE al guardar
+#define LARGO_LINEA_RLE 70
+
+// Coordenada máxima de un patrón, mucho más allá de cualquier tablero. Las coordenadas se saturan
+// en este valor para que un archivo dañado no desborde los enteros
+#define LIMITE_PATRON (1LL << 40)
+
+/**
+ * Lee un archivo por bloques, un carácter a la vez.
+ */
+class LectorPatron {
+private:
+
+    FILE *archivo;
+    char buffer[BLOQUE_LECTURA];
+    size_t pos;
+    size_t largo;
+
+    // Lee el siguiente bloque, retorna falso al terminar el archivo
+    bool llenar() {
+        largo = fread(buffer, 1, BLOQUE_LECTURA, archivo);
+        pos = 0;
+        return largo > 0;
+    }
+
+public:
+
+    explicit LectorPatron(FILE *archivo) : archivo(archivo), pos(0), largo(0) {
+    }
+
+    // Retorna el siguiente carácter sin consumirlo, EOF al terminar
+    int ver() {
+        if (pos == largo && !llenar()) return EOF;
+        return (unsigned char) buffer[pos];
+    }
+
+    // Retorna y consume el siguiente carácter, EOF al terminar
+    int siguiente() {
+        if (pos == largo && !llenar()) return EOF;
+        return (unsigned char) buffer[pos++];
+    }
+
+    // Lee hasta el fin de línea, sin incluir "\r\n", retorna falso al terminar el archivo
+    bool leerLinea(std::string &linea) {
+        linea.clear();
+        int c = siguiente();
+        if (c == EOF) return false;
+        while (c != EOF && c != '\n') {
+            if (c != '\r') linea.push_back((char) c);
+            c = siguiente();
+        }
+        return true;
+    }
+
+    // Primeros bytes del archivo para detectar el formato, sin consumirlos
+    std::string inicio() {
+        ver();
+        return std::string(buffer + pos, std::min(largo - pos, (size_t) 64));
+    }
+
+};
+
+/**
+ * Satura una coordenada a [-LIMITE_PATRON, LIMITE_PATRON].
+ */
+static inline long long saturar(long long v) {
+    return std::max(-LIMITE_PATRON, std::min(v, LIMITE_PATRON));
+}
+
+/**
+ * Satura un alto o ancho a un int.
+ */
+static inline int medida(long long v) {
+    return (int) std::max(0LL, std::min(v, (long long) INT_MAX));
+}
+
+/**
+ * Escribe una fila de n celdas y lleva la cuenta de las vivas y de las que quedan fuera. Sólo se
+ * pasa a setCeldas la parte dentro del tablero, así las coordenadas caben en un int.
+ */
+static void escribirCeldas(GOL &game, InfoPatron &info, long long i, long long j, long long n, bool valor) {
+    if (n <= 0) return;
+    long long dentro = 0, a = std::max(j, 0LL);
+    if (i >= 0 && i < game.getFilas()) dentro = std::max(0LL, std::min(j + n, (long long) game.getColumnas()) - a);
+    if (dentro > 0) game.setCeldas((int) i, (int) a, (int) dentro, valor);
+    if (!valor) return;
+    info.vivas += n;
+    info.fuera += n - dentro;
+}
+
+// Clasificación de caracteres sin depender del locale
+static inline bool esDigito(int c) {
+    return c >= '0' && c <= '9';
+}
+
+static inline bool esEspacio(int c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+static inline bool esLetra(int c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+/**
+ * Quita los espacios al inicio y al final.
+ */
+static std::string recortar(const std::string &s) {
+    size_t a = s.find_first_not_of(" \t"), b = s.find_last_not_of(" \t");
+    return a == std::string::npos ? "" : s.substr(a, b - a + 1);
+}
+
+/**
+ * Detecta el formato por la extensión y luego por el contenido.
+ */
+static FormatoPatron detectarFormato(const std::string &archivo, const std::string &inicio) {
+    std::string ext = archivo.substr(archivo.find_last_of('.') == std::string::npos ? archivo.size() :
+                                     archivo.find_last_of('.'));
+    for (char &c : ext) c = (char) tolower(c);
+    if (inicio.compare(0, 10, "#Life 1.06") == 0) return PATRON_LIFE106;
+    if (ext == ".rle") return PATRON_RLE;
+    if (ext == ".cells") return PATRON_CELLS;
+    if (ext == ".lif" || ext == ".life") return PATRON_LIFE106;
+    if (!inicio.empty() && (inicio[0] == '!' || inicio[0] == '.' || inicio[0] == 'O')) return PATRON_CELLS;
+    return PATRON_RLE;
+}
+
+/**
+ * Lee la cabecera "x = m, y = n, rule = ..." de un RLE.
+ */
+static void leerCabeceraRLE(const std::string &linea, InfoPatron &info) {
+    size_t inicio = 0;
+    while (inicio <= linea.size()) {
+        size_t fin = linea.find(',', inicio);
+        if (fin == std::string::npos) fin = linea.size();
+        std::string par = linea.substr(inicio, fin - inicio);
+        size_t igual = par.find('=');
+        if (igual != std::string::npos) {
+            std::string clave = recortar(par.substr(0, igual)), valor = recortar(par.substr(igual + 1));
+            if (clave == "x") info.columnas = medida(strtoll(valor.c_str(), nullptr, 10));
+            else if (clave == "y") info.filas = medida(strtoll(valor.c_str(), nullptr, 10));
+            else if (clave == "rule") info.regla = valor;
+        }
+        inicio = fin + 1;
+    }
+}
+
+/**
+ * Carga un RLE: comentarios "#", la cabecera y luego corridas [n]b, [n]o y [n]$ hasta '!'.
+ * Cualquier letra distinta de 'b' se toma como viva (patrones de varios estados).
+ */
+static void cargarRLE(GOL &game, LectorPatron &lector, int i0, int j0, InfoPatron &info) {
+    std::string linea;
+    while (lector.ver() == '#' || lector.ver() == 'x' || esEspacio(lector.ver())) {
+        int c = lector.ver();
+        if (esEspacio(c)) {
+            lector.siguiente();
+            continue;
+        }
+        lector.leerLinea(linea);
+        if (c == 'x') {
+            leerCabeceraRLE(linea, info);
+            break;
+        }
+    }
+
+    long long i = 0, j = 0, ancho = 0, cuenta = 0;
+    int c;
+    while ((c = lector.siguiente()) != EOF && c != '!') {
+        if (esDigito(c)) {
+            cuenta = cuenta * 10 + (c - '0');
+            if (cuenta > INT_MAX) throw std::runtime_error("Corrida demasiado larga en el RLE");
+            continue;
+        }
+        if (esEspacio(c)) continue;
+        long long n = cuenta > 0 ? cuenta : 1;
+        cuenta = 0;
+        if (c == '$') {
+            i = saturar(i + n);
+            j = 0;
+        } else if (c == 'b' || c == '.') {
+            escribirCeldas(game, info, (long long) i0 + i, (long long) j0 + j, n, false);
+            j = saturar(j + n);
+        } else if (esLetra(c) || c == '*') {
+            escribirCeldas(game, info, (long long) i0 + i, (long long) j0 + j, n, true);
+            j = saturar(j + n);
+            ancho = std::max(ancho, j);
+        }
+    }
+    if (info.filas == 0) info.filas = medida(i + (j > 0 ? 1 : 0));
+    if (info.columnas == 0) info.columnas = medida(ancho);
+}
+
+/**
+ * Carga un patrón plaintext, las corridas de un mismo estado se escriben juntas.
+ */
+static void cargarCells(GOL &game, LectorPatron &lector, int i0, int j0, InfoPatron &info) {
+    long long i = 0, j = 0, inicioCorrida = 0;
+    bool valorCorrida = false, inicioLinea = true, comentario = false;
+    int c;
+    while ((c = lector.siguiente()) != EOF) {
+        if (inicioLinea && c == '!') comentario = true;
+        inicioLinea = false;
+        if (c == '\n') {
+            if (!comentario) {
+                escribirCeldas(game, info, i0 + i, j0 + inicioCorrida, j - inicioCorrida, valorCorrida);
+                info.columnas = std::max(info.columnas, medida(j));
+                i++;
+            }
+            j = inicioCorrida = 0;
+            inicioLinea = true;
+            comentario = false;
+            continue;
+        }
+        if (comentario || c == '\r') continue;
+        bool valor = c != '.' && !esEspacio(c);
+        if (valor != valorCorrida) {
+            escribirCeldas(game, info, i0 + i, j0 + inicioCorrida, j - inicioCorrida, valorCorrida);
+            inicioCorrida = j;
+            valorCorrida = valor;
+        }
+        j++;
+    }
+    if (!comentario && j > 0) {
+        escribirCeldas(game, info, i0 + i, j0 + inicioCorrida, j - inicioCorrida, valorCorrida);
+        info.columnas = std::max(info.columnas, medida(j));
+        i++;
+    }
+    info.filas = medida(i);
+}
+
+/**
+ * Carga un patrón Life 1.06, un par "x y" por celda viva relativo a (i0, j0).
+ */
+static void cargarLife106(GOL &game, LectorPatron &lector, int i0, int j0, InfoPatron &info) {
+    std::string linea;
+    long long minX = LIMITE_PATRON, maxX = -LIMITE_PATRON, minY = LIMITE_PATRON, maxY = -LIMITE_PATRON;
+    while (lector.leerLinea(linea)) {
+        if (linea.empty() || linea[0] == '#') continue;
+        char *fin;
+        long long x = saturar(strtoll(linea.c_str(), &fin, 10));
+        char *finY;
+        long long y = saturar(strtoll(fin, &finY, 10));
+        if (fin == linea.c_str() || finY == fin) {
+            throw std::runtime_error("Línea inválida en Life 1.06: " + linea);
+        }
+        escribirCeldas(game, info, i0 + y, j0 + x, 1, true);
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+    }
+    if (info.vivas > 0) {
+        info.filas = medida(maxY - minY + 1);
+        info.columnas = medida(maxX - minX + 1);
+    }
+}
+
+/**
+ * Carga un patrón en el tablero.
+ *
+ * @param game Tablero
+ * @param archivo Ruta del patrón
+ * @param i0 Fila de la esquina superior izquierda
+ * @param j0 Columna de la esquina superior izquierda
+ * @param formato Formato
+ * @return Datos del patrón
+ */
+InfoPatron cargarPatron(GOL &game, const std::string &archivo, int i0, int j0, FormatoPatron formato) {
+    FILE *f = fopen(archivo.c_str(), "rb");
+    if (!f) {
+        throw std::runtime_error("No se pudo abrir el patrón " + archivo);
+    }
+
+    LectorPatron lector(f);
+    InfoPatron info;
+    info.formato = formato == PATRON_AUTO ? detectarFormato(archivo, lector.inicio()) : formato;
+    info.filas = 0;
+    info.columnas = 0;
+    info.regla = "B3/S23";
+    info.vivas = 0;
+    info.fuera = 0;
+
+    try {
+        if (info.formato == PATRON_RLE) cargarRLE(game, lector, i0, j0, info);
+        else if (info.formato == PATRON_CELLS) cargarCells(game, lector, i0, j0, info);
+        else cargarLife106(game, lector, i0, j0, info);
+    } catch (...) {
+        fclose(f);
+        throw;
+    }
+    bool error = ferror(f) != 0;
+    fclose(f);
+    if (error) {
+        throw std::runtime_error("Error al leer el patrón " + archivo);
+    }
+    return info;
+}
+
+/**
+ * Agrega una corrida "[n]tag" a la línea RLE, cortando la línea antes de pasar el largo máximo.
+ */
+static void agregarCorrida(FILE *f, int &largoLinea, int n, char tag) {
+    char texto[16];
+    int largo = 0;
+    if (n > 1) {
+        char digitos[12];
+        int d = 0;
+        for (; n > 0; n /= 10) digitos[d++] = (char) ('0' + n % 10);
+        while (d > 0) texto[largo++] = digitos[--d];
+    }
+    texto[largo++] = tag;
+    if (largoLinea + largo > LARGO_LINEA_RLE) {
+        fputc('\n', f);
+        largoLinea = 0;
+    }
+    fwrite(texto, 1, (size_t) largo, f);
+    largoLinea += largo;
+}
+
+/**
+ * Guarda el tablero como RLE. Las muertas al final de cada fila y las filas vacías al final se
+ * omiten, las filas vacías intermedias se juntan en un solo "n$".
+ *
+ * @param game Tablero
+ * @param archivo Ruta del archivo
+ * @param regla Regla de la cabecera
+ */
+void guardarRLE(const GOL &game, const std::string &archivo, const std::string &regla) {
+    FILE *f = fopen(archivo.c_str(), "wb");
+    if (!f) {
+        throw std::runtime_error("No se pudo crear " + archivo);
+    }
+    int N = game.getFilas(), M = game.getColumnas();
+    fprintf(f, "x = %d, y = %d, rule = %s\n", M, N, regla.c_str());
+
+    int largoLinea = 0, saltos = 0;
+    for (int i = 0; i < N; i++) {
+        const bool *fila = game.getFila(i);
+        int j = 0;
+        bool primera = true;
+        while (j < M) {
+            bool valor = fila[j];
+            int k = j + 1;
+            while (k < M && fila[k] == valor) k++;
+            if (!valor && k == M) break;
+
+            // Los saltos de las filas anteriores se escriben recién cuando hay una celda viva
+            if (primera && saltos > 0) {
+                agregarCorrida(f, largoLinea, saltos, '$');
+                saltos = 0;
+            }
+            primera = false;
+            agregarCorrida(f, largoLinea, k - j, valor ? 'o' : 'b');
+            j = k;
+        }
+        saltos++;
+    }
+    agregarCorrida(f, largoLinea, 1, '!');
+    fputc('\n', f);
+    bool error = ferror(f) != 0;
+    if (fclose(f) != 0 || error) {
+        throw std::runtime_error("Error al escribir " + archivo);
+    }
+}
@@ -0,0 +1,54 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Carga patrones RLE, plaintext (.cells) y Life 1.06 en cualquier posición del tablero, y guarda
+ * el tablero como RLE. El archivo se lee por bloques y cada celda se escribe directo en la
+ * matriz, sin armar el patrón en memoria.
+ */
+
+#ifndef GAMEOFLIFECPU_PATRONES_H
+#define GAMEOFLIFECPU_PATRONES_H
+
+#include <string>
+#include "GOL.h"
+
+// Formato de un patrón
+enum FormatoPatron {
+    PATRON_AUTO,    // Según el contenido y la extensión
+    PATRON_RLE,     // Run Length Encoded, "x = m, y = n, rule = B3/S23" y luego "bo$2o!"
+    PATRON_CELLS,   // Plaintext, una fila por línea con '.' muerta y 'O' viva, '!' comenta
+    PATRON_LIFE106  // "#Life 1.06" y luego un par "x y" por celda viva
+};
+
+// Datos de un patrón cargado
+struct InfoPatron {
+    FormatoPatron formato;  // Formato detectado
+    int filas;              // Alto del patrón (de la cabecera en RLE, si no de las celdas)
+    int columnas;           // Ancho del patrón
+    std::string regla;      // Regla de la cabecera RLE, "B3/S23" si no tiene
+    long long vivas;        // Celdas vivas leídas
+    long long fuera;        // Celdas vivas que quedaron fuera del tablero
+};
+
+/* Carga un patrón en el tablero. Sólo se escriben las celdas que indica el archivo (vivas y, en
+ * RLE y .cells, las muertas explícitas); para partir de un tablero vacío llamar antes a
+ * setMatrizToFalse. Las celdas fuera del tablero se descartan. Lanza std::runtime_error si no se
+ * puede abrir o leer el archivo.
+ *
+ * @Param game: Tablero.
+ * @Param archivo: Ruta del patrón.
+ * @Param i0: Fila donde queda la esquina superior izquierda del patrón.
+ * @Param j0: Columna donde queda la esquina superior izquierda del patrón.
+ * @Param formato: Formato, PATRON_AUTO lo detecta.
+ */
+InfoPatron cargarPatron(GOL &game, const std::string &archivo, int i0 = 0, int j0 = 0,
+                        FormatoPatron formato = PATRON_AUTO);
+
+/* Guarda el tablero completo como RLE, con líneas de a lo más 70 caracteres.
+ *
+ * @Param game: Tablero.
+ * @Param archivo: Ruta del archivo.
+ * @Param regla: Regla que se escribe en la cabecera.
+ */
+void guardarRLE(const GOL &game, const std::string &archivo, const std::string &regla = "B3/S23");
+
+#endif // GAMEOFLIFECPU_PATRONES_H
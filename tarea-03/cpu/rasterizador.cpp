@@ -0,0 +1,148 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Rasterizado de polígonos por líneas de barrido.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "paralelo.h"
+#include "rasterizador.h"
+
+// Arista no horizontal ordenada de abajo hacia arriba, dir es +1 si la original sube
+struct AristaBarrido {
+    double xl, yl, xu, yu;
+    int dir;
+};
+
+// Cruce de una línea de barrido con una arista
+struct Cruce {
+    double x;
+    int dir;
+
+    bool operator<(const Cruce &otro) const { return x < otro.x; }
+};
+
+/**
+ * Escala, rota y traslada.
+ *
+ * @param escala Celdas por unidad
+ * @param angulo Rotación en radianes
+ * @param columna Columna del origen
+ * @param fila Fila del origen
+ */
+Transformacion Transformacion::similitud(double escala, double angulo, double columna, double fila) {
+    Transformacion t;
+    double cs = escala * cos(angulo), sn = escala * sin(angulo);
+    t.a = cs;
+    t.b = -sn;
+    t.e = columna;
+    t.c = sn;
+    t.d = cs;
+    t.f = fila;
+    return t;
+}
+
+/**
+ * Rellena una fila con los cruces ya ordenados.
+ *
+ * @param fila Celdas reales de la fila
+ * @param M Número de columnas
+ * @param cruces Cruces ordenados por x
+ * @param regla Regla de relleno
+ * @param valor Estado de las celdas de dentro
+ * @return Celdas escritas
+ */
+static long long rellenarFila(bool *fila, int M, const std::vector<Cruce> &cruces, ReglaRelleno regla,
+                              bool valor) {
+    long long escritas = 0;
+    int vueltas = 0;
+    double inicio = 0;
+    for (size_t k = 0; k < cruces.size(); k++) {
+        bool dentro = regla == RELLENO_PAR_IMPAR ? k % 2 == 1 : vueltas != 0;
+        vueltas += cruces[k].dir;
+        bool ahora = regla == RELLENO_PAR_IMPAR ? k % 2 == 0 : vueltas != 0;
+        if (!dentro && ahora) inicio = cruces[k].x;
+        if (!dentro || ahora) continue;
+
+        // Celdas con centro j + 0.5 en [inicio, x)
+        double j0 = std::max(0.0, std::ceil(inicio - 0.5)), j1 = std::min((double) M, std::ceil(cruces[k].x - 0.5));
+        if (j1 > j0) {
+            memset(fila + (int) j0, valor, (size_t) (j1 - j0));
+            escritas += (long long) (j1 - j0);
+        }
+    }
+    return escritas;
+}
+
+/**
+ * Rellena las celdas dentro de las aristas. Las aristas se ordenan por su fila inferior; cada
+ * banda de filas arma su lista de aristas activas al inicio, la actualiza fila a fila y escribe
+ * sus filas directo en el tablero.
+ *
+ * @param game Tablero
+ * @param aristas Aristas en coordenadas del tablero
+ * @param regla Regla de relleno
+ * @param valor Estado de las celdas de dentro
+ * @param nHilos Cantidad de hilos
+ * @return Celdas escritas
+ */
+long long rasterizarAristas(GOL &game, const std::vector<AristaRaster> &aristas, ReglaRelleno regla, bool valor,
+                            int nHilos) {
+    std::vector<AristaBarrido> orden;
+    orden.reserve(aristas.size());
+    double yMin = INFINITY, yMax = -INFINITY;
+    for (const AristaRaster &a : aristas) {
+        if (a.y0 == a.y1 || !std::isfinite(a.x0 + a.y0 + a.x1 + a.y1)) continue;
+        if (a.y0 < a.y1) orden.push_back({a.x0, a.y0, a.x1, a.y1, 1});
+        else orden.push_back({a.x1, a.y1, a.x0, a.y0, -1});
+        yMin = std::min(yMin, orden.back().yl);
+        yMax = std::max(yMax, orden.back().yu);
+    }
+    if (orden.empty()) return 0;
+    std::sort(orden.begin(), orden.end(), [](const AristaBarrido &p, const AristaBarrido &q) { return p.yl < q.yl; });
+
+    // Filas cuyo centro puede quedar en [yMin, yMax), acotadas como double antes de pasar a int
+    double filas = game.getFilas();
+    int i0 = (int) std::min(filas, std::max(0.0, std::ceil(yMin - 0.5)));
+    int i1 = (int) std::max(0.0, std::min(filas, std::ceil(yMax - 0.5)));
+    if (i0 >= i1) return 0;
+
+    bool *celdas = game.editarTablero();
+    size_t stride = (size_t) game.getColumnas() + 2;
+    int hilos = nHilos < 1 ? hilosDisponibles() : nHilos;
+    hilos = std::max(1, std::min(hilos, i1 - i0));
+    std::vector<long long> escritas((size_t) hilos, 0);
+    paraleloBandasIndice(i0, i1, hilos, [&](int t, int a, int b) {
+        std::vector<int> activas;
+        std::vector<Cruce> cruces;
+
+        // Aristas que empiezan antes de la primera fila de la banda
+        double yc = a + 0.5;
+        size_t siguiente = 0;
+        while (siguiente < orden.size() && orden[siguiente].yl <= yc) {
+            if (orden[siguiente].yu > yc) activas.push_back((int) siguiente);
+            siguiente++;
+        }
+        for (int i = a; i < b; i++) {
+            yc = i + 0.5;
+            while (siguiente < orden.size() && orden[siguiente].yl <= yc) activas.push_back((int) siguiente++);
+
+            cruces.clear();
+            size_t quedan = 0;
+            for (int k : activas) {
+                const AristaBarrido &e = orden[k];
+                if (e.yu <= yc) continue;
+                activas[quedan++] = k;
+                cruces.push_back({(e.xu - e.xl) * (yc - e.yl) / (e.yu - e.yl) + e.xl, e.dir});
+            }
+            activas.resize(quedan);
+            std::sort(cruces.begin(), cruces.end());
+            escritas[t] += rellenarFila(celdas + i * stride, game.getColumnas(), cruces, regla, valor);
+        }
+    });
+
+    long long total = 0;
+    for (long long e : escritas) total += e;
+    return total;
+}
@@ -0,0 +1,80 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Rasterizado por líneas de barrido de polígonos (Polygon<T> de tarea-01) en un tablero GOL,
+ * con regla par-impar o distinto de cero. Las filas se reparten entre varios hilos.
+ */
+
+#ifndef GAMEOFLIFECPU_RASTERIZADOR_H
+#define GAMEOFLIFECPU_RASTERIZADOR_H
+
+#include <vector>
+#include "GOL.h"
+#include "elements/polygon.h"
+
+// Regla de relleno
+enum ReglaRelleno {
+    RELLENO_PAR_IMPAR,  // Dentro si una semirrecta cruza un número impar de aristas
+    RELLENO_NO_CERO     // Dentro si el número de vueltas es distinto de cero
+};
+
+// Transformación afín de coordenadas del polígono (x, y) a coordenadas del tablero
+struct Transformacion {
+    double a = 1, b = 0, e = 0; // columna = a * x + b * y + e
+    double c = 0, d = 1, f = 0; // fila = c * x + d * y + f
+
+    /* Escala, rota (en radianes) y traslada.
+     *
+     * @Param escala: Celdas por unidad del polígono.
+     * @Param angulo: Rotación en radianes.
+     * @Param columna: Columna donde queda el origen del polígono.
+     * @Param fila: Fila donde queda el origen del polígono.
+     */
+    static Transformacion similitud(double escala, double angulo, double columna, double fila);
+};
+
+// Arista en coordenadas del tablero, x es la columna e y la fila
+struct AristaRaster {
+    double x0, y0, x1, y1;
+};
+
+/* Rellena las celdas cuyo centro (i + 0.5, j + 0.5) queda dentro de las aristas, que pueden
+ * formar varios contornos. Un centro sobre el borde izquierdo o superior queda dentro y uno
+ * sobre el borde derecho o inferior queda fuera, igual que Polygon::in_poly.
+ *
+ * @Param game: Tablero.
+ * @Param aristas: Aristas de los contornos.
+ * @Param regla: Regla de relleno.
+ * @Param valor: Estado de las celdas de dentro.
+ * @Param nHilos: Cantidad de hilos, 0 usa todos los núcleos.
+ * @Return: Celdas escritas.
+ */
+long long rasterizarAristas(GOL &game, const std::vector<AristaRaster> &aristas, ReglaRelleno regla,
+                            bool valor = true, int nHilos = 0);
+
+/* Rellena un polígono transformado al tablero.
+ *
+ * @Param game: Tablero.
+ * @Param poligono: Polígono de tarea-01, se cierra uniendo el último punto con el primero.
+ * @Param t: Transformación a coordenadas del tablero.
+ * @Param regla: Regla de relleno.
+ * @Param valor: Estado de las celdas de dentro.
+ * @Param nHilos: Cantidad de hilos, 0 usa todos los núcleos.
+ * @Return: Celdas escritas.
+ */
+template<class T>
+long long rasterizarPoligono(GOL &game, const Polygon<T> &poligono, const Transformacion &t = Transformacion(),
+                             ReglaRelleno regla = RELLENO_PAR_IMPAR, bool valor = true, int nHilos = 0) {
+    int n = poligono.size();
+    std::vector<AristaRaster> aristas;
+    aristas.reserve((size_t) n);
+    for (int k = 0; k < n; k++) {
+        Point<T> p = poligono.get_point(k), q = poligono.get_point((k + 1) % n);
+        double px = (double) p.get_coord_x(), py = (double) p.get_coord_y();
+        double qx = (double) q.get_coord_x(), qy = (double) q.get_coord_y();
+        aristas.push_back({t.a * px + t.b * py + t.e, t.c * px + t.d * py + t.f,
+                           t.a * qx + t.b * qy + t.e, t.c * qx + t.d * qy + t.f});
+    }
+    return rasterizarAristas(game, aristas, regla, valor, nHilos);
+}
+
+#endif // GAMEOFLIFECPU_RASTERIZADOR_H
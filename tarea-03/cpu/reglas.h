@@ -0,0 +1,150 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Reglas del juego aplicadas a una fila completa, compartidas por los motores SIMD, multihilo y
+ * de bits empaquetados.
+ */
+
+#ifndef GAMEOFLIFECPU_REGLAS_H
+#define GAMEOFLIFECPU_REGLAS_H
+
+#include <cstdint>
+#include <cstring>
+
+// Un 1 en cada byte de una palabra de 64 bits
+#define BYTES_UNO 0x0101010101010101ULL
+
+/**
+ * Carga 8 bytes sin alinear.
+ */
+inline uint64_t cargar8(const uint8_t *p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+/**
+ * Retorna 1 en cada byte de x igual a cero. Cada byte de x debe ser menor a 16.
+ */
+inline uint64_t bytesCero(uint64_t x) {
+    return ((x | x >> 1 | x >> 2 | x >> 3) & BYTES_UNO) ^ BYTES_UNO;
+}
+
+/**
+ * Aplica las reglas a las celdas [1, M] de una fila de bytes (0 o 1), procesando 8 celdas por
+ * operación dentro de un registro de 64 bits (SWAR). Las filas deben tener al menos M + 9 bytes,
+ * la salida escribe hasta el byte M + 7 por lo que las columnas fantasmas se deben corregir
+ * después.
+ *
+ * @param arriba Fila anterior
+ * @param centro Fila actual
+ * @param abajo Fila siguiente
+ * @param salida Fila de salida
+ * @param M Número de columnas reales
+ */
+inline void reglasFilaBytes(const uint8_t *arriba, const uint8_t *centro, const uint8_t *abajo,
+                            uint8_t *salida, int M) {
+    for (int j = 1; j <= M; j += 8) {
+        // Cada byte queda con la cantidad de vecinos vivos (0 a 8)
+        uint64_t n = cargar8(arriba + j - 1) + cargar8(arriba + j) + cargar8(arriba + j + 1) +
+                     cargar8(centro + j - 1) + cargar8(centro + j + 1) +
+                     cargar8(abajo + j - 1) + cargar8(abajo + j) + cargar8(abajo + j + 1);
+        uint64_t celda = cargar8(centro + j);
+
+        // Vive con 3 vecinos, o con 2 si estaba viva
+        uint64_t r = bytesCero(n ^ (3 * BYTES_UNO)) | (bytesCero(n ^ (2 * BYTES_UNO)) & celda);
+        memcpy(salida + j, &r, 8);
+    }
+}
+
+/**
+ * Suma un bit de entrada a un contador de 3 bits por posición, saturado en 4 o más.
+ */
+inline void sumarBits(uint64_t x, uint64_t &s0, uint64_t &s1, uint64_t &s2) {
+    uint64_t c0 = s0 & x;
+    s0 ^= x;
+    uint64_t c1 = s1 & c0;
+    s1 ^= c0;
+    s2 |= c1;
+}
+
+/**
+ * Aplica las reglas a 64 celdas empaquetadas en una palabra usando sumadores de bits.
+ *
+ * @param a Palabra de la fila anterior
+ * @param c Palabra de la fila actual
+ * @param b Palabra de la fila siguiente
+ * @param aIzq, cIzq, bIzq Palabras a la izquierda (bits menores)
+ * @param aDer, cDer, bDer Palabras a la derecha (bits mayores)
+ * @return Palabra con la siguiente generación
+ */
+inline uint64_t reglasPalabra(uint64_t a, uint64_t c, uint64_t b,
+                              uint64_t aIzq, uint64_t cIzq, uint64_t bIzq,
+                              uint64_t aDer, uint64_t cDer, uint64_t bDer) {
+    uint64_t s0 = 0, s1 = 0, s2 = 0;
+
+    // Vecino izquierdo de la columna k es la columna k - 1, queda en el bit k al desplazar
+    sumarBits((a << 1) | (aIzq >> 63), s0, s1, s2);
+    sumarBits(a, s0, s1, s2);
+    sumarBits((a >> 1) | (aDer << 63), s0, s1, s2);
+    sumarBits((c << 1) | (cIzq >> 63), s0, s1, s2);
+    sumarBits((c >> 1) | (cDer << 63), s0, s1, s2);
+    sumarBits((b << 1) | (bIzq >> 63), s0, s1, s2);
+    sumarBits(b, s0, s1, s2);
+    sumarBits((b >> 1) | (bDer << 63), s0, s1, s2);
+
+    // Exactamente 2 o 3 vecinos: s1 = 1 y s2 = 0, con 3 vecinos s0 = 1
+    return s1 & ~s2 & (s0 | c);
+}
+
+/**
+ * Aplica las reglas a una fila de W palabras de 64 bits.
+ *
+ * @param arriba Fila anterior
+ * @param centro Fila actual
+ * @param abajo Fila siguiente
+ * @param salida Fila de salida
+ * @param W Número de palabras por fila
+ */
+inline void reglasFilaBits(const uint64_t *arriba, const uint64_t *centro, const uint64_t *abajo,
+                           uint64_t *salida, int W) {
+    for (int k = 0; k < W; k++) {
+        uint64_t aIzq = k > 0 ? arriba[k - 1] : 0, aDer = k < W - 1 ? arriba[k + 1] : 0;
+        uint64_t cIzq = k > 0 ? centro[k - 1] : 0, cDer = k < W - 1 ? centro[k + 1] : 0;
+        uint64_t bIzq = k > 0 ? abajo[k - 1] : 0, bDer = k < W - 1 ? abajo[k + 1] : 0;
+        salida[k] = reglasPalabra(arriba[k], centro[k], abajo[k], aIzq, cIzq, bIzq, aDer, cDer, bDer);
+    }
+}
+
+/**
+ * Cuenta los bits en uno de una palabra.
+ */
+inline int contarBits(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    int n = 0;
+    while (x) {
+        x &= x - 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/**
+ * Índice del bit en uno menos significativo, x no puede ser 0.
+ */
+inline int primerBit(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+#endif // GAMEOFLIFECPU_REGLAS_H
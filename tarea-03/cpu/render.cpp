@@ -0,0 +1,200 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Dibujo del tablero en un buffer preasignado.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "render.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+// Caracteres por densidad, de vacío a lleno
+static const char DENSIDAD[] = " .:-=+*#%@";
+#define NIVELES_DENSIDAD 9
+
+// Medios bloques en UTF-8: superior, inferior y completo
+static const char BLOQUE_SUPERIOR[] = "\xE2\x96\x80";
+static const char BLOQUE_INFERIOR[] = "\xE2\x96\x84";
+static const char BLOQUE_COMPLETO[] = "\xE2\x96\x88";
+
+// Vuelve el cursor al inicio de la terminal
+static const char VOLVER_INICIO[] = "\x1B[H";
+
+/**
+ * Constructor.
+ *
+ * @param modo Forma de dibujar las celdas
+ * @param filas Filas máximas de texto
+ * @param columnas Columnas máximas de texto
+ */
+GOLRender::GOLRender(ModoRender modo, int filas, int columnas) {
+    this->volverInicio = false;
+    this->largo = 0;
+    configurar(modo, filas, columnas);
+}
+
+/**
+ * Cambia el modo y el tamaño máximo.
+ */
+void GOLRender::configurar(ModoRender modo, int filas, int columnas) {
+    this->modo = modo;
+    this->filas = std::max(0, filas);
+    this->columnas = std::max(0, columnas);
+}
+
+/**
+ * Antepone "volver al inicio" a cada cuadro.
+ */
+void GOLRender::setVolverInicio(bool volverInicio) {
+    this->volverInicio = volverInicio;
+}
+
+/**
+ * Suma las celdas vivas de las filas [i0, i1) en cada bloque de bw columnas.
+ */
+void GOLRender::contarBloques(const bool *celdas, size_t stride, int i0, int i1, int M, int bw, int *cuenta) {
+    int bloques = (M + bw - 1) / bw;
+    std::fill(cuenta, cuenta + bloques, 0);
+    for (int i = i0; i < i1; i++) {
+        const bool *fila = celdas + (size_t) i * stride;
+        for (int b = 0; b < bloques; b++) {
+            int j1 = std::min(M, (b + 1) * bw), vivas = 0;
+            for (int j = b * bw; j < j1; j++) vivas += fila[j];
+            cuenta[b] += vivas;
+        }
+    }
+}
+
+/**
+ * Dibuja un cuadro. Si el tablero no cabe en el tamaño máximo cada carácter representa un
+ * bloque de bh x bw celdas; sin reducir, RENDER_TEXTO entrega lo mismo que printGrid.
+ *
+ * @param celdas Primera celda real
+ * @param N Número de filas
+ * @param M Número de columnas
+ * @param stride Celdas entre filas
+ * @param encabezado Línea antes del cuadro
+ */
+void GOLRender::dibujar(const bool *celdas, int N, int M, size_t stride, const char *encabezado) {
+    largo = 0;
+    if (N <= 0 || M <= 0) return;
+
+    // Celdas por carácter: texto usa 3 columnas por celda y bloques 2 filas por carácter
+    int anchoCelda = modo == RENDER_TEXTO ? 3 : 1;
+    int filasPorCaracter = modo == RENDER_BLOQUES ? 2 : 1;
+    int bh = filas > 0 ? (N + filas * filasPorCaracter - 1) / (filas * filasPorCaracter) : 1;
+    int bw = columnas >= anchoCelda ? (M + columnas / anchoCelda - 1) / (columnas / anchoCelda) : 1;
+    int filasBloque = (N + bh - 1) / bh, columnasBloque = (M + bw - 1) / bw;
+    int filasTexto = (filasBloque + filasPorCaracter - 1) / filasPorCaracter;
+
+    // El peor caso son 3 bytes por columna de bloque más el salto de línea
+    size_t largoEncabezado = encabezado ? strlen(encabezado) : 0;
+    size_t maximo = sizeof(VOLVER_INICIO) + largoEncabezado + 1 + (size_t) filasTexto * (3 * (size_t) columnasBloque + 1);
+    if (buffer.size() < maximo) buffer.resize(maximo);
+    cuentas.resize(2 * (size_t) columnasBloque);
+    char *p = buffer.data();
+
+    if (volverInicio) {
+        memcpy(p, VOLVER_INICIO, sizeof(VOLVER_INICIO) - 1);
+        p += sizeof(VOLVER_INICIO) - 1;
+    }
+    if (encabezado) {
+        memcpy(p, encabezado, largoEncabezado);
+        p += largoEncabezado;
+        *p++ = '\n';
+    }
+
+    int *arriba = cuentas.data(), *abajo = cuentas.data() + columnasBloque;
+    for (int t = 0; t < filasTexto; t++) {
+        int f = t * filasPorCaracter;
+        contarBloques(celdas, stride, f * bh, std::min(N, (f + 1) * bh), M, bw, arriba);
+        if (modo == RENDER_BLOQUES) {
+            if (f + 1 < filasBloque) contarBloques(celdas, stride, (f + 1) * bh, std::min(N, (f + 2) * bh), M, bw, abajo);
+            else std::fill(abajo, abajo + columnasBloque, 0);
+        }
+
+        for (int b = 0; b < columnasBloque; b++) {
+            if (modo == RENDER_TEXTO) {
+                memcpy(p, arriba[b] ? " O " : " . ", 3);
+                p += 3;
+            } else if (modo == RENDER_DENSIDAD) {
+                int total = (std::min(N, (f + 1) * bh) - f * bh) * (std::min(M, (b + 1) * bw) - b * bw);
+                int nivel = (arriba[b] * NIVELES_DENSIDAD + total - 1) / total;
+                *p++ = DENSIDAD[nivel];
+            } else if (!arriba[b] && !abajo[b]) {
+                *p++ = ' ';
+            } else {
+                const char *bloque = arriba[b] && abajo[b] ? BLOQUE_COMPLETO : arriba[b] ? BLOQUE_SUPERIOR : BLOQUE_INFERIOR;
+                memcpy(p, bloque, 3);
+                p += 3;
+            }
+        }
+        *p++ = '\n';
+    }
+    largo = (size_t) (p - buffer.data());
+}
+
+/**
+ * Escribe el último cuadro en la salida estándar en una sola llamada, salvo escrituras parciales.
+ */
+void GOLRender::emitir() const {
+    std::cout.flush();
+    fflush(stdout);
+    const char *p = buffer.data();
+    size_t restante = largo;
+    while (restante > 0) {
+#ifdef _WIN32
+        int escritos = _write(1, p, (unsigned int) restante);
+#else
+        ssize_t escritos = write(1, p, restante);
+#endif
+        if (escritos <= 0) return;
+        p += escritos;
+        restante -= (size_t) escritos;
+    }
+}
+
+/**
+ * Retorna el último cuadro.
+ */
+const char *GOLRender::getCuadro() const {
+    return buffer.data();
+}
+
+/**
+ * Retorna el largo del último cuadro en bytes.
+ */
+size_t GOLRender::getLargo() const {
+    return largo;
+}
+
+/**
+ * Tamaño de la terminal, se consulta la terminal y luego las variables LINES y COLUMNS.
+ *
+ * @param filas Filas
+ * @param columnas Columnas
+ */
+void tamanoTerminal(int &filas, int &columnas) {
+    filas = 24;
+    columnas = 80;
+#ifndef _WIN32
+    struct winsize ws;
+    if (ioctl(1, TIOCGWINSZ, &ws) == 0 && ws.ws_row > 0 && ws.ws_col > 0) {
+        filas = ws.ws_row;
+        columnas = ws.ws_col;
+        return;
+    }
+#endif
+    const char *lineas = getenv("LINES"), *cols = getenv("COLUMNS");
+    if (lineas && atoi(lineas) > 0) filas = atoi(lineas);
+    if (cols && atoi(cols) > 0) columnas = atoi(cols);
+}
@@ -0,0 +1,80 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Dibuja el tablero en un buffer preasignado y lo escribe en una sola llamada, opcionalmente
+ * reducido al tamaño de la terminal.
+ */
+
+#ifndef GAMEOFLIFECPU_RENDER_H
+#define GAMEOFLIFECPU_RENDER_H
+
+#include <cstddef>
+#include <vector>
+
+// Forma de dibujar cada celda (o bloque de celdas al reducir)
+enum ModoRender {
+    RENDER_TEXTO,       // " . " y " O " como printGrid, un bloque vive si tiene alguna celda viva
+    RENDER_DENSIDAD,    // Un carácter por bloque según la fracción de celdas vivas (" .:-=+*#%@")
+    RENDER_BLOQUES      // Medios bloques Unicode, dos filas de bloques por carácter
+};
+
+class GOLRender {
+private:
+
+    // Modo y tamaño máximo en caracteres, 0 no limita
+    ModoRender modo;
+    int filas;
+    int columnas;
+
+    // Antepone la secuencia ANSI que vuelve el cursor al inicio, para animar en el lugar
+    bool volverInicio;
+
+    // Cuadro dibujado, se reutiliza entre cuadros
+    std::vector<char> buffer;
+    size_t largo;
+
+    // Celdas vivas por bloque de dos filas de bloques
+    std::vector<int> cuentas;
+
+    // Cuenta las celdas vivas de cada bloque en las filas [i0, i1)
+    void contarBloques(const bool *celdas, size_t stride, int i0, int i1, int M, int bw, int *cuenta);
+
+public:
+
+    /* Constructor.
+     *
+     * @Param modo: Forma de dibujar las celdas.
+     * @Param filas: Filas máximas de texto, 0 no limita.
+     * @Param columnas: Columnas máximas de texto, 0 no limita.
+     */
+    explicit GOLRender(ModoRender modo = RENDER_TEXTO, int filas = 0, int columnas = 0);
+
+    // Cambia el modo y el tamaño máximo
+    void configurar(ModoRender modo, int filas, int columnas);
+
+    // Antepone "volver al inicio" a cada cuadro
+    void setVolverInicio(bool volverInicio);
+
+    /* Dibuja un cuadro en el buffer.
+     *
+     * @Param celdas: Primera celda real del tablero.
+     * @Param N: Número de filas.
+     * @Param M: Número de columnas.
+     * @Param stride: Celdas entre el inicio de dos filas.
+     * @Param encabezado: Línea que se escribe antes del cuadro, nullptr sin encabezado.
+     */
+    void dibujar(const bool *celdas, int N, int M, size_t stride, const char *encabezado = nullptr);
+
+    // Escribe el último cuadro en la salida estándar en una sola llamada
+    void emitir() const;
+
+    // Último cuadro dibujado y su largo en bytes
+    const char *getCuadro() const;
+
+    size_t getLargo() const;
+
+};
+
+// Tamaño de la terminal, 24x80 si no se puede obtener
+void tamanoTerminal(int &filas, int &columnas);
+
+#endif // GAMEOFLIFECPU_RENDER_H
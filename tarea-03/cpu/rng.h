@@ -0,0 +1,46 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Generador aleatorio basado en contador (SplitMix64) para inicializar los tableros.
+ *
+ * El valor de cada celda depende sólo de la semilla y de su índice (fila * columnas + columna,
+ * sin contar las filas fantasmas), por lo que el tablero se puede inicializar en paralelo y es
+ * idéntico en CPU, CUDA y OpenCL. Las copias en cuda/GOL.cu y opencl/GOL-kernels.cl deben
+ * coincidir con este archivo.
+ */
+
+#ifndef GAMEOFLIFECPU_RNG_H
+#define GAMEOFLIFECPU_RNG_H
+
+#ifdef __CUDACC__
+#define RNG_FUNC __host__ __device__ inline
+#else
+#define RNG_FUNC inline
+#endif
+
+/**
+ * Función de mezcla de SplitMix64.
+ *
+ * @param z Valor a mezclar
+ * @return Valor mezclado
+ */
+RNG_FUNC unsigned long long mezclarSplitMix(unsigned long long z) {
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Retorna si una celda parte viva.
+ *
+ * @param seed Semilla
+ * @param indice Índice de la celda, fila * columnas + columna sin filas fantasmas
+ * @param probTrue Probabilidad (0-100) de que la celda sea verdadera
+ * @return Estado inicial de la celda
+ */
+RNG_FUNC bool celdaAleatoria(unsigned long long seed, unsigned long long indice, int probTrue) {
+    unsigned long long h = mezclarSplitMix(seed ^ mezclarSplitMix(indice));
+    return (int) (((h >> 32) * 100) >> 32) < probTrue;
+}
+
+#endif // GAMEOFLIFECPU_RNG_H
@@ -0,0 +1,526 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Servidor de simulaciones en un socket Unix con una cola de trabajos acotada.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <map>
+#include <memory>
+#include <poll.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "checkpoint.h"
+#include "engines.h"
+#include "exportador.h"
+#include "servidor.h"
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+// Largo máximo de un comando
+#define LARGO_COMANDO 4096
+
+// Segundos que un cliente tiene para enviar su comando y para recibir cada respuesta
+#define ESPERA_CLIENTE 5
+
+// Conexiones que pueden estar enviando su comando a la vez, el resto se rechaza
+#define MAX_PENDIENTES 256
+
+// Celdas que avanza un trabajo entre dos revisiones de la cancelación
+#define CELDAS_POR_BLOQUE (1LL << 24)
+
+// Conexión que todavía no envía su comando completo
+struct ConexionPendiente {
+    int fd;
+    std::string linea;
+    std::chrono::steady_clock::time_point limite;
+};
+
+/**
+ * Envía una línea, retorna falso si la conexión se cerró.
+ */
+static bool enviarLinea(int fd, const std::string &linea) {
+    std::string texto = linea + "\n";
+    size_t enviados = 0;
+    while (enviados < texto.size()) {
+        ssize_t n = send(fd, texto.data() + enviados, texto.size() - enviados, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        enviados += (size_t) n;
+    }
+    return true;
+}
+
+/**
+ * Lee una línea sin el salto, retorna falso si la conexión se cerró antes.
+ */
+static bool leerLinea(int fd, std::string &linea) {
+    linea.clear();
+    char c;
+    while (linea.size() < LARGO_COMANDO) {
+        ssize_t n = recv(fd, &c, 1, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return !linea.empty();
+        if (c == '\n') return true;
+        if (c != '\r') linea += c;
+    }
+    return true;
+}
+
+/**
+ * Revisa sin bloquear si el cliente cerró la conexión. Sólo cuenta el cierre completo (POLLHUP),
+ * un cliente que cerró su lado de escritura sigue recibiendo el progreso.
+ */
+static bool clienteCerrado(int fd) {
+    pollfd p = {fd, 0, 0};
+    return poll(&p, 1, 0) > 0 && (p.revents & (POLLHUP | POLLERR)) != 0;
+}
+
+/**
+ * Dirección del socket, lanza std::runtime_error si la ruta es muy larga.
+ */
+static sockaddr_un direccion(const std::string &ruta) {
+    sockaddr_un dir;
+    memset(&dir, 0, sizeof(dir));
+    dir.sun_family = AF_UNIX;
+    if (ruta.size() >= sizeof(dir.sun_path)) {
+        throw std::runtime_error("Ruta de socket muy larga: " + ruta);
+    }
+    memcpy(dir.sun_path, ruta.c_str(), ruta.size());
+    return dir;
+}
+
+/**
+ * Lee un entero de un valor, lanza std::invalid_argument si no es válido o está fuera del rango.
+ */
+static long long leerEntero(const std::string &clave, const std::string &valor, long long minimo, long long maximo) {
+    char *fin = nullptr;
+    errno = 0;
+    long long v = strtoll(valor.c_str(), &fin, 10);
+    if (valor.empty() || *fin != '\0' || errno != 0 || v < minimo || v > maximo) {
+        throw std::invalid_argument("Valor no válido para " + clave + ": " + valor);
+    }
+    return v;
+}
+
+/**
+ * Valida la ruta de una salida pedida por un cliente: debe ser relativa, sin componentes "..",
+ * sin '|' (GOLExportador la abriría como comando), '%' (sería un patrón por cuadro) ni barras
+ * invertidas.
+ */
+static std::string leerRutaSalida(const std::string &clave, const std::string &valor) {
+    bool valida = !valor.empty() && valor[0] != '/' && valor.find_first_of("|%\\") == std::string::npos;
+    for (size_t inicio = 0; valida && inicio <= valor.size();) {
+        size_t fin = std::min(valor.find('/', inicio), valor.size());
+        if (valor.compare(inicio, fin - inicio, "..") == 0) valida = false;
+        inicio = fin + 1;
+    }
+    if (!valida) {
+        throw std::invalid_argument("Ruta no válida para " + clave + ", debe ser relativa al directorio de salidas: " +
+                                    valor);
+    }
+    return valor;
+}
+
+/**
+ * Lee un trabajo.
+ *
+ * @param linea Pares clave=valor separados por espacios
+ * @return Trabajo
+ */
+TrabajoServidor leerTrabajo(const std::string &linea) {
+    TrabajoServidor t;
+    std::istringstream entrada(linea);
+    std::string par;
+    while (entrada >> par) {
+        size_t igual = par.find('=');
+        if (igual == std::string::npos) {
+            throw std::invalid_argument("Se esperaba clave=valor: " + par);
+        }
+        std::string clave = par.substr(0, igual), valor = par.substr(igual + 1);
+        if (clave == "n") t.N = (int) leerEntero(clave, valor, 1, MAX_CELDAS_TRABAJO);
+        else if (clave == "m") t.M = (int) leerEntero(clave, valor, 1, MAX_CELDAS_TRABAJO);
+        else if (clave == "prob") t.probTrue = (int) leerEntero(clave, valor, 0, 100);
+        else if (clave == "seed") t.seed = (unsigned long long) leerEntero(clave, valor, 0, LLONG_MAX);
+        else if (clave == "gens") t.gens = leerEntero(clave, valor, 0, LLONG_MAX);
+        else if (clave == "cada") t.cada = leerEntero(clave, valor, 0, LLONG_MAX);
+        else if (clave == "motor") t.motor = valor;
+        else if (clave == "regla") t.regla = valor;
+        else if (clave == "checkpoint") t.checkpoint = leerRutaSalida(clave, valor);
+        else if (clave == "imagen") t.imagen = leerRutaSalida(clave, valor);
+        else if (clave == "frontera") {
+            if (valor != "fija" && valor != "toroidal") {
+                throw std::invalid_argument("Valor no válido para frontera: " + valor);
+            }
+            t.frontera = valor == "fija" ? FRONTERA_FIJA : FRONTERA_TOROIDAL;
+        } else {
+            throw std::invalid_argument("Clave desconocida: " + clave);
+        }
+    }
+    if ((long long) t.N * t.M > MAX_CELDAS_TRABAJO) {
+        throw std::invalid_argument("Tablero muy grande, el máximo es de " + std::to_string(MAX_CELDAS_TRABAJO) +
+                                    " celdas");
+    }
+    return t;
+}
+
+/**
+ * Constructor.
+ *
+ * @param ruta Ruta del socket
+ * @param trabajadores Trabajos que corren a la vez
+ * @param capacidad Trabajos que pueden esperar en la cola
+ * @param hilosMotor Hilos de cada motor multihilo
+ * @param salidas Directorio de las salidas de los trabajos, vacío no las permite
+ */
+GOLServidor::GOLServidor(const std::string &ruta, int trabajadores, int capacidad, int hilosMotor,
+                         const std::string &salidas) {
+    this->ruta = ruta;
+    this->salidas = salidas;
+    this->fdServidor = -1;
+    this->despertar[0] = -1;
+    this->despertar[1] = -1;
+    this->trabajadores = std::max(1, trabajadores);
+    this->capacidad = std::max(0, capacidad);
+    this->hilosMotor = hilosMotor;
+    this->apagando = false;
+    this->activos = 0;
+    this->siguienteId = 0;
+    this->completados = 0;
+    this->rechazados = 0;
+    this->cancelados = 0;
+    this->fallidos = 0;
+    this->detenido = false;
+    this->cancelar = false;
+}
+
+/**
+ * Destructor.
+ */
+GOLServidor::~GOLServidor() {
+    detener();
+}
+
+/**
+ * Abre el socket y lanza el hilo que acepta conexiones y los trabajadores.
+ */
+void GOLServidor::iniciar() {
+    sockaddr_un dir = direccion(ruta);
+    if (!salidas.empty()) {
+        struct stat info;
+        if (mkdir(salidas.c_str(), 0755) != 0 && errno != EEXIST) {
+            throw std::runtime_error("No se pudo crear el directorio de salidas " + salidas + ": " + strerror(errno));
+        }
+        if (stat(salidas.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)) {
+            throw std::runtime_error(salidas + " no es un directorio");
+        }
+    }
+    unlink(ruta.c_str());
+    fdServidor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fdServidor < 0 || bind(fdServidor, (sockaddr *) &dir, sizeof(dir)) != 0 || listen(fdServidor, 64) != 0 ||
+        pipe(despertar) != 0) {
+        std::string error = strerror(errno);
+        if (fdServidor >= 0) close(fdServidor);
+        fdServidor = -1;
+        throw std::runtime_error("No se pudo escuchar en " + ruta + ": " + error);
+    }
+    for (int t = 0; t < trabajadores; t++) hilos.emplace_back(&GOLServidor::trabajar, this);
+    aceptador = std::thread(&GOLServidor::aceptar, this);
+}
+
+/**
+ * Espera el comando apagar y detiene el servidor.
+ */
+void GOLServidor::esperar() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        hayTrabajo.wait(lock, [this] { return apagando; });
+    }
+    detener();
+}
+
+/**
+ * Detiene el servidor, los trabajos en cola reciben un error y los que corren se cancelan.
+ */
+void GOLServidor::detener() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        apagando = true;
+        for (TrabajoServidor &t : cola) {
+            enviarLinea(t.fd, "error servidor apagado");
+            close(t.fd);
+        }
+        cola.clear();
+    }
+    cancelar = true;
+    hayTrabajo.notify_all();
+    if (!detenido.exchange(true) && despertar[1] >= 0) {
+        char c = 0;
+        while (write(despertar[1], &c, 1) < 0 && errno == EINTR) {
+        }
+    }
+    if (aceptador.joinable()) aceptador.join();
+    for (std::thread &h : hilos) h.join();
+    hilos.clear();
+    if (fdServidor >= 0) {
+        close(fdServidor);
+        close(despertar[0]);
+        close(despertar[1]);
+        fdServidor = despertar[0] = despertar[1] = -1;
+        unlink(ruta.c_str());
+    }
+}
+
+/**
+ * Acepta conexiones y lee sus comandos sin bloquearse: un solo poll espera al socket, al pipe
+ * de detener y a las conexiones que aún no envían su línea completa, así un cliente lento no
+ * frena a los demás. Una conexión que no envía su comando en ESPERA_CLIENTE segundos se cierra.
+ */
+void GOLServidor::aceptar() {
+    std::vector<ConexionPendiente> pendientes;
+    std::vector<pollfd> fds;
+    char buffer[512];
+    while (true) {
+        std::chrono::steady_clock::time_point ahora = std::chrono::steady_clock::now();
+        int espera = -1;
+        fds.assign({{fdServidor, POLLIN, 0}, {despertar[0], POLLIN, 0}});
+        for (const ConexionPendiente &p : pendientes) {
+            fds.push_back({p.fd, POLLIN, 0});
+            long long resto = std::chrono::duration_cast<std::chrono::milliseconds>(p.limite - ahora).count();
+            espera = (int) std::max(0LL, espera < 0 ? resto : std::min((long long) espera, resto));
+        }
+        if (poll(fds.data(), fds.size(), espera) < 0 && errno != EINTR) break;
+        if (detenido || fds[1].revents) break;
+
+        // Lee lo disponible de cada conexión pendiente y atiende las que completan su línea
+        ahora = std::chrono::steady_clock::now();
+        std::vector<ConexionPendiente> siguen;
+        for (size_t k = 0; k < pendientes.size(); k++) {
+            ConexionPendiente &p = pendientes[k];
+            bool cerrada = false, completa = false;
+            if (fds[k + 2].revents) {
+                ssize_t n;
+                while (!completa && (n = recv(p.fd, buffer, sizeof(buffer), 0)) > 0) {
+                    p.linea.append(buffer, (size_t) n);
+                    completa = p.linea.find('\n') != std::string::npos || p.linea.size() >= LARGO_COMANDO;
+                }
+                if (!completa && (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))) {
+                    cerrada = true;
+                    completa = !p.linea.empty();
+                }
+            }
+            if (completa) {
+                std::string linea = p.linea.substr(0, std::min(p.linea.find('\n'), (size_t) LARGO_COMANDO));
+                linea.erase(std::remove(linea.begin(), linea.end(), '\r'), linea.end());
+                fcntl(p.fd, F_SETFL, fcntl(p.fd, F_GETFL) & ~O_NONBLOCK);
+                atender(p.fd, linea);
+            } else if (cerrada || ahora >= p.limite) {
+                close(p.fd);
+            } else {
+                siguen.push_back(p);
+            }
+        }
+        pendientes.swap(siguen);
+
+        // Conexión nueva, las respuestas que el cliente no lee tampoco bloquean a un trabajador
+        if (fds[0].revents & POLLIN) {
+            int fd = accept(fdServidor, nullptr, nullptr);
+            if (fd >= 0 && pendientes.size() >= MAX_PENDIENTES) {
+                enviarLinea(fd, "rechazado demasiadas conexiones");
+                close(fd);
+            } else if (fd >= 0) {
+                timeval espera = {ESPERA_CLIENTE, 0};
+                setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &espera, sizeof(espera));
+                fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+                pendientes.push_back({fd, "", ahora + std::chrono::seconds(ESPERA_CLIENTE)});
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (apagando) break;
+    }
+    for (const ConexionPendiente &p : pendientes) close(p.fd);
+}
+
+/**
+ * Atiende el comando de una conexión. Los trabajos se encolan y la conexión queda abierta para
+ * el trabajador, se rechazan si los trabajos en curso y en cola llenan trabajadores + capacidad.
+ *
+ * @param fd Conexión
+ * @param linea Comando
+ */
+void GOLServidor::atender(int fd, const std::string &linea) {
+    std::string comando = linea.substr(0, linea.find(' '));
+    std::string resto = comando.size() < linea.size() ? linea.substr(comando.size() + 1) : "";
+
+    if (comando == "trabajo") {
+        TrabajoServidor t;
+        try {
+            t = leerTrabajo(resto);
+            if (salidas.empty() && (!t.checkpoint.empty() || !t.imagen.empty())) {
+                throw std::invalid_argument("El servidor no tiene directorio de salidas");
+            }
+        } catch (const std::invalid_argument &e) {
+            enviarLinea(fd, std::string("error ") + e.what());
+            close(fd);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (apagando || activos + (int) cola.size() >= trabajadores + capacidad) {
+            rechazados++;
+            enviarLinea(fd, apagando ? "rechazado servidor apagado" : "rechazado cola llena");
+            close(fd);
+            return;
+        }
+        t.id = ++siguienteId;
+        t.fd = fd;
+        enviarLinea(fd, "aceptado " + std::to_string(t.id) + " cola=" + std::to_string(cola.size()));
+        cola.push_back(t);
+        hayTrabajo.notify_all();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (comando == "estado") {
+        char texto[256];
+        snprintf(texto, sizeof(texto), "estado trabajadores=%d activos=%d cola=%zu completados=%lld rechazados=%lld "
+                 "cancelados=%lld fallidos=%lld", trabajadores, activos, cola.size(), completados, rechazados,
+                 cancelados, fallidos);
+        enviarLinea(fd, texto);
+    } else if (comando == "apagar") {
+        enviarLinea(fd, "apagando");
+        apagando = true;
+        hayTrabajo.notify_all();
+    } else {
+        enviarLinea(fd, "error comando desconocido: " + comando);
+    }
+    close(fd);
+}
+
+/**
+ * Corre trabajos de la cola. Cada trabajador guarda un motor por nombre, así un trabajo del mismo
+ * motor reutiliza sus matrices e hilos en vez de crearlos de nuevo.
+ */
+void GOLServidor::trabajar() {
+    std::map<std::string, std::unique_ptr<GOLEngine>> motores;
+    while (true) {
+        TrabajoServidor t;
+        bool terminado = false, fallido = false;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            hayTrabajo.wait(lock, [this] { return apagando || !cola.empty(); });
+            if (cola.empty()) return;
+            t = cola.front();
+            cola.pop_front();
+            activos++;
+        }
+        try {
+            std::unique_ptr<GOLEngine> &motor = motores[t.motor];
+            if (!motor) motor.reset(crearMotor(t.motor, hilosMotor));
+            terminado = correr(t, *motor);
+        } catch (const std::exception &e) {
+            enviarLinea(t.fd, std::string("error ") + e.what());
+            fallido = true;
+        }
+        close(t.fd);
+        std::lock_guard<std::mutex> lock(mutex);
+        activos--;
+        if (fallido) fallidos++;
+        else if (terminado) completados++;
+        else cancelados++;
+    }
+}
+
+/**
+ * Corre un trabajo y envía su progreso. Avanza en bloques de a lo más CELDAS_POR_BLOQUE celdas
+ * y entre bloques revisa si el servidor se está deteniendo o si el cliente se fue.
+ *
+ * @param trabajo Trabajo
+ * @param motor Motor
+ * @return Falso si el cliente cerró la conexión o se detuvo el servidor y se canceló el trabajo
+ */
+bool GOLServidor::correr(TrabajoServidor &trabajo, GOLEngine &motor) {
+    GOLScalar *escalar = dynamic_cast<GOLScalar *>(&motor);
+    std::string regla = trabajo.regla;
+    std::transform(regla.begin(), regla.end(), regla.begin(), ::toupper);
+    if (escalar) escalar->setRegla(trabajo.regla);
+    else if (regla != "B3/S23") throw std::invalid_argument("El motor " + trabajo.motor + " sólo usa B3/S23");
+
+    motor.inicializar(trabajo.N, trabajo.M, trabajo.probTrue, trabajo.seed, trabajo.frontera);
+    if (!enviarLinea(trabajo.fd, "inicio " + std::to_string(trabajo.id))) return false;
+
+    long long cada = trabajo.cada > 0 ? trabajo.cada : std::max(1LL, trabajo.gens / 10);
+    long long bloque = std::max(1LL, CELDAS_POR_BLOQUE / ((long long) trabajo.N * trabajo.M));
+    char texto[256];
+    while (motor.getGeneracion() < trabajo.gens) {
+        long long meta = std::min(motor.getGeneracion() + cada, trabajo.gens);
+        while (motor.getGeneracion() < meta) {
+            if (cancelar) {
+                enviarLinea(trabajo.fd, "error servidor apagado");
+                return false;
+            }
+            if (clienteCerrado(trabajo.fd)) return false;
+            motor.avanzar((int) std::min({bloque, meta - motor.getGeneracion(), (long long) INT_MAX}));
+        }
+        GOLStats s = motor.estadisticas();
+        snprintf(texto, sizeof(texto), "progreso gen=%lld poblacion=%lld celdas/s=%.0f", s.generacion, s.poblacion,
+                 s.celdasPorSegundo);
+        if (!enviarLinea(trabajo.fd, texto)) return false;
+    }
+
+    // Salidas pedidas, dentro del directorio de salidas (leerTrabajo ya validó las rutas)
+    if (!trabajo.checkpoint.empty()) guardarCheckpoint(motor, salidas + "/" + trabajo.checkpoint, trabajo.regla);
+    if (!trabajo.imagen.empty()) {
+        size_t punto = trabajo.imagen.rfind('.');
+        GOLExportador exportador(salidas + "/" + trabajo.imagen, formatoExport(
+                punto == std::string::npos ? "raw" : trabajo.imagen.substr(punto + 1)));
+        exportador.exportar(motor);
+    }
+
+    GOLStats s = motor.estadisticas();
+    snprintf(texto, sizeof(texto), "fin gen=%lld poblacion=%lld hash=%016llx tiempo=%.3f", s.generacion, s.poblacion,
+             hashMotor(motor), s.tiempo);
+    return enviarLinea(trabajo.fd, texto);
+}
+
+/**
+ * Envía un comando y lee las respuestas.
+ *
+ * @param ruta Ruta del socket
+ * @param linea Comando
+ * @param salida Archivo donde se escriben las respuestas, puede ser nullptr
+ * @return Respuestas
+ */
+std::vector<std::string> enviarComando(const std::string &ruta, const std::string &linea, FILE *salida) {
+    sockaddr_un dir = direccion(ruta);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (sockaddr *) &dir, sizeof(dir)) != 0) {
+        std::string error = strerror(errno);
+        if (fd >= 0) close(fd);
+        throw std::runtime_error("No se pudo conectar a " + ruta + ": " + error);
+    }
+    std::vector<std::string> respuestas;
+    std::string respuesta;
+    if (enviarLinea(fd, linea)) {
+        while (leerLinea(fd, respuesta)) {
+            if (salida) {
+                fprintf(salida, "%s\n", respuesta.c_str());
+                fflush(salida);
+            }
+            respuestas.push_back(respuesta);
+        }
+    }
+    close(fd);
+    return respuestas;
+}
@@ -0,0 +1,147 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Servidor de simulaciones en un socket Unix. Cada conexión envía una línea de comando:
+ *
+ *   trabajo n=512 m=512 prob=30 seed=1998 gens=1000 cada=100 motor=threaded regla=B3/S23
+ *           frontera=toroidal checkpoint=ruta imagen=ruta.png
+ *   estado
+ *   apagar
+ *
+ * Un trabajo aceptado responde "aceptado <id> cola=<k>" y luego, por la misma conexión,
+ * "inicio", una línea "progreso" cada "cada" generaciones y "fin" con la población y el hash
+ * (hashMotor) del tablero, o "error <mensaje>". Si la conexión se cierra el trabajo se cancela.
+ *
+ * Las rutas de checkpoint e imagen son relativas al directorio de salidas del servidor, sin
+ * componentes ".." ni los caracteres '|', '%' o la barra invertida.
+ */
+
+#ifndef GAMEOFLIFECPU_SERVIDOR_H
+#define GAMEOFLIFECPU_SERVIDOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "engine.h"
+
+// Celdas máximas del tablero de un trabajo
+#define MAX_CELDAS_TRABAJO (1LL << 28)
+
+// Trabajo de simulación
+struct TrabajoServidor {
+    int N = 512;
+    int M = 512;
+    int probTrue = 30;
+    unsigned long long seed = 1998;
+    long long gens = 100;
+    long long cada = 0;
+    std::string motor = "simd";
+    std::string regla = "B3/S23";
+    Frontera frontera = FRONTERA_TOROIDAL;
+    std::string checkpoint;
+    std::string imagen;
+
+    // Asignados por el servidor
+    long long id = 0;
+    int fd = -1;
+};
+
+/* Lee un trabajo desde los pares clave=valor de una línea, sin la palabra "trabajo". Lanza
+ * std::invalid_argument si una clave no existe o un valor no es válido, incluidas las rutas de
+ * salida absolutas, con ".." o con '|' o '%' y los tableros de más de MAX_CELDAS_TRABAJO celdas.
+ *
+ * @Param linea: Pares clave=valor separados por espacios.
+ */
+TrabajoServidor leerTrabajo(const std::string &linea);
+
+class GOLServidor {
+private:
+
+    // Ruta del socket, descriptor que escucha y pipe con que detener despierta al aceptador
+    std::string ruta;
+    int fdServidor;
+    int despertar[2];
+
+    // Directorio de los checkpoints e imágenes, vacío si no se permiten
+    std::string salidas;
+
+    // Configuración
+    int trabajadores;
+    int capacidad;
+    int hilosMotor;
+
+    // Cola de trabajos, protegida por mutex
+    std::mutex mutex;
+    std::condition_variable hayTrabajo;
+    std::deque<TrabajoServidor> cola;
+    bool apagando;
+    int activos;
+    long long siguienteId;
+    long long completados;
+    long long rechazados;
+    long long cancelados;
+    long long fallidos;
+
+    // Hilos que aceptan conexiones y que corren trabajos
+    std::thread aceptador;
+    std::vector<std::thread> hilos;
+    std::atomic<bool> detenido;
+
+    // Los trabajos en curso lo revisan entre bloques de generaciones y se cancelan
+    std::atomic<bool> cancelar;
+
+    // Acepta conexiones y lee sus comandos hasta que se apaga el servidor
+    void aceptar();
+
+    // Atiende el comando de una conexión
+    void atender(int fd, const std::string &linea);
+
+    // Toma trabajos de la cola y los corre con motores que se reutilizan entre trabajos
+    void trabajar();
+
+    // Corre un trabajo, retorna falso si se canceló
+    bool correr(TrabajoServidor &trabajo, GOLEngine &motor);
+
+public:
+
+    /* Constructor, no abre el socket.
+     *
+     * @Param ruta: Ruta del socket Unix.
+     * @Param trabajadores: Trabajos que corren a la vez.
+     * @Param capacidad: Trabajos que pueden esperar en la cola, el resto se rechaza.
+     * @Param hilosMotor: Hilos de cada motor multihilo.
+     * @Param salidas: Directorio donde se escriben los checkpoints e imágenes de los trabajos, se
+     *                 crea al iniciar. Vacío rechaza los trabajos que piden salidas.
+     */
+    GOLServidor(const std::string &ruta, int trabajadores = 2, int capacidad = 8, int hilosMotor = 1,
+                const std::string &salidas = "");
+
+    // Destructor, detiene el servidor
+    virtual ~GOLServidor();
+
+    // Abre el socket y lanza los hilos, lanza std::runtime_error si no se puede escuchar o crear
+    // el directorio de salidas
+    void iniciar();
+
+    // Espera hasta que un cliente envíe "apagar" o se llame a detener()
+    void esperar();
+
+    // Deja de aceptar conexiones, cancela la cola y los trabajos en curso y espera a los trabajadores
+    void detener();
+
+};
+
+/* Envía una línea al servidor e imprime o junta las respuestas hasta que cierre la conexión.
+ * Lanza std::runtime_error si no se puede conectar.
+ *
+ * @Param ruta: Ruta del socket Unix.
+ * @Param linea: Comando.
+ * @Param salida: Si no es nullptr se escribe cada respuesta en ella.
+ */
+std::vector<std::string> enviarComando(const std::string &ruta, const std::string &linea, FILE *salida = nullptr);
+
+#endif // GAMEOFLIFECPU_SERVIDOR_H
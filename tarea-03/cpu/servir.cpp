@@ -0,0 +1,76 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Servidor de simulaciones en un socket Unix, o cliente que le envía un comando.
+ *
+ * Uso: SERVIDOR [--socket ruta] [--trabajadores w] [--cola c] [--hilos h] [--salidas directorio]
+ *      SERVIDOR [--socket ruta] --enviar "trabajo n=1024 m=1024 gens=5000 motor=threaded"
+ *
+ * El servidor corre hasta recibir "apagar". Los checkpoints e imágenes de los trabajos se escriben
+ * dentro de --salidas, sin ese directorio se rechazan. Ver servidor.h para el protocolo.
+ */
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "servidor.h"
+
+// Opciones del servidor
+struct OpcionesServidor {
+    std::string socket = "/tmp/gol.sock";
+    int trabajadores = 2;
+    int cola = 8;
+    int hilos = 1;
+    std::string salidas;
+    std::string enviar;
+};
+
+/**
+ * Lee las opciones de la línea de comandos.
+ */
+OpcionesServidor leerOpciones(int argc, char *argv[]) {
+    OpcionesServidor op;
+    for (int i = 1; i < argc; i++) {
+        bool valor = i + 1 < argc;
+        if (strcmp(argv[i], "--socket") == 0 && valor) op.socket = argv[++i];
+        else if (strcmp(argv[i], "--trabajadores") == 0 && valor) op.trabajadores = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--cola") == 0 && valor) op.cola = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--hilos") == 0 && valor) op.hilos = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--salidas") == 0 && valor) op.salidas = argv[++i];
+        else if (strcmp(argv[i], "--enviar") == 0 && valor) op.enviar = argv[++i];
+        else {
+            std::cout << "Opción desconocida: " << argv[i] << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+    return op;
+}
+
+/**
+ * Corre el servidor o envía un comando.
+ */
+int main(int argc, char *argv[]) {
+    OpcionesServidor op = leerOpciones(argc, argv);
+    signal(SIGPIPE, SIG_IGN); // Un cliente que se va no debe terminar el proceso
+
+    try {
+        if (!op.enviar.empty()) {
+            std::vector<std::string> respuestas = enviarComando(op.socket, op.enviar, stdout);
+            bool error = respuestas.empty() || respuestas.back().compare(0, 5, "error") == 0 ||
+                         respuestas.back().compare(0, 9, "rechazado") == 0;
+            return error ? EXIT_FAILURE : 0;
+        }
+        GOLServidor servidor(op.socket, op.trabajadores, op.cola, op.hilos, op.salidas);
+        servidor.iniciar();
+        printf("Escuchando en %s, %d trabajadores, cola de %d\n", op.socket.c_str(), op.trabajadores, op.cola);
+        fflush(stdout);
+        servidor.esperar();
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Testea la asignación de bandas a núcleos y que los motores den el mismo tablero con los hilos
+ * fijados.
+ */
+
+// Importación de librerías
+#include <iostream>
+#include <cassert>
+#include "../afinidad.h"
+#include "../engine.h"
+#include "../paralelo.h"
+
+/**
+ * Crea un núcleo.
+ */
+Nucleo crearNucleo(int cpu, int socket, int l3, int core, bool hermano) {
+    Nucleo n;
+    n.cpu = cpu;
+    n.socket = socket;
+    n.l3 = l3;
+    n.core = core;
+    n.hermano = hermano;
+    return n;
+}
+
+/**
+ * Testea el orden en una máquina de dos sockets con SMT, numerada de forma intercalada como
+ * en muchos servidores (cpu par en el socket 0, impar en el socket 1).
+ */
+void test_dos_sockets() {
+    std::vector<Nucleo> nucleos;
+    for (int c = 0; c < 16; c++) {
+        int socket = c % 2;
+        nucleos.push_back(crearNucleo(c, socket, socket, (c % 8) / 2, c >= 8));
+    }
+
+    std::vector<Nucleo> bandas = asignarBandas(nucleos, 8);
+    assert(bandas.size() == 8);
+    for (int t = 0; t < 8; t++) {
+        // Las cuatro primeras bandas en el socket 0 y las otras en el 1, sin hermanos SMT
+        assert(bandas[t].socket == (t < 4 ? 0 : 1));
+        assert(!bandas[t].hermano);
+        if (t > 0 && t != 4) assert(bandas[t].l3 == bandas[t - 1].l3);
+    }
+
+    // Con más bandas que núcleos físicos se usan los hermanos
+    bandas = asignarBandas(nucleos, 0);
+    assert(bandas.size() == 16);
+    assert(bandas[8].hermano && bandas[15].hermano);
+}
+
+/**
+ * Testea que con la afinidad activada los motores multihilo no cambien el resultado.
+ */
+void test_motores_fijados() {
+    std::string mapa = activarAfinidad(4);
+    assert(!mapa.empty());
+    assert(nucleosBandas().size() == 4);
+
+    const char *nombres[] = {"threaded", "wavefront", "halo"};
+    unsigned long long esperado = 0;
+    for (const char *nombre : nombres) {
+        GOLEngine *motor = crearMotor(nombre, 4);
+        motor->inicializar(64, 64, 40, 3);
+        motor->avanzar(20);
+        if (esperado == 0) esperado = hashMotor(*motor);
+        assert(hashMotor(*motor) == esperado);
+        delete motor;
+    }
+
+    activarAfinidad(-1);
+    assert(nucleosBandas().empty());
+}
+
+/**
+ * Testea que el hilo que llama a paraleloBandasIndice recupere su afinidad al terminar.
+ */
+void test_afinidad_restaurada() {
+#ifdef __linux__
+    cpu_set_t antes, despues;
+    int ok = pthread_getaffinity_np(pthread_self(), sizeof(antes), &antes);
+    assert(ok == 0);
+    nucleosBandas().assign(1, 0);
+    int bandas = 0;
+    paraleloBandasIndice(0, 10, 3, [&bandas](int t, int, int) {
+        if (t == 2) bandas++;
+    });
+    nucleosBandas().clear();
+    ok = pthread_getaffinity_np(pthread_self(), sizeof(despues), &despues);
+    assert(ok == 0 && bandas == 1);
+    assert(CPU_EQUAL(&antes, &despues));
+    (void) ok;
+#endif
+}
+
+int main() {
+    std::cout << "Test Afinidad" << std::endl;
+
+    // Carga los tests
+    test_dos_sockets();
+    test_motores_fijados();
+    test_afinidad_restaurada();
+
+    // Retorna
+    return 0;
+}
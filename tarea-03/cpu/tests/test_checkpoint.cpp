@@ -0,0 +1,331 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Testea los checkpoints: guardar y cargar en todos los motores, reanudar una corrida igual a
+ * una sin cortes, la escritura atómica y el rechazo de archivos dañados.
+ */
+
+// Importación de librerías
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <dirent.h>
+#include "../checkpoint.h"
+#include "../engine.h"
+#include "../engines.h"
+
+// Archivo de los tests
+static const std::string ARCHIVO = "test_checkpoint.gol";
+
+/**
+ * Verifica si quedó algún archivo temporal del checkpoint en el directorio actual.
+ */
+bool quedanTemporales() {
+    DIR *dir = opendir(".");
+    bool quedan = false;
+    while (dirent *entrada = dir ? readdir(dir) : nullptr) {
+        std::string nombre = entrada->d_name;
+        if (nombre.compare(0, ARCHIVO.size() + 1, ARCHIVO + ".") == 0 && nombre.size() > 4 &&
+            nombre.compare(nombre.size() - 4, 4, ".tmp") == 0) {
+            quedan = true;
+        }
+    }
+    if (dir) closedir(dir);
+    return quedan;
+}
+
+/**
+ * Crea e inicializa un motor, retorna nullptr si no hay dispositivo para él.
+ */
+GOLEngine *inicializarMotor(const std::string &nombre, int N, int M, int probTrue, unsigned long long seed,
+                            Frontera frontera) {
+    GOLEngine *motor = crearMotor(nombre, 3);
+    try {
+        motor->inicializar(N, M, probTrue, seed, frontera);
+    } catch (const std::exception &) {
+        delete motor;
+        return nullptr;
+    }
+    return motor;
+}
+
+/**
+ * Testea que un checkpoint de cada motor se cargue igual en todos los demás.
+ */
+void test_ida_vuelta() {
+    Frontera fronteras[] = {FRONTERA_TOROIDAL, FRONTERA_FIJA};
+    for (Frontera f : fronteras) {
+        for (const std::string &origen : motoresDisponibles()) {
+            GOLEngine *motor = inicializarMotor(origen, 37, 130, 35, 21, f);
+            if (!motor) continue;
+            motor->avanzar(7);
+            InfoCheckpoint guardado = guardarCheckpoint(*motor, ARCHIVO, "B3/S23");
+            assert(guardado.vivas == motor->poblacion());
+            assert(!quedanTemporales());
+
+            for (const std::string &destino : motoresDisponibles()) {
+                GOLEngine *otro = crearMotor(destino, 2);
+                InfoCheckpoint info;
+                try {
+                    info = cargarCheckpoint(*otro, ARCHIVO);
+                } catch (const std::runtime_error &) {
+                    delete otro; // Sin dispositivo OpenCL
+                    continue;
+                }
+                assert(info.N == 37 && info.M == 130 && info.frontera == f);
+                assert(info.generacion == 7 && info.regla == "B3/S23");
+                assert(otro->getGeneracion() == 7);
+                assert(hashMotor(*otro) == hashMotor(*motor));
+
+                // El motor cargado también debe avanzar igual
+                motor->avanzar(3);
+                otro->avanzar(3);
+                assert(hashMotor(*otro) == hashMotor(*motor));
+                delete otro;
+                cargarCheckpoint(*motor, ARCHIVO);
+            }
+            delete motor;
+        }
+    }
+}
+
+/**
+ * Testea que una corrida cortada y reanudada termine igual que una sin cortes.
+ */
+void test_reanudar() {
+    GOLEngine *completa = inicializarMotor("bits", 200, 150, 30, 1998, FRONTERA_TOROIDAL);
+    completa->avanzar(95);
+
+    GOLEngine *cortada = inicializarMotor("simd", 200, 150, 30, 1998, FRONTERA_TOROIDAL);
+    int guardados = avanzarConCheckpoints(*cortada, 53, 20, ARCHIVO);
+    assert(guardados == 2);
+    delete cortada; // Se pierden las generaciones 41 a 53
+
+    GOLEngine *reanudada = crearMotor("threaded", 3);
+    InfoCheckpoint inicio = cargarCheckpoint(*reanudada, ARCHIVO);
+    assert(inicio.generacion == 40);
+    guardados = avanzarConCheckpoints(*reanudada, 55, 20, ARCHIVO);
+    assert(guardados == 2);
+    (void) guardados;
+    assert(reanudada->getGeneracion() == 95);
+    assert(hashMotor(*reanudada) == hashMotor(*completa));
+    InfoCheckpoint ultimo = cargarCheckpoint(*reanudada, ARCHIVO);
+    assert(ultimo.generacion == 80);
+    delete reanudada;
+    delete completa;
+}
+
+/**
+ * Testea que una corrida con otra regla se reanude igual en otro motor escalar, y que un motor
+ * que sólo usa B3/S23 rechace el checkpoint.
+ */
+void test_reanudar_regla() {
+    GOLScalar completa;
+    completa.setRegla("B36/S23");
+    completa.inicializar(60, 70, 35, 5, FRONTERA_TOROIDAL);
+    completa.avanzar(45);
+
+    GOLScalar cortada;
+    cortada.setRegla("B36/S23");
+    cortada.inicializar(60, 70, 35, 5, FRONTERA_TOROIDAL);
+    int guardados = avanzarConCheckpoints(cortada, 33, 15, ARCHIVO, "B36/S23");
+    assert(guardados == 2);
+    (void) guardados;
+
+    GOLScalar reanudada(true);
+    InfoCheckpoint inicio = cargarCheckpoint(reanudada, ARCHIVO);
+    assert(inicio.generacion == 30 && inicio.regla == "B36/S23");
+    reanudada.avanzar(15);
+    assert(hashMotor(reanudada) == hashMotor(completa));
+
+    GOLEngine *bits = crearMotor("bits");
+    bool lanzada = false;
+    try {
+        cargarCheckpoint(*bits, ARCHIVO);
+    } catch (const std::runtime_error &) {
+        lanzada = true;
+    }
+    assert(lanzada);
+    (void) lanzada;
+    delete bits;
+    remove(ARCHIVO.c_str());
+}
+
+/**
+ * Testea que un tablero disperso ocupe poco y que un tablero vacío se pueda guardar.
+ */
+void test_tamano() {
+    GOLEngine *motor = crearMotor("bits");
+    std::vector<Corrida> corridas = {{0, 1, 3}, {2000, 5000, 2}, {3999, 7990, 10}};
+    motor->cargarTablero(4000, 8000, FRONTERA_FIJA, 12, corridas);
+    InfoCheckpoint info = guardarCheckpoint(*motor, ARCHIVO);
+    assert(info.vivas == 15);
+    assert(info.bytes < 64);
+
+    GOLEngine *otro = crearMotor("scalar");
+    cargarCheckpoint(*otro, ARCHIVO);
+    bool ventana[10];
+    otro->leerVentana(3999, 7990, 1, 10, ventana);
+    assert(std::count(ventana, ventana + 10, true) == 10);
+    assert(otro->poblacion() == 15);
+    delete otro;
+
+    motor->cargarTablero(10, 10, FRONTERA_TOROIDAL, 0, std::vector<Corrida>());
+    InfoCheckpoint guardado = guardarCheckpoint(*motor, ARCHIVO);
+    InfoCheckpoint cargado = cargarCheckpoint(*motor, ARCHIVO);
+    assert(guardado.vivas == 0 && cargado.vivas == 0);
+    delete motor;
+}
+
+/**
+ * Testea que se rechacen archivos dañados, truncados o ajenos.
+ */
+void test_danados() {
+    GOLEngine *motor = inicializarMotor("bits", 30, 30, 50, 3, FRONTERA_TOROIDAL);
+    guardarCheckpoint(*motor, ARCHIVO);
+    std::ifstream infile(ARCHIVO, std::ios::binary);
+    std::string datos((std::istreambuf_iterator<char>(infile)), std::istreambuf_iterator<char>());
+    infile.close();
+
+    std::vector<std::string> casos;
+    std::string cambiado = datos;
+    cambiado[datos.size() / 2] ^= 1;
+    casos.push_back(cambiado);
+    casos.push_back(datos.substr(0, datos.size() - 3));
+    casos.push_back("no es un checkpoint");
+    for (const std::string &caso : casos) {
+        std::ofstream outfile(ARCHIVO, std::ios::binary);
+        outfile << caso;
+        outfile.close();
+        bool lanzada = false;
+        try {
+            cargarCheckpoint(*motor, ARCHIVO);
+        } catch (const std::runtime_error &) {
+            lanzada = true;
+        }
+        assert(lanzada);
+        (void) lanzada;
+    }
+    remove(ARCHIVO.c_str());
+
+    bool lanzada = false;
+    try {
+        cargarCheckpoint(*motor, ARCHIVO);
+    } catch (const std::runtime_error &) {
+        lanzada = true;
+    }
+    assert(lanzada);
+    (void) lanzada;
+    delete motor;
+}
+
+/**
+ * Testea dos escritores del mismo checkpoint a la vez: ninguno pisa el temporal del otro y el
+ * archivo final es uno de los dos tableros completo.
+ */
+void test_escritores() {
+    GOLEngine *a = inicializarMotor("bits", 300, 300, 30, 1, FRONTERA_TOROIDAL);
+    GOLEngine *b = inicializarMotor("bits", 300, 300, 60, 2, FRONTERA_TOROIDAL);
+    int fallidos[2] = {0, 0};
+    auto escribir = [](GOLEngine *motor, int *fallas) {
+        for (int k = 0; k < 30; k++) {
+            try {
+                guardarCheckpoint(*motor, ARCHIVO);
+            } catch (const std::runtime_error &) {
+                (*fallas)++;
+            }
+        }
+    };
+    std::thread hilo(escribir, a, &fallidos[0]);
+    escribir(b, &fallidos[1]);
+    hilo.join();
+    assert(fallidos[0] == 0 && fallidos[1] == 0 && !quedanTemporales());
+
+    GOLEngine *otro = crearMotor("bits");
+    InfoCheckpoint info = cargarCheckpoint(*otro, ARCHIVO);
+    assert(info.vivas == a->poblacion() || info.vivas == b->poblacion());
+    remove(ARCHIVO.c_str());
+    delete otro;
+    delete a;
+    delete b;
+}
+
+/**
+ * Escribe un checkpoint con la firma, los valores dados como enteros de largo variable y el
+ * hash correcto.
+ */
+void escribirValores(const std::vector<uint64_t> &valores) {
+    std::string datos = "GOLCKPT1";
+    for (uint64_t v : valores) {
+        while (v >= 0x80) {
+            datos += (char) (v | 0x80);
+            v >>= 7;
+        }
+        datos += (char) v;
+    }
+    uint64_t h = 14695981039346656037ULL;
+    for (char c : datos) {
+        h ^= (uint8_t) c;
+        h *= 1099511628211ULL;
+    }
+    for (int b = 0; b < 8; b++) datos += (char) (h >> (8 * b));
+    std::ofstream outfile(ARCHIVO, std::ios::binary);
+    outfile << datos;
+}
+
+/**
+ * Testea que se rechacen valores fuera de rango aunque el hash sea correcto: tamaños que no caben
+ * en un int, fronteras inexistentes y filas o corridas fuera del tablero.
+ */
+void test_fuera_de_rango() {
+    // Versión, N, M, frontera, generación, regla "B3/S23", una fila: salto, corridas, espacio y largo
+    std::vector<uint64_t> valido = {1, 10, 20, 1, 5, 6, 'B', '3', '/', 'S', '2', '3', 1, 4, 1, 2, 3};
+    std::vector<std::pair<size_t, uint64_t>> cambios = {
+        {1, 0}, {1, (1ULL << 32) + 10}, {2, (1ULL << 31)}, {3, 2}, {4, 1ULL << 63}, {12, 11}, {13, 10},
+        {13, ~0ULL}, {14, 0}, {15, 20}, {15, (1ULL << 32) + 2}, {16, 0}, {16, 20}, {16, ~0ULL - 1}};
+    GOLEngine *motor = crearMotor("bits");
+    escribirValores(valido);
+    InfoCheckpoint info = cargarCheckpoint(*motor, ARCHIVO);
+    assert(info.N == 10 && info.M == 20 && info.vivas == 3 && motor->poblacion() == 3);
+    for (const std::pair<size_t, uint64_t> &cambio : cambios) {
+        std::vector<uint64_t> valores = valido;
+        valores[cambio.first] = cambio.second;
+        escribirValores(valores);
+        bool lanzada = false;
+        try {
+            cargarCheckpoint(*motor, ARCHIVO);
+        } catch (const std::runtime_error &) {
+            lanzada = true;
+        }
+        assert(lanzada);
+        (void) lanzada;
+    }
+    remove(ARCHIVO.c_str());
+    delete motor;
+}
+
+/**
+ * Corre los tests.
+ */
+int main() {
+    std::cout << "Test Checkpoint" << std::endl;
+
+    // Carga los tests
+    test_ida_vuelta();
+    test_reanudar();
+    test_reanudar_regla();
+    test_fuera_de_rango();
+    test_escritores();
+    test_tamano();
+    test_danados();
+
+    // Retorna
+    return 0;
+}
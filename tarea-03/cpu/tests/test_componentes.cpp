@@ -0,0 +1,149 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Testea el etiquetado de componentes contra un recorrido en anchura de referencia, con
+ * distintas cantidades de hilos, y el reconocimiento de objetos en cualquier orientación.
+ */
+
+// Importación de librerías
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <string>
+#include <vector>
+#include "../componentes.h"
+#include "../GOL.h"
+#include "../rng.h"
+
+/**
+ * Etiqueta con un recorrido en anchura, retorna las componentes sin hash ordenadas por su
+ * primera celda.
+ */
+std::vector<Componente> etiquetarReferencia(const std::vector<char> &celdas, int N, int M) {
+    std::vector<int> visitada(celdas.size(), 0);
+    std::vector<Componente> componentes;
+    std::vector<int> cola;
+    for (int p = 0; p < N * M; p++) {
+        if (!celdas[p] || visitada[p]) continue;
+        Componente c = {p / M, p % M, 0, 0, 0, 0};
+        int i1 = c.i0, j0 = c.j0, j1 = c.j0;
+        cola.assign(1, p);
+        visitada[p] = 1;
+        for (size_t k = 0; k < cola.size(); k++) {
+            int i = cola[k] / M, j = cola[k] % M;
+            c.celdas++;
+            i1 = std::max(i1, i);
+            j0 = std::min(j0, j);
+            j1 = std::max(j1, j);
+            for (int a = i - 1; a <= i + 1; a++) {
+                for (int b = j - 1; b <= j + 1; b++) {
+                    if (a < 0 || b < 0 || a >= N || b >= M || !celdas[a * M + b] || visitada[a * M + b]) continue;
+                    visitada[a * M + b] = 1;
+                    cola.push_back(a * M + b);
+                }
+            }
+        }
+        c.j0 = j0;
+        c.alto = i1 - c.i0 + 1;
+        c.ancho = j1 - j0 + 1;
+        componentes.push_back(c);
+    }
+    return componentes;
+}
+
+/**
+ * Testea las componentes de tableros aleatorios con 1 a 7 hilos.
+ */
+void test_aleatorio() {
+    struct Caso {
+        int N, M, probTrue;
+    };
+    Caso casos[] = {{1, 1, 100}, {1, 50, 40}, {37, 1, 40}, {64, 64, 25}, {101, 77, 35}, {50, 200, 10}};
+    for (const Caso &caso : casos) {
+        std::vector<char> celdas((size_t) caso.N * caso.M);
+        for (size_t k = 0; k < celdas.size(); k++) celdas[k] = celdaAleatoria(77, k, caso.probTrue);
+        std::vector<Componente> esperado = etiquetarReferencia(celdas, caso.N, caso.M);
+
+        for (int hilos = 1; hilos <= 7; hilos += 2) {
+            std::vector<Componente> obtenido = etiquetarComponentes((const bool *) celdas.data(), caso.N, caso.M,
+                                                                     (size_t) caso.M, hilos);
+            assert(obtenido.size() == esperado.size());
+            for (size_t c = 0; c < esperado.size(); c++) {
+                assert(obtenido[c].i0 == esperado[c].i0 && obtenido[c].j0 == esperado[c].j0);
+                assert(obtenido[c].alto == esperado[c].alto && obtenido[c].ancho == esperado[c].ancho);
+                assert(obtenido[c].celdas == esperado[c].celdas);
+            }
+        }
+    }
+}
+
+/**
+ * Escribe una forma en el tablero, transformada por t (4 rotaciones y su reflejo).
+ */
+void escribirForma(GOL &game, const std::vector<std::string> &filas, int i0, int j0, int t) {
+    int alto = (int) filas.size(), ancho = (int) filas[0].size();
+    for (int i = 0; i < alto; i++) {
+        for (int j = 0; j < ancho; j++) {
+            if (filas[i][j] != 'O') continue;
+            int y = i, x = t >= 4 ? ancho - 1 - j : j, hh = alto, ww = ancho;
+            for (int r = 0; r < (t & 3); r++) {
+                int ny = x;
+                x = hh - 1 - y;
+                y = ny;
+                std::swap(hh, ww);
+            }
+            game.setCeldas(i0 + y, j0 + x, 1, true);
+        }
+    }
+}
+
+/**
+ * Testea el censo con objetos en las 8 orientaciones, en un tablero GOL.
+ */
+void test_censo() {
+    std::vector<std::vector<std::string>> formas = {
+            {"OO", "OO"}, {".OO.", "O..O", ".O.O", "..O."}, {"OO.", "O.O", ".O."}, {"OOO"},
+            {".O.", "..O", "OOO"}, {"OO..", "O...", "...O", "..OO"}};
+    std::string nombres[] = {"bloque", "pan", "bote", "parpadeador", "planeador", ""};
+
+    GOL game(60, 8 * 8);
+    game.setMatrizToFalse();
+    for (size_t f = 0; f < formas.size(); f++) {
+        for (int t = 0; t < 8; t++) escribirForma(game, formas[f], 1 + 10 * (int) f, 1 + 8 * t, t);
+    }
+    std::vector<Componente> componentes = etiquetarComponentes(game, 3);
+    assert(componentes.size() == 5 * 8 + 2 * 8); // La última forma son dos L de 3 celdas
+
+    // Todas las orientaciones de una forma tienen el mismo hash
+    std::map<std::string, long long> conteo = censo(componentes);
+    assert(conteo["bloque"] == 8);
+    assert(conteo["pan"] == 8);
+    assert(conteo["bote"] == 8);
+    assert(conteo["parpadeador"] == 8);
+    assert(conteo["planeador"] == 8);
+    assert(conteo["otro (3 celdas)"] == 16);
+
+    // Las dos fases de un planeador que no son rotaciones entre sí
+    GOL glider(10, 10);
+    glider.setMatrizToFalse();
+    escribirForma(glider, formas[4], 2, 2, 0);
+    for (int g = 0; g < 4; g++) {
+        std::vector<Componente> c = etiquetarComponentes(glider);
+        assert(c.size() == 1 && nombreObjeto(c[0].hash) == "planeador");
+        glider.aplicarReglas();
+    }
+}
+
+/**
+ * Corre los tests.
+ */
+int main() {
+    std::cout << "Test Componentes" << std::endl;
+
+    // Carga los tests
+    test_aleatorio();
+    test_censo();
+
+    // Retorna
+    return 0;
+}
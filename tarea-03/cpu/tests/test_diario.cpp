@@ -0,0 +1,205 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Testea el diario de cambios: retroceder y avanzar en todos los motores, partir desde un
+ * checkpoint, el costo proporcional a los cambios y reabrir un diario existente.
+ */
+
+// Importación de librerías
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../checkpoint.h"
+#include "../diario.h"
+#include "../engine.h"
+#include "../engines.h"
+
+// Archivos de los tests
+static const std::string ARCHIVO = "test_diario.gold";
+static const std::string CHECKPOINT = "test_diario.gol";
+
+/**
+ * Hash del tablero de referencia en la generación g.
+ */
+unsigned long long hashGeneracion(int N, int M, Frontera f, int g) {
+    GOLEngine *motor = crearMotor("bits");
+    motor->inicializar(N, M, 35, 1998, f);
+    motor->avanzar(g);
+    unsigned long long h = hashMotor(*motor);
+    delete motor;
+    return h;
+}
+
+/**
+ * Testea retroceder y volver a avanzar en todos los motores.
+ */
+void test_motores() {
+    Frontera fronteras[] = {FRONTERA_TOROIDAL, FRONTERA_FIJA};
+    for (Frontera f : fronteras) {
+        std::vector<unsigned long long> hashes;
+        for (int g = 0; g <= 12; g++) hashes.push_back(hashGeneracion(29, 70, f, g));
+
+        for (const std::string &nombre : motoresDisponibles()) {
+            GOLEngine *motor = crearMotor(nombre, 3);
+            try {
+                motor->inicializar(29, 70, 35, 1998, f);
+            } catch (const std::exception &) {
+                delete motor; // Sin dispositivo OpenCL
+                continue;
+            }
+            remove(ARCHIVO.c_str());
+            GOLDiario diario(ARCHIVO);
+            diario.registrar(*motor);
+            for (int g = 0; g < 12; g++) {
+                motor->avanzar(1);
+                diario.registrar(*motor);
+            }
+            assert(diario.getRegistros() == 13 && diario.getUltima() == 12);
+
+            int destinos[] = {7, 0, 12, 3, 4};
+            for (int g : destinos) {
+                diario.irA(*motor, g);
+                assert(motor->getGeneracion() == g);
+                assert(hashMotor(*motor) == hashes[g]);
+            }
+
+            // El motor sigue avanzando bien tras invertir celdas
+            motor->avanzar(8);
+            assert(hashMotor(*motor) == hashes[12]);
+            delete motor;
+        }
+    }
+}
+
+/**
+ * Testea reconstruir desde el checkpoint más cercano, hacia atrás y hacia adelante, con un
+ * diario registrado cada 2 generaciones.
+ */
+void test_checkpoint() {
+    remove(ARCHIVO.c_str());
+    GOLEngine *motor = crearMotor("simd");
+    motor->inicializar(40, 50, 35, 1998, FRONTERA_TOROIDAL);
+    GOLDiario diario(ARCHIVO);
+    diario.registrar(*motor);
+    for (int g = 0; g < 15; g++) {
+        motor->avanzar(2);
+        diario.registrar(*motor);
+        if (motor->getGeneracion() == 16) guardarCheckpoint(*motor, CHECKPOINT);
+    }
+    delete motor;
+
+    GOLEngine *otro = crearMotor("scalar");
+    cargarCheckpoint(*otro, CHECKPOINT);
+    diario.irA(*otro, 6);
+    assert(hashMotor(*otro) == hashGeneracion(40, 50, FRONTERA_TOROIDAL, 6));
+    cargarCheckpoint(*otro, CHECKPOINT);
+    diario.irA(*otro, 28);
+    assert(hashMotor(*otro) == hashGeneracion(40, 50, FRONTERA_TOROIDAL, 28));
+
+    // Generaciones que no están registradas
+    bool lanzada = false;
+    try {
+        diario.irA(*otro, 7);
+    } catch (const std::invalid_argument &) {
+        lanzada = true;
+    }
+    assert(lanzada);
+    (void) lanzada;
+    lanzada = false;
+    try {
+        diario.registrar(*otro);
+    } catch (const std::invalid_argument &) {
+        lanzada = true;
+    }
+    assert(lanzada);
+    (void) lanzada;
+    delete otro;
+    remove(CHECKPOINT.c_str());
+}
+
+/**
+ * Testea que un glider en un tablero grande ocupe poco y se reconstruya invirtiendo pocas celdas.
+ */
+void test_costo() {
+    remove(ARCHIVO.c_str());
+    std::vector<Corrida> glider = {{1, 2, 1}, {2, 3, 1}, {3, 1, 3}};
+    GOLEngine *motor = crearMotor("bits");
+    motor->cargarTablero(1000, 1000, FRONTERA_FIJA, 0, glider);
+    GOLDiario diario(ARCHIVO);
+    diario.registrar(*motor);
+    for (int g = 0; g < 40; g++) {
+        motor->avanzar(1);
+        diario.registrar(*motor);
+    }
+    assert(diario.getBytes() < 40 * 32);
+    long long invertidas = diario.irA(*motor, 0);
+    assert(invertidas <= 40 * 8);
+    (void) invertidas;
+    assert(motor->poblacion() == 5);
+    bool ventana[3 * 3];
+    motor->leerVentana(1, 1, 3, 3, ventana);
+    bool esperado[] = {0, 1, 0, 0, 0, 1, 1, 1, 1};
+    for (int k = 0; k < 9; k++) assert(ventana[k] == esperado[k]);
+    (void) esperado;
+    delete motor;
+}
+
+/**
+ * Testea reabrir un diario, continuar registrando y descartar un registro incompleto.
+ */
+void test_reabrir() {
+    remove(ARCHIVO.c_str());
+    GOLEngine *motor = crearMotor("bits");
+    motor->inicializar(30, 30, 40, 5, FRONTERA_TOROIDAL);
+    {
+        GOLDiario diario(ARCHIVO);
+        diario.registrar(*motor);
+        motor->avanzar(1);
+        diario.registrar(*motor);
+    }
+
+    // Registro cortado a la mitad, más largo que el siguiente. Sus bytes parecen registros base
+    FILE *f = fopen(ARCHIVO.c_str(), "ab");
+    const unsigned char cabeza[] = {'D', 2, 1, 0xA0, 0x8D, 0x06};
+    fwrite(cabeza, 1, sizeof(cabeza), f);
+    for (int k = 0; k < 2000; k++) fputc('B', f);
+    fclose(f);
+
+    {
+        GOLDiario diario(ARCHIVO);
+        assert(diario.getRegistros() == 2 && diario.getUltima() == 1);
+        diario.registrar(*motor); // Misma generación, continúa la cadena sin escribir
+        assert(diario.getRegistros() == 2);
+        motor->avanzar(1);
+        diario.registrar(*motor);
+        assert(diario.getRegistros() == 3);
+    }
+
+    GOLDiario diario(ARCHIVO);
+    assert(diario.getRegistros() == 3);
+    diario.irA(*motor, 0);
+    GOLEngine *inicial = crearMotor("bits");
+    inicial->inicializar(30, 30, 40, 5, FRONTERA_TOROIDAL);
+    assert(hashMotor(*motor) == hashMotor(*inicial));
+    delete inicial;
+    delete motor;
+    remove(ARCHIVO.c_str());
+}
+
+/**
+ * Corre los tests.
+ */
+int main() {
+    std::cout << "Test Diario" << std::endl;
+
+    // Carga los tests
+    test_motores();
+    test_checkpoint();
+    test_costo();
+    test_reabrir();
+
+    // Retorna
+    return 0;
+}
@@ -0,0 +1,125 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Testea el ensamble: cada serie coincide con correr el motor solo, con distintos hilos y
+ * tamaños mezclados, junto con el motor de tamaño fijo y el CSV.
+ */
+
+// Importación de librerías
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../engine.h"
+#include "../ensamble.h"
+
+/**
+ * Serie de población de una corrida hecha a mano.
+ */
+std::vector<long long> serieDirecta(const std::string &motor, int N, int probTrue, unsigned long long seed,
+                                    int gens, int cada) {
+    std::unique_ptr<GOLEngine> m(crearMotor(motor, 1));
+    m->inicializar(N, N, probTrue, seed, FRONTERA_TOROIDAL);
+    std::vector<long long> serie = {m->poblacion()};
+    for (int g = 0; g < gens; g += cada) {
+        m->avanzar(std::min(cada, gens - g));
+        serie.push_back(m->poblacion());
+    }
+    return serie;
+}
+
+/**
+ * Testea las series con varios hilos.
+ */
+void test_series() {
+    std::vector<CorridaEnsamble> base = armarEnsamble({16, 40, 23}, {0, 25, 50, 100}, 7, 3);
+    assert(base.size() == 3 * 4 * 3);
+    assert(base[0].N == 16 && base[0].probTrue == 0 && base[0].seed == 7 && base[2].seed == 9);
+
+    int hilos[] = {1, 3, 8};
+    for (int h : hilos) {
+        std::vector<CorridaEnsamble> corridas = base;
+        OpcionesEnsamble op;
+        op.gens = 37;
+        op.cada = 5;
+        op.nHilos = h;
+        op.motor = "bits";
+        long long robadas = correrEnsamble(corridas, op);
+        assert(robadas >= 0 && (h > 1 || robadas == 0));
+        (void) robadas;
+        for (const CorridaEnsamble &c : corridas) {
+            assert(c.serie.size() == 9);
+            assert(c.serie == serieDirecta("bits", c.N, c.probTrue, c.seed, 37, 5));
+            if (c.probTrue == 0) assert(c.serie.back() == 0);
+        }
+    }
+
+    // Con "fijo" cada tamaño usa su motor de tamaño fijo
+    std::vector<CorridaEnsamble> fijos = armarEnsamble({32, 64}, {30}, 1, 4);
+    OpcionesEnsamble op;
+    op.gens = 20;
+    op.motor = "fijo";
+    op.nHilos = 2;
+    correrEnsamble(fijos, op);
+    bool iguales = true;
+    for (const CorridaEnsamble &c : fijos) {
+        iguales = iguales && c.serie == serieDirecta("simd", c.N, 30, c.seed, 20, 10);
+    }
+    assert(iguales);
+    (void) iguales;
+
+    // Un tamaño sin motor fijo lanza la excepción del motor
+    std::vector<CorridaEnsamble> malos = armarEnsamble({33}, {30}, 1, 2);
+    bool lanzada = false;
+    try {
+        correrEnsamble(malos, op);
+    } catch (const std::invalid_argument &) {
+        lanzada = true;
+    }
+    assert(lanzada);
+    (void) lanzada;
+}
+
+/**
+ * Testea el CSV.
+ */
+void test_csv() {
+    std::vector<CorridaEnsamble> corridas = armarEnsamble({20}, {10, 40}, 3, 2);
+    OpcionesEnsamble op;
+    op.gens = 25;
+    op.cada = 10;
+    correrEnsamble(corridas, op);
+
+    std::string archivo = "test_ensamble.csv";
+    guardarCSVEnsamble(archivo, corridas, op.cada, op.gens);
+    std::ifstream infile(archivo);
+    std::string linea;
+    std::vector<std::string> lineas;
+    while (std::getline(infile, linea)) lineas.push_back(linea);
+    infile.close();
+    remove(archivo.c_str());
+
+    // Generaciones 0, 10, 20 y 25 por corrida
+    assert(lineas.size() == 1 + 4 * 4);
+    assert(lineas[0] == "n,prob,semilla,generacion,poblacion");
+    assert(lineas[1] == "20,10,3,0," + std::to_string(corridas[0].serie[0]));
+    assert(lineas[4] == "20,10,3,25," + std::to_string(corridas[0].serie[3]));
+    assert(lineas[16].compare(0, 11, "20,40,4,25,") == 0);
+}
+
+/**
+ * Corre los tests.
+ */
+int main() {
+    std::cout << "Test Ensamble" << std::endl;
+
+    // Carga los tests
+    test_series();
+    test_csv();
+
+    // Retorna
+    return 0;
+}
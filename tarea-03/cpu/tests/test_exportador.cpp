@@ -0,0 +1,229 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Testea la exportación a PBM, PNG y cuadros de 1 bit, el submuestreo y la exportación desde
+ * un motor.
+ */
+
+// Importación de librerías
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "../engine.h"
+#include "../exportador.h"
+
+/**
+ * Lee un archivo completo.
+ */
+std::vector<unsigned char> leerArchivo(const std::string &ruta) {
+    std::ifstream infile(ruta, std::ios::binary);
+    return std::vector<unsigned char>(std::istreambuf_iterator<char>(infile), std::istreambuf_iterator<char>());
+}
+
+/**
+ * Lee un entero big endian.
+ */
+unsigned int leerBE(const unsigned char *p) {
+    return (unsigned int) p[0] << 24 | (unsigned int) p[1] << 16 | (unsigned int) p[2] << 8 | p[3];
+}
+
+/**
+ * CRC32 de referencia, bit a bit.
+ */
+unsigned int crcReferencia(const unsigned char *p, size_t n) {
+    unsigned int c = 0xFFFFFFFFu;
+    for (size_t i = 0; i < n; i++) {
+        c ^= p[i];
+        for (int b = 0; b < 8; b++) c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+    }
+    return ~c;
+}
+
+// Tablero 3x10 con stride 12, la celda (i, j) vive si (i + j) % 3 == 0
+bool tablero[3 * 12];
+
+void crearTablero() {
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 12; j++) tablero[i * 12 + j] = j < 10 && (i + j) % 3 == 0;
+    }
+}
+
+/**
+ * Testea PBM y raw, con dos cuadros en el mismo archivo.
+ */
+void test_pbm_raw() {
+    std::string ruta = "test_exportador.pbm";
+    {
+        GOLExportador e(ruta, EXPORT_PBM);
+        bool primero = e.exportar(tablero, 3, 10, 12, 0);
+        bool segundo = e.exportar(tablero, 3, 10, 12, 1);
+        assert(primero && segundo && e.getCuadros() == 2);
+        (void) primero;
+        (void) segundo;
+    }
+    std::vector<unsigned char> pbm = leerArchivo(ruta);
+    std::string encabezado = "P4\n10 3\n";
+    assert(pbm.size() == 2 * (encabezado.size() + 3 * 2));
+    assert(std::string(pbm.begin(), pbm.begin() + encabezado.size()) == encabezado);
+
+    // Fila 0: columnas 0, 3, 6, 9 -> 1001 0010 01
+    assert(pbm[8] == 0x92 && pbm[9] == 0x40);
+    // Fila 1: columnas 2, 5, 8 -> 0010 0100 10
+    assert(pbm[10] == 0x24 && pbm[11] == 0x80);
+    remove(ruta.c_str());
+
+    // Raw, una de cada dos generaciones y una de cada dos celdas: filas 0 y 2, columnas pares
+    ruta = "test_exportador.raw";
+    {
+        GOLExportador e(ruta, EXPORT_RAW, 2, 2);
+        bool par = e.exportar(tablero, 3, 10, 12, 0);
+        bool impar = e.exportar(tablero, 3, 10, 12, 1);
+        assert(par && !impar);
+        (void) par;
+        (void) impar;
+    }
+    std::vector<unsigned char> raw = leerArchivo(ruta);
+    assert(raw.size() == 2);
+    // Columnas 0, 2, 4, 6, 8: en la fila 0 viven la 0 y la 6 (10010), en la fila 2 la 4 (00100)
+    assert(raw[0] == 0x90);
+    assert(raw[1] == 0x20);
+    remove(ruta.c_str());
+}
+
+/**
+ * Testea la estructura del PNG: firma, chunks con CRC correcto y datos sin compresión.
+ */
+void test_png() {
+    std::string ruta = "test_exportador_%03lld.png";
+    {
+        GOLExportador e(ruta, EXPORT_PNG, 5);
+        bool escrito = e.exportar(tablero, 3, 10, 12, 5);
+        assert(escrito);
+        (void) escrito;
+    }
+    std::vector<unsigned char> png = leerArchivo("test_exportador_005.png");
+    const unsigned char firma[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    assert(png.size() > 8 && std::equal(firma, firma + 8, png.begin()));
+    (void) firma;
+
+    size_t p = 8;
+    std::vector<std::string> tipos;
+    std::vector<unsigned char> idat;
+    while (p + 12 <= png.size()) {
+        unsigned int largo = leerBE(&png[p]);
+        std::string tipo(png.begin() + p + 4, png.begin() + p + 8);
+        assert(leerBE(&png[p + 8 + largo]) == crcReferencia(&png[p + 4], largo + 4));
+        if (tipo == "IHDR") {
+            assert(leerBE(&png[p + 8]) == 10 && leerBE(&png[p + 12]) == 3);
+            assert(png[p + 16] == 1 && png[p + 17] == 0);
+        }
+        if (tipo == "IDAT") idat.assign(png.begin() + p + 8, png.begin() + p + 8 + largo);
+        tipos.push_back(tipo);
+        p += 12 + largo;
+    }
+    assert(p == png.size());
+    assert(tipos.size() == 3 && tipos[0] == "IHDR" && tipos[1] == "IDAT" && tipos[2] == "IEND");
+
+    // zlib (2 bytes), un bloque final sin compresión de 9 bytes (3 filas de filtro + 2 bytes)
+    assert(idat[0] == 0x78 && idat[2] == 1 && idat[3] == 9 && idat[4] == 0);
+    // Fila 0 invertida, el relleno queda en 1
+    assert(idat[7] == 0 && idat[8] == (unsigned char) ~0x92 && idat[9] == (unsigned char) ~0x40);
+    remove("test_exportador_005.png");
+}
+
+/**
+ * Testea las rutas por cuadro: se acepta una sola conversión %lld o %d, con ancho opcional.
+ */
+void test_rutas() {
+    {
+        GOLExportador a("test_exportador_%d.raw", EXPORT_RAW);
+        GOLExportador b("test_exportador_%4lld.raw", EXPORT_RAW);
+        bool escritoA = a.exportar(tablero, 3, 10, 12, 12);
+        bool escritoB = b.exportar(tablero, 3, 10, 12, 7);
+        assert(escritoA && escritoB);
+        (void) escritoA;
+        (void) escritoB;
+    }
+    assert(leerArchivo("test_exportador_12.raw").size() == 6);
+    assert(leerArchivo("test_exportador_   7.raw").size() == 6);
+    remove("test_exportador_12.raw");
+    remove("test_exportador_   7.raw");
+
+    const char *malas[] = {"a_%s.raw", "a_%n.raw", "a_%d_%d.raw", "a_%lld%%.raw", "a_%x.raw", "a_%.raw", "a_%lu.raw",
+                           "a_%999lld.raw"};
+    for (const char *ruta : malas) {
+        bool lanzada = false;
+        try {
+            GOLExportador e(ruta, EXPORT_RAW);
+        } catch (const std::invalid_argument &) {
+            lanzada = true;
+        }
+        assert(lanzada);
+        (void) lanzada;
+    }
+}
+
+/**
+ * Testea que una escritura fallida lance std::runtime_error: disco lleno y un comando que termina
+ * sin leer su entrada (sin SIGPIPE el proceso sigue vivo).
+ */
+void test_errores() {
+#ifdef __linux__
+    std::vector<char> grande(2000 * 2000, 1);
+    const char *rutas[] = {"/dev/full", "|true"};
+    for (const char *ruta : rutas) {
+        bool lanzada = false;
+        try {
+            GOLExportador e(ruta, EXPORT_PBM);
+            for (int k = 0; k < 4; k++) e.exportar((const bool *) grande.data(), 2000, 2000, 2000, k);
+        } catch (const std::runtime_error &) {
+            lanzada = true;
+        }
+        assert(lanzada);
+        (void) lanzada;
+    }
+#endif
+}
+
+/**
+ * Testea que exportar desde un motor sea igual que desde sus celdas.
+ */
+void test_motor() {
+    GOLEngine *motor = crearMotor("bits");
+    motor->inicializar(37, 45, 40, 8);
+    motor->avanzar(3);
+    std::vector<char> celdas(37 * 45);
+    motor->leerVentana(0, 0, 37, 45, (bool *) celdas.data());
+    {
+        GOLExportador a("test_motor_a.raw", EXPORT_RAW, 1, 3);
+        GOLExportador b("test_motor_b.raw", EXPORT_RAW, 1, 3);
+        bool escritoA = a.exportar(*motor);
+        bool escritoB = b.exportar((const bool *) celdas.data(), 37, 45, 45, 3);
+        assert(escritoA && escritoB);
+        (void) escritoA;
+        (void) escritoB;
+    }
+    std::vector<unsigned char> ra = leerArchivo("test_motor_a.raw"), rb = leerArchivo("test_motor_b.raw");
+    assert(ra.size() == 13 * 2 && ra == rb);
+    remove("test_motor_a.raw");
+    remove("test_motor_b.raw");
+    delete motor;
+}
+
+int main() {
+    std::cout << "Test Exportador" << std::endl;
+
+    // Carga los tests
+    crearTablero();
+    test_pbm_raw();
+    test_png();
+    test_rutas();
+    test_errores();
+    test_motor();
+
+    // Retorna
+    return 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Testea el flujo de generaciones con corrutinas: cada vista coincide con avanzar el motor
+ * directamente, con y sin adelantar el siguiente paso, y sin copias en los motores de bytes.
+ */
+
+// Importación de librerías
+#include <iostream>
+#include <cassert>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../engine.h"
+#include "../generaciones.h"
+
+/**
+ * Compara cada vista contra un motor de referencia avanzado a mano.
+ */
+void test_vistas() {
+    const char *nombres[] = {"scalar", "inplace", "simd", "threaded", "bits", "tiled"};
+    bool modos[] = {false, true};
+    for (const char *nombre : nombres) {
+        for (bool adelantar : modos) {
+            std::unique_ptr<GOLEngine> motor(crearMotor(nombre, 2));
+            std::unique_ptr<GOLEngine> referencia(crearMotor(nombre, 2));
+            motor->inicializar(37, 45, 35, 17, FRONTERA_TOROIDAL);
+            referencia->inicializar(37, 45, 35, 17, FRONTERA_TOROIDAL);
+
+            std::vector<bool> celdas(37 * 45);
+            bool fila[45];
+            int vistas = 0;
+            for (const VistaTablero &vista : generaciones(*motor, 3, 5, adelantar)) {
+                (void) vista;
+                referencia->avanzar(3);
+                assert(vista.getGeneracion() == referencia->getGeneracion());
+                assert(vista.getFilas() == 37 && vista.getColumnas() == 45);
+                assert(vista.poblacion() == referencia->poblacion());
+                for (int i = 0; i < 37; i++) {
+                    referencia->leerVentana(i, 0, 1, 45, fila);
+                    for (int j = 0; j < 45; j++) assert(vista.getCelda(i, j) == fila[j]);
+                }
+
+                // Sin adelantar, los motores de bytes no copian el tablero
+                if (!adelantar && motor->filaDirecta(0)) assert(vista.fila(5) == motor->filaDirecta(5));
+                vistas++;
+            }
+            assert(vistas == 5 && motor->getGeneracion() == 15);
+        }
+    }
+}
+
+/**
+ * Testea salir del recorrido antes de terminar: el paso adelantado termina antes de destruir el
+ * flujo y el motor sigue usable.
+ */
+void test_salida_temprana() {
+    bool modos[] = {false, true};
+    for (bool adelantar : modos) {
+        std::unique_ptr<GOLEngine> motor(crearMotor("simd"));
+        motor->inicializar(64, 64, 30, 5, FRONTERA_FIJA);
+        {
+            int vistas = 0;
+            for (const VistaTablero &vista : generaciones(*motor, 4, 0, adelantar)) {
+                (void) vista;
+                assert(vista.getGeneracion() == 4 * (vistas + 1));
+                if (++vistas == 3) break;
+            }
+        }
+        assert(motor->getGeneracion() == (adelantar ? 16 : 12));
+        motor->avanzar(1);
+    }
+
+    // Un flujo que no se recorre no avanza el motor
+    std::unique_ptr<GOLEngine> motor(crearMotor("simd"));
+    motor->inicializar(16, 16, 30, 5, FRONTERA_FIJA);
+    {
+        FlujoGeneraciones flujo = generaciones(*motor, 4, 3);
+    }
+    assert(motor->getGeneracion() == 0);
+}
+
+/**
+ * Corre los tests.
+ */
+int main() {
+    std::cout << "Test Generaciones" << std::endl;
+
+    // Carga los tests
+    test_vistas();
+    test_salida_temprana();
+
+    // Retorna
+    return 0;
+}
@@ -0,0 +1,340 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Testea todos los motores de crearMotor: el tablero tras k generaciones se compara contra una
+ * implementación de referencia, junto con las ventanas, la población y las estadísticas.
+ */
+
+// Importación de librerías
+#include <iostream>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../engine.h"
+#include "../engines.h"
+#include "../fijo.h"
+#include "../rng.h"
+
+#ifdef GOL_MMAP
+#include <unistd.h>
+#endif
+
+// Tablero de referencia sin filas fantasmas, toroidal o con borde muerto
+struct Referencia {
+    int N, M;
+    std::vector<char> celdas;
+    bool toroidal;
+
+    bool getCelda(int i, int j) const { return celdas[i * M + j] != 0; }
+};
+
+/**
+ * Crea la referencia con el generador de rng.h.
+ */
+Referencia crearReferencia(int N, int M, int probTrue, unsigned long long seed, bool toroidal) {
+    Referencia r = {N, M, std::vector<char>((size_t) N * M), toroidal};
+    for (int i = 0; i < N * M; i++) {
+        r.celdas[i] = celdaAleatoria(seed, (unsigned long long) i, probTrue);
+    }
+    return r;
+}
+
+/**
+ * Avanza la referencia una generación con la definición directa de las reglas.
+ */
+void avanzarReferencia(Referencia &r) {
+    std::vector<char> nueva(r.celdas.size());
+    for (int i = 0; i < r.N; i++) {
+        for (int j = 0; j < r.M; j++) {
+            int vivos = 0;
+            for (int k = -1; k < 2; k++) {
+                for (int p = -1; p < 2; p++) {
+                    if (k == 0 && p == 0) continue;
+                    int a = i + k, b = j + p;
+                    if (r.toroidal) {
+                        vivos += r.celdas[((a + r.N) % r.N) * r.M + (b + r.M) % r.M];
+                    } else if (a >= 0 && a < r.N && b >= 0 && b < r.M) {
+                        vivos += r.celdas[a * r.M + b];
+                    }
+                }
+            }
+            nueva[i * r.M + j] = (vivos == 3 || (vivos == 2 && r.celdas[i * r.M + j])) ? 1 : 0;
+        }
+    }
+    r.celdas.swap(nueva);
+}
+
+/**
+ * Hash de la referencia, igual a hashMotor.
+ */
+unsigned long long hashReferencia(const Referencia &r) {
+    unsigned long long h = 14695981039346656037ULL;
+    for (char c : r.celdas) {
+        h ^= c ? 1 : 0;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/**
+ * Crea e inicializa un motor, retorna nullptr si no hay dispositivo para él.
+ */
+GOLEngine *inicializarMotor(const std::string &nombre, int N, int M, int probTrue, unsigned long long seed,
+                            Frontera frontera) {
+    GOLEngine *motor = crearMotor(nombre, 3);
+    try {
+        motor->inicializar(N, M, probTrue, seed, frontera);
+    } catch (const std::runtime_error &) {
+        delete motor;
+        return nullptr;
+    } catch (const std::invalid_argument &) {
+        delete motor;
+        return nullptr;
+    }
+    return motor;
+}
+
+/**
+ * Testea que todos los motores entreguen el mismo tablero, en ambas fronteras.
+ */
+void test_equivalencia() {
+    struct Caso {
+        int N, M, probTrue, gens;
+        unsigned long long seed;
+    };
+    Caso casos[] = {{16, 16, 50, 8, 1998}, {17, 23, 35, 12, 7}, {64, 70, 20, 30, 42}, {3, 5, 60, 4, 1},
+                    {100, 37, 50, 17, 1985}, {5, 130, 45, 9, 3}};
+    Frontera fronteras[] = {FRONTERA_TOROIDAL, FRONTERA_FIJA};
+
+    for (const Caso &c : casos) {
+        for (Frontera f : fronteras) {
+            Referencia r = crearReferencia(c.N, c.M, c.probTrue, c.seed, f == FRONTERA_TOROIDAL);
+            for (int g = 0; g < c.gens; g++) avanzarReferencia(r);
+            unsigned long long esperado = hashReferencia(r);
+
+            for (const std::string &nombre : motoresDisponibles()) {
+                GOLEngine *motor = inicializarMotor(nombre, c.N, c.M, c.probTrue, c.seed, f);
+                if (!motor) continue;
+                motor->avanzar(c.gens);
+                if (hashMotor(*motor) != esperado) {
+                    std::cout << "Motor " << nombre << " difiere en " << c.N << "x" << c.M << std::endl;
+                }
+                assert(hashMotor(*motor) == esperado);
+                delete motor;
+            }
+        }
+    }
+}
+
+/**
+ * Testea leerVentana y poblacion en todos los motores.
+ */
+void test_ventana_poblacion() {
+    Referencia r = crearReferencia(40, 90, 30, 5, true);
+    for (int g = 0; g < 3; g++) avanzarReferencia(r);
+    long long vivas = 0;
+    for (char c : r.celdas) vivas += c;
+
+    for (const std::string &nombre : motoresDisponibles()) {
+        GOLEngine *motor = inicializarMotor(nombre, 40, 90, 30, 5, FRONTERA_TOROIDAL);
+        if (!motor) continue;
+        motor->avanzar(1);
+        motor->avanzar(2);
+        assert(motor->poblacion() == vivas);
+
+        bool ventana[7 * 70];
+        motor->leerVentana(30, 15, 7, 70, ventana);
+        for (int i = 0; i < 7; i++) {
+            for (int j = 0; j < 70; j++) {
+                assert(ventana[i * 70 + j] == r.getCelda(30 + i, 15 + j));
+            }
+        }
+        delete motor;
+    }
+}
+
+/**
+ * Testea las estadísticas y la fábrica.
+ */
+void test_estadisticas() {
+    for (const std::string &nombre : motoresDisponibles()) {
+        GOLEngine *motor = inicializarMotor(nombre, 32, 32, 50, 1998, FRONTERA_TOROIDAL);
+        if (!motor) continue;
+        assert(motor->nombre() == nombre);
+        motor->avanzar(10);
+        GOLStats s = motor->estadisticas();
+        assert(s.generacion == 10);
+        assert(s.poblacion == motor->poblacion());
+        assert(s.memoria >= 2 * 32 * 32 / 8);
+        assert(s.tiempo >= 0);
+        (void) s;
+        delete motor;
+    }
+
+    // El modo en sitio usa cerca de la mitad de la memoria del escalar
+    GOLEngine *escalar = inicializarMotor("scalar", 256, 256, 50, 1998, FRONTERA_TOROIDAL);
+    GOLEngine *enSitio = inicializarMotor("inplace", 256, 256, 50, 1998, FRONTERA_TOROIDAL);
+    assert(enSitio->estadisticas().memoria < escalar->estadisticas().memoria * 6 / 10);
+    delete escalar;
+    delete enSitio;
+
+    bool lanzada = false;
+    try {
+        crearMotor("no-existe");
+    } catch (const std::invalid_argument &) {
+        lanzada = true;
+    }
+    assert(lanzada);
+    (void) lanzada;
+}
+
+/**
+ * Corre los tests.
+ */
+/**
+ * Testea el motor halo con distintos k, incluyendo rondas incompletas y halos más anchos que
+ * las bandas.
+ */
+void test_halos() {
+    int ks[] = {1, 3, 7, 20};
+    Frontera fronteras[] = {FRONTERA_TOROIDAL, FRONTERA_FIJA};
+    for (int k : ks) {
+        for (Frontera f : fronteras) {
+            Referencia r = crearReferencia(13, 40, 40, 77, f == FRONTERA_TOROIDAL);
+            for (int g = 0; g < 23; g++) avanzarReferencia(r);
+            GOLEngine *motor = inicializarMotor("halo-" + std::to_string(k), 13, 40, 40, 77, f);
+            motor->avanzar(10);
+            motor->avanzar(13);
+            assert(hashMotor(*motor) == hashReferencia(r));
+            delete motor;
+        }
+    }
+
+    // k y el lado de las teselas deben ser enteros positivos
+    const char *malos[] = {"halo-0", "halo-abc", "halo-", "halo-3x", "halo--2", "halo- 4", "halo-99999999999",
+                           "tiled-0", "tiled-x", "tiled-", "tiled-8.5"};
+    for (const char *nombre : malos) {
+        bool lanzada = false;
+        try {
+            delete crearMotor(nombre);
+        } catch (const std::invalid_argument &) {
+            lanzada = true;
+        }
+        assert(lanzada);
+        (void) lanzada;
+    }
+}
+
+/**
+ * Testea el motor wavefront con más hilos que núcleos, las bandas quedan desfasadas.
+ */
+void test_wavefront() {
+    Frontera fronteras[] = {FRONTERA_TOROIDAL, FRONTERA_FIJA};
+    for (Frontera f : fronteras) {
+        Referencia r = crearReferencia(50, 61, 35, 11, f == FRONTERA_TOROIDAL);
+        for (int g = 0; g < 201; g++) avanzarReferencia(r);
+        GOLEngine *motor = crearMotor("wavefront", 8);
+        motor->inicializar(50, 61, 35, 11, f);
+        motor->avanzar(201);
+        assert(hashMotor(*motor) == hashReferencia(r));
+        delete motor;
+    }
+}
+
+/**
+ * Testea el motor por teselas con teselas chicas, tableros que no son múltiplo del lado y
+ * corridas que cruzan teselas.
+ */
+void test_teselas() {
+    int lados[] = {8, 13, 64};
+    Frontera fronteras[] = {FRONTERA_TOROIDAL, FRONTERA_FIJA};
+    for (int lado : lados) {
+        for (Frontera f : fronteras) {
+            Referencia r = crearReferencia(45, 70, 40, 21, f == FRONTERA_TOROIDAL);
+            for (int g = 0; g < 19; g++) avanzarReferencia(r);
+            GOLEngine *motor = inicializarMotor("tiled-" + std::to_string(lado), 45, 70, 40, 21, f);
+            motor->avanzar(19);
+            assert(hashMotor(*motor) == hashReferencia(r));
+            delete motor;
+        }
+    }
+
+    // Un deslizador que cruza varias teselas de 8 vuelve a su forma tras 4 generaciones
+    GOLEngine *motor = crearMotor("tiled-8");
+    std::vector<Corrida> corridas = {{5, 7, 1}, {6, 8, 1}, {7, 6, 3}};
+    motor->cargarTablero(20, 20, FRONTERA_TOROIDAL, 0, corridas);
+    motor->avanzar(4 * 20);
+    bool ventana[3 * 3];
+    motor->leerVentana(5, 6, 3, 3, ventana);
+    assert(!ventana[0] && ventana[1] && !ventana[2] && !ventana[3] && !ventana[4] && ventana[5]);
+    assert(ventana[6] && ventana[7] && ventana[8] && motor->poblacion() == 5);
+    delete motor;
+}
+
+/**
+ * Testea el motor de tamaño fijo declarado en la pila y desde la fábrica, y que rechace
+ * tableros de otro tamaño.
+ */
+void test_fijo() {
+    Frontera fronteras[] = {FRONTERA_TOROIDAL, FRONTERA_FIJA};
+    for (Frontera f : fronteras) {
+        Referencia r = crearReferencia(37, 45, 35, 13, f == FRONTERA_TOROIDAL);
+        for (int g = 0; g < 29; g++) avanzarReferencia(r);
+        GOLFijo<37, 45> motor;
+        motor.inicializar(37, 45, 35, 13, f);
+        motor.avanzar(29);
+        assert(motor.nombre() == "fijo-37x45" && hashMotor(motor) == hashReferencia(r));
+    }
+
+    GOLEngine *motor = inicializarMotor("fijo-64", 64, 64, 30, 2, FRONTERA_TOROIDAL);
+    GOLEngine *simd = inicializarMotor("simd", 64, 64, 30, 2, FRONTERA_TOROIDAL);
+    motor->avanzar(50);
+    simd->avanzar(50);
+    assert(hashMotor(*motor) == hashMotor(*simd) && motor->poblacion() == simd->poblacion());
+    GOLEngine *distinto = inicializarMotor("fijo-64", 64, 65, 30, 2, FRONTERA_TOROIDAL);
+    assert(distinto == nullptr);
+    delete distinto;
+    delete motor;
+    delete simd;
+}
+
+#ifdef GOL_MMAP
+
+/**
+ * Testea que el motor mmap alterne entre sus dos archivos y los borre al terminar.
+ */
+void test_archivos_mmap() {
+    GOLMmap *motor = new GOLMmap();
+    motor->inicializar(70, 130, 40, 9, FRONTERA_TOROIDAL);
+    std::string inicial = motor->getArchivo();
+    assert(access(inicial.c_str(), F_OK) == 0);
+    motor->avanzar(1);
+    std::string siguiente = motor->getArchivo();
+    assert(siguiente != inicial);
+    motor->avanzar(1);
+    assert(motor->getArchivo() == inicial);
+    delete motor;
+    assert(access(inicial.c_str(), F_OK) != 0);
+    assert(access(siguiente.c_str(), F_OK) != 0);
+}
+
+#endif
+
+int main() {
+    std::cout << "Test Motores" << std::endl;
+
+    // Carga los tests
+    test_equivalencia();
+    test_ventana_poblacion();
+    test_estadisticas();
+    test_halos();
+    test_wavefront();
+    test_teselas();
+    test_fijo();
+#ifdef GOL_MMAP
+    test_archivos_mmap();
+#endif
+
+    // Retorna
+    return 0;
+}
@@ -0,0 +1,174 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Testea la carga de patrones RLE, .cells y Life 1.06 en cualquier posición, y que guardar y
+ * volver a cargar un RLE entregue el mismo tablero.
+ */
+
+// Importación de librerías
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "../GOL.h"
+#include "../patrones.h"
+
+/**
+ * Escribe un archivo de texto.
+ */
+void escribirArchivo(const std::string &ruta, const std::string &texto) {
+    std::ofstream outfile(ruta, std::ios::binary);
+    outfile << texto;
+    outfile.close();
+}
+
+/**
+ * Crea un tablero vacío.
+ */
+GOL *tableroVacio(int N, int M) {
+    GOL *game = new GOL(N, M);
+    game->setMatrizToFalse();
+    return game;
+}
+
+/**
+ * Verifica que el tablero tenga el glider en (i0, j0) y nada más.
+ */
+void verificarGlider(const GOL &game, int i0, int j0) {
+    // .O.
+    // ..O
+    // OOO
+    bool glider = game.contarPoblacion() == 5 && game.getCelda(i0, j0 + 1) && game.getCelda(i0 + 1, j0 + 2) &&
+                  game.getCelda(i0 + 2, j0) && game.getCelda(i0 + 2, j0 + 1) && game.getCelda(i0 + 2, j0 + 2);
+    assert(glider);
+    (void) glider;
+}
+
+/**
+ * Testea los tres formatos con el mismo glider.
+ */
+void test_formatos() {
+    escribirArchivo("glider.rle", "#N Glider\n#C comentario\nx = 3, y = 3, rule = B3/S23\nbob$2bo$3o!\n");
+    escribirArchivo("glider.cells", "!Name: Glider\n!\n.O.\r\n..O\r\nOOO\r\n");
+    escribirArchivo("glider.lif", "#Life 1.06\n1 0\n2 1\n0 2\n1 2\n2 2\n");
+
+    const char *archivos[] = {"glider.rle", "glider.cells", "glider.lif"};
+    FormatoPatron formatos[] = {PATRON_RLE, PATRON_CELLS, PATRON_LIFE106};
+    for (int k = 0; k < 3; k++) {
+        GOL *game = tableroVacio(20, 30);
+        InfoPatron info = cargarPatron(*game, archivos[k], 5, 11);
+        assert(info.formato == formatos[k]);
+        assert(info.filas == 3 && info.columnas == 3);
+        assert(info.vivas == 5 && info.fuera == 0);
+        verificarGlider(*game, 5, 11);
+        delete game;
+        remove(archivos[k]);
+    }
+    (void) formatos;
+}
+
+/**
+ * Testea la cabecera, corridas largas con saltos múltiples y el recorte al borde.
+ */
+void test_rle() {
+    escribirArchivo("linea.rle", "x = 40, y = 4, rule = B36/S23\n40o3$\n5b\n3o!");
+    GOL *game = tableroVacio(10, 20);
+    InfoPatron info = cargarPatron(*game, "linea.rle", 2, 4);
+    assert(info.regla == "B36/S23");
+    assert(info.filas == 4 && info.columnas == 40);
+    assert(info.vivas == 43);
+
+    // De la fila de 40 sólo caben 16 celdas, la corrida de 3 queda en la fila 5
+    assert(info.fuera == 24);
+    assert(game->contarPoblacion() == 19);
+    assert(game->getCelda(2, 19) && !game->getCelda(2, 3));
+    assert(game->getCelda(5, 9) && game->getCelda(5, 11) && !game->getCelda(5, 12));
+    delete game;
+    remove("linea.rle");
+
+    // Las celdas muertas explícitas sobrescriben el tablero
+    escribirArchivo("muertas.rle", "x = 3, y = 1\n3b!");
+    game = tableroVacio(4, 4);
+    game->setCeldas(0, 0, 4, true);
+    cargarPatron(*game, "muertas.rle", 0, 1);
+    assert(game->contarPoblacion() == 1 && game->getCelda(0, 0));
+    delete game;
+    remove("muertas.rle");
+
+    bool lanzada = false;
+    try {
+        game = tableroVacio(4, 4);
+        cargarPatron(*game, "no-existe.rle");
+    } catch (const std::runtime_error &) {
+        lanzada = true;
+    }
+    delete game;
+    assert(lanzada);
+    (void) lanzada;
+}
+
+/**
+ * Testea archivos con coordenadas enormes: las celdas quedan fuera y nada desborda.
+ */
+void test_coordenadas_enormes() {
+    escribirArchivo("enorme.rle", "x = 99999999999, y = 3\n2147483647o2147483647o2147483647o$2147483647$"
+                                  "2147483647$o!");
+    GOL *game = tableroVacio(6, 8);
+    InfoPatron info = cargarPatron(*game, "enorme.rle", 2, 3);
+    assert(info.columnas == 2147483647 && info.filas == 3);
+    assert(info.vivas == 3LL * 2147483647 + 1 && info.fuera == info.vivas - 5);
+    assert(game->contarPoblacion() == 5 && game->getCelda(2, 7) && !game->getCelda(3, 3));
+    delete game;
+    remove("enorme.rle");
+
+    escribirArchivo("enorme.lif", "#Life 1.06\n1 1\n9223372036854775807 0\n0 -9223372036854775807\n"
+                                  "2147483647 2147483647\n");
+    game = tableroVacio(6, 8);
+    info = cargarPatron(*game, "enorme.lif", 2, 3);
+    assert(info.vivas == 4 && info.fuera == 3 && info.filas == 2147483647 && info.columnas == 2147483647);
+    assert(game->contarPoblacion() == 1 && game->getCelda(3, 4));
+    delete game;
+    remove("enorme.lif");
+}
+
+/**
+ * Testea que guardar y cargar un tablero aleatorio lo deje igual.
+ */
+void test_guardar() {
+    GOL *original = tableroVacio(57, 133);
+    original->inicializarMatrizRandom(30, 1998);
+    original->setCeldas(10, 0, 133, false);
+    original->setCeldas(11, 0, 133, false);
+    guardarRLE(*original, "guardado.rle");
+
+    // Ninguna línea supera los 70 caracteres
+    std::ifstream infile("guardado.rle");
+    std::string linea;
+    std::getline(infile, linea);
+    assert(linea == "x = 133, y = 57, rule = B3/S23");
+    while (std::getline(infile, linea)) assert(linea.size() <= 70);
+    infile.close();
+
+    GOL *copia = tableroVacio(57, 133);
+    InfoPatron info = cargarPatron(*copia, "guardado.rle");
+    assert(info.vivas == original->contarPoblacion());
+    for (int i = 0; i < 57; i++) {
+        for (int j = 0; j < 133; j++) assert(copia->getCelda(i, j) == original->getCelda(i, j));
+    }
+    delete original;
+    delete copia;
+    remove("guardado.rle");
+}
+
+int main() {
+    std::cout << "Test Patrones" << std::endl;
+
+    // Carga los tests
+    test_formatos();
+    test_rle();
+    test_coordenadas_enormes();
+    test_guardar();
+
+    // Retorna
+    return 0;
+}
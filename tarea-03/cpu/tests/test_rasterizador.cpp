@@ -0,0 +1,134 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Testea el rasterizado de polígonos: cada celda contra Polygon::in_poly (par-impar) y contra
+ * el número de vueltas (distinto de cero), con varios hilos, transformaciones y recortes.
+ */
+
+// Importación de librerías
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include "../rasterizador.h"
+#include "../rng.h"
+
+/**
+ * Número de vueltas de un polígono alrededor de un punto.
+ */
+int vueltas(const Polygon<double> &poly, double x, double y) {
+    int w = 0, n = poly.size();
+    for (int k = 0; k < n; k++) {
+        Point<double> p = poly.get_point(k), q = poly.get_point((k + 1) % n);
+        double px = p.get_coord_x(), py = p.get_coord_y(), qx = q.get_coord_x(), qy = q.get_coord_y();
+        if ((py > y) == (qy > y)) continue;
+        double xc = (qx - px) * (y - py) / (qy - py) + px;
+        if (x < xc) w += qy > py ? 1 : -1;
+    }
+    return w;
+}
+
+/**
+ * Agrega a poly n puntos aleatorios dentro de [x0, x0 + ancho) x [y0, y0 + alto), en general el
+ * polígono se corta a sí mismo.
+ */
+void poligonoAleatorio(Polygon<double> &poly, unsigned long long seed, int n, double x0, double y0, double ancho,
+                       double alto) {
+    for (int k = 0; k < n; k++) {
+        double u = (double) (mezclarSplitMix(seed + 2 * k) >> 11) / 9007199254740992.0;
+        double v = (double) (mezclarSplitMix(seed + 2 * k + 1) >> 11) / 9007199254740992.0;
+        poly.add_point(Point<double>(x0 + u * ancho, y0 + v * alto));
+    }
+}
+
+/**
+ * Compara el rasterizado de polígonos aleatorios contra la definición, celda por celda.
+ */
+void test_reglas() {
+    int hilos[] = {1, 3, 7};
+    ReglaRelleno reglas[] = {RELLENO_PAR_IMPAR, RELLENO_NO_CERO};
+    for (unsigned long long seed = 1; seed <= 6; seed++) {
+        Polygon<double> poly;
+        poligonoAleatorio(poly, 100 * seed, 5 + 7 * (int) seed, -10, -5, 100, 80);
+        for (ReglaRelleno regla : reglas) {
+            for (int h : hilos) {
+                GOL game(60, 80);
+                game.setMatrizToFalse();
+                long long escritas = rasterizarPoligono(game, poly, Transformacion(), regla, true, h);
+                assert(escritas == game.contarPoblacion());
+                (void) escritas;
+                for (int i = 0; i < 60; i++) {
+                    for (int j = 0; j < 80; j++) {
+                        Point<double> centro(j + 0.5, i + 0.5);
+                        bool dentro = regla == RELLENO_PAR_IMPAR ? poly.in_poly(centro)
+                                                                 : vueltas(poly, j + 0.5, i + 0.5) != 0;
+                        assert(game.getCelda(i, j) == dentro);
+                        (void) dentro;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Testea transformaciones, recortes y borrado.
+ */
+void test_transformaciones() {
+    Point<double> cuadrado[] = {Point<double>(0, 0), Point<double>(10, 0), Point<double>(10, 10),
+                                Point<double>(0, 10)};
+    Polygon<double> poly = Polygon<double>(cuadrado, 4);
+
+    // Escala 2 desde (5, 5): centros en [5, 25) x [5, 25)
+    GOL game(40, 40);
+    game.setMatrizToFalse();
+    long long escritas = rasterizarPoligono(game, poly, Transformacion::similitud(2, 0, 5, 5));
+    assert(escritas == 400);
+    assert(game.getCelda(5, 5) && game.getCelda(24, 24) && !game.getCelda(25, 24) && !game.getCelda(4, 10));
+
+    // Un agujero con valor falso y la tabla de sumas queda al día
+    game.activarSumas(true);
+    assert(game.contarRegion(0, 0, 40, 40) == 400);
+    escritas = rasterizarPoligono(game, poly, Transformacion::similitud(0.5, 0, 10, 10), RELLENO_PAR_IMPAR, false);
+    assert(escritas == 25);
+    (void) escritas;
+    assert(game.contarRegion(0, 0, 40, 40) == 375 && !game.getCelda(12, 12));
+
+    // Rotado en 45 grados el área se mantiene salvo el borde
+    game.setMatrizToFalse();
+    rasterizarPoligono(game, poly, Transformacion::similitud(2, M_PI / 4, 20, 2));
+    long long vivas = game.contarPoblacion();
+    assert(vivas > 370 && vivas < 430);
+    (void) vivas;
+
+    // Recorte por todos los lados y polígonos fuera del tablero
+    game.setMatrizToFalse();
+    Polygon<double> vacio;
+    long long recortes[] = {rasterizarPoligono(game, poly, Transformacion::similitud(6, 0, -10, -10)),
+                            rasterizarPoligono(game, poly, Transformacion::similitud(1, 0, 50, 0)),
+                            rasterizarPoligono(game, poly, Transformacion::similitud(1, 0, 0, -20)),
+                            rasterizarPoligono(game, vacio)};
+    assert(recortes[0] == 40 * 40 && recortes[1] == 0 && recortes[2] == 0 && recortes[3] == 0);
+    (void) recortes;
+
+    // Muy lejos del tablero las filas se acotan antes de convertirlas a int
+    game.setMatrizToFalse();
+    long long lejos[] = {rasterizarPoligono(game, poly, Transformacion::similitud(1, 0, 0, 1e20)),
+                         rasterizarPoligono(game, poly, Transformacion::similitud(1, 0, 0, -1e20)),
+                         rasterizarPoligono(game, poly, Transformacion::similitud(1e20, 0, 0, 0))};
+    assert(lejos[0] == 0 && lejos[1] == 0 && lejos[2] == 40 * 40);
+    (void) lejos;
+}
+
+/**
+ * Corre los tests.
+ */
+int main() {
+    std::cout << "Test Rasterizador" << std::endl;
+
+    // Carga los tests
+    test_reglas();
+    test_transformaciones();
+
+    // Retorna
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Testea el dibujo del tablero: el modo texto sin reducir igual a printGrid, y la reducción por
+ * densidad y con medios bloques.
+ */
+
+// Importación de librerías
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include "../render.h"
+
+/**
+ * Retorna el cuadro como texto.
+ */
+std::string cuadro(const GOLRender &r) {
+    return std::string(r.getCuadro(), r.getLargo());
+}
+
+/**
+ * Testea el modo texto sin reducir, con un stride mayor al ancho.
+ */
+void test_texto() {
+    // Tablero 2x3 dentro de una matriz con columnas fantasmas
+    bool celdas[] = {0, 1, 0, 0, 0,
+                     0, 0, 0, 1, 0};
+    GOLRender r;
+    r.dibujar(celdas + 1, 2, 3, 5);
+    assert(cuadro(r) == " O  .  . \n .  .  O \n");
+
+    r.setVolverInicio(true);
+    r.dibujar(celdas + 1, 2, 3, 5);
+    assert(cuadro(r) == "\x1B[H O  .  . \n .  .  O \n");
+}
+
+/**
+ * Testea la reducción por densidad: un tablero 4x8 en 2 filas y 4 columnas, bloques de 2x2.
+ */
+void test_densidad() {
+    std::vector<char> tablero(4 * 8, 0);
+    for (int j = 0; j < 8; j++) tablero[j] = 1;     // Primera fila viva
+    for (int i = 2; i < 4; i++) {
+        tablero[i * 8 + 6] = tablero[i * 8 + 7] = 1; // Último bloque de abajo lleno
+    }
+    GOLRender r(RENDER_DENSIDAD, 2, 4);
+    r.dibujar((const bool *) tablero.data(), 4, 8, 8);
+
+    // Bloques a la mitad usan el nivel 5 ('+'), llenos '@' y vacíos ' '
+    assert(cuadro(r) == "++++\n   @\n");
+}
+
+/**
+ * Testea los medios bloques: 4 filas de bloques en 2 filas de texto.
+ */
+void test_bloques() {
+    bool tablero[] = {1, 0, 1,
+                      0, 0, 1,
+                      0, 1, 0,
+                      0, 0, 0};
+    GOLRender r(RENDER_BLOQUES, 2, 3);
+    r.dibujar(tablero, 4, 3, 3);
+    assert(cuadro(r) == "\xE2\x96\x80 \xE2\x96\x88\n \xE2\x96\x80 \n");
+
+    // El buffer se reutiliza al dibujar un cuadro más chico
+    r.configurar(RENDER_TEXTO, 0, 0);
+    r.dibujar(tablero, 1, 1, 3);
+    assert(cuadro(r) == " O \n");
+}
+
+int main() {
+    std::cout << "Test Render" << std::endl;
+
+    // Carga los tests
+    test_texto();
+    test_densidad();
+    test_bloques();
+
+    // Retorna
+    return 0;
+}
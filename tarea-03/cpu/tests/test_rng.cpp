@@ -0,0 +1,68 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Testea el generador basado en contador y la inicialización aleatoria del tablero.
+ */
+
+// Importación de librerías
+#include <iostream>
+#include <cassert>
+#include "../GOL.h"
+#include "../rng.h"
+
+/**
+ * Testea que el generador sólo dependa de la semilla y el índice.
+ */
+void test_determinismo() {
+    for (unsigned long long i = 0; i < 1000; i++) {
+        assert(celdaAleatoria(1998, i, 50) == celdaAleatoria(1998, i, 50));
+    }
+    assert(!celdaAleatoria(1998, 7, 0));
+    assert(celdaAleatoria(1998, 7, 100));
+}
+
+/**
+ * Testea que la densidad obtenida se acerque a la probabilidad pedida.
+ */
+void test_densidad() {
+    int probs[] = {10, 50, 90};
+    for (int p : probs) {
+        int vivas = 0;
+        for (unsigned long long i = 0; i < 100000; i++) {
+            if (celdaAleatoria(42, i, p)) vivas++;
+        }
+        assert(vivas > (p - 1) * 1000 && vivas < (p + 1) * 1000);
+    }
+}
+
+/**
+ * Testea que el tablero no dependa de la cantidad de hilos y que coincida con el generador.
+ */
+void test_tablero_paralelo() {
+    GOL a = GOL(37, 53);
+    GOL b = GOL(37, 53);
+    a.setMatrizToFalse();
+    b.setMatrizToFalse();
+    a.inicializarMatrizRandom(30, 1998, 1);
+    b.inicializarMatrizRandom(30, 1998, 4);
+    for (int i = 0; i < 37; i++) {
+        for (int j = 0; j < 53; j++) {
+            assert(a.getCelda(i, j) == b.getCelda(i, j));
+            assert(a.getCelda(i, j) == celdaAleatoria(1998, (unsigned long long) i * 53 + j, 30));
+        }
+    }
+}
+
+/**
+ * Corre los tests.
+ */
+int main() {
+    std::cout << "Test RNG" << std::endl;
+
+    // Carga los tests
+    test_determinismo();
+    test_densidad();
+    test_tablero_paralelo();
+
+    // Retorna
+    return 0;
+}
@@ -0,0 +1,261 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Testea el servidor de simulaciones: resultados iguales a correr el motor directo, reglas,
+ * salidas, control de admisión, cancelación al cerrar la conexión y apagado.
+ */
+
+// Importación de librerías
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../checkpoint.h"
+#include "../engines.h"
+#include "../servidor.h"
+
+/**
+ * Abre una conexión y envía una línea sin esperar las respuestas.
+ */
+int conectar(const std::string &ruta, const std::string &linea) {
+    sockaddr_un dir;
+    memset(&dir, 0, sizeof(dir));
+    dir.sun_family = AF_UNIX;
+    strcpy(dir.sun_path, ruta.c_str());
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    int conectado = connect(fd, (sockaddr *) &dir, sizeof(dir));
+    assert(conectado == 0);
+    (void) conectado;
+    std::string texto = linea + "\n";
+    ssize_t enviados = send(fd, texto.data(), texto.size(), 0);
+    assert(enviados == (ssize_t) texto.size());
+    (void) enviados;
+    return fd;
+}
+
+/**
+ * Lee una línea de respuesta.
+ */
+std::string leerRespuesta(int fd) {
+    std::string linea;
+    char c;
+    while (recv(fd, &c, 1, 0) == 1 && c != '\n') linea += c;
+    return linea;
+}
+
+/**
+ * Hash esperado con el formato del servidor.
+ */
+std::string hashEsperado(GOLEngine &motor) {
+    char texto[32];
+    snprintf(texto, sizeof(texto), "hash=%016llx", hashMotor(motor));
+    return texto;
+}
+
+/**
+ * Testea la lectura de trabajos.
+ */
+void test_leer_trabajo() {
+    TrabajoServidor t = leerTrabajo("n=20 m=30 prob=40 seed=9 gens=50 cada=5 motor=bits frontera=fija regla=B36/S23");
+    assert(t.N == 20 && t.M == 30 && t.probTrue == 40 && t.seed == 9 && t.gens == 50 && t.cada == 5);
+    assert(t.motor == "bits" && t.frontera == FRONTERA_FIJA && t.regla == "B36/S23");
+    const char *malos[] = {"n=0", "prob=101", "gens=-1", "n=12x", "frontera=esferica", "color=rojo", "n",
+                           "imagen=|touch${IFS}/tmp/x", "checkpoint=/tmp/x", "checkpoint=../x", "imagen=a/../../x.png",
+                           "imagen=..", "imagen=x_%d.png", "checkpoint=a\\b", "checkpoint=", "n=2147483647",
+                           "n=100000 m=100000"};
+    for (const char *linea : malos) {
+        bool lanzada = false;
+        try {
+            leerTrabajo(linea);
+        } catch (const std::invalid_argument &) {
+            lanzada = true;
+        }
+        assert(lanzada);
+        (void) lanzada;
+    }
+}
+
+/**
+ * Testea trabajos completos contra los motores corridos directamente.
+ */
+void test_trabajos(const std::string &ruta, const std::string &salidas) {
+    std::vector<std::string> r = enviarComando(ruta, "trabajo n=64 m=80 prob=35 seed=7 gens=100 cada=25 motor=simd");
+    assert(r.size() == 7);
+    assert(r[0].compare(0, 9, "aceptado ") == 0 && r[1].compare(0, 7, "inicio ") == 0);
+    assert(r[2].compare(0, 16, "progreso gen=25 ") == 0 && r[5].compare(0, 17, "progreso gen=100 ") == 0);
+    GOLEngine *motor = crearMotor("simd");
+    motor->inicializar(64, 80, 35, 7, FRONTERA_TOROIDAL);
+    motor->avanzar(100);
+    assert(r[6].compare(0, 12, "fin gen=100 ") == 0 && r[6].find(hashEsperado(*motor)) != std::string::npos);
+    delete motor;
+
+    // Regla distinta con el motor escalar, el mismo trabajador reutiliza el motor
+    for (int k = 0; k < 2; k++) {
+        r = enviarComando(ruta, "trabajo n=40 m=40 seed=3 gens=30 motor=scalar frontera=fija regla=B36/S23");
+        GOLScalar escalar;
+        escalar.setRegla("B36/S23");
+        escalar.inicializar(40, 40, 30, 3, FRONTERA_FIJA);
+        escalar.avanzar(30);
+        assert(r.back().find(hashEsperado(escalar)) != std::string::npos);
+    }
+    r = enviarComando(ruta, "trabajo n=40 m=40 gens=30 motor=scalar");
+    GOLScalar clasico;
+    clasico.inicializar(40, 40, 30, 1998, FRONTERA_TOROIDAL);
+    clasico.avanzar(30);
+    assert(r.back().find(hashEsperado(clasico)) != std::string::npos);
+
+    // Errores
+    r = enviarComando(ruta, "trabajo n=40 m=40 gens=30 motor=simd regla=B36/S23");
+    assert(r.back().compare(0, 6, "error ") == 0);
+    r = enviarComando(ruta, "trabajo motor=no-existe");
+    assert(r.back().compare(0, 6, "error ") == 0);
+    r = enviarComando(ruta, "trabajo n=0");
+    assert(r.size() == 1 && r[0].compare(0, 6, "error ") == 0);
+    r = enviarComando(ruta, "saludar");
+    assert(r.size() == 1 && r[0].compare(0, 6, "error ") == 0);
+
+    // Salidas, dentro del directorio de salidas
+    std::string archivo = "test_servidor.ckpt";
+    r = enviarComando(ruta, "trabajo n=50 m=60 seed=11 gens=40 motor=bits checkpoint=" + archivo);
+    GOLEngine *cargado = crearMotor("bits");
+    InfoCheckpoint info = cargarCheckpoint(*cargado, salidas + "/" + archivo);
+    assert(info.generacion == 40 && r.back().find(hashEsperado(*cargado)) != std::string::npos);
+    delete cargado;
+    remove((salidas + "/" + archivo).c_str());
+
+    // Un cliente no puede ejecutar comandos ni escribir fuera del directorio
+    r = enviarComando(ruta, "trabajo n=10 m=10 gens=1 imagen=|touch${IFS}test_servidor_pipe");
+    assert(r.size() == 1 && r[0].compare(0, 6, "error ") == 0);
+    r = enviarComando(ruta, "trabajo n=10 m=10 gens=1 checkpoint=../test_servidor_fuera.ckpt");
+    assert(r.size() == 1 && r[0].compare(0, 6, "error ") == 0);
+    assert(access("test_servidor_pipe", F_OK) != 0 && access("test_servidor_fuera.ckpt", F_OK) != 0);
+}
+
+/**
+ * Testea el control de admisión y la cancelación: con un trabajador y cola de uno el tercer
+ * trabajo largo se rechaza, y cerrar la conexión cancela el trabajo en curso.
+ */
+void test_admision(const std::string &ruta) {
+    std::string largo = "trabajo n=600 m=600 gens=100000000 cada=1 motor=simd";
+    // Sin directorio de salidas se rechazan los trabajos que las piden
+    std::vector<std::string> r = enviarComando(ruta, "trabajo n=10 m=10 gens=1 checkpoint=x.ckpt");
+    assert(r.size() == 1 && r[0].compare(0, 6, "error ") == 0);
+
+    int a = conectar(ruta, largo);
+    std::string respuesta = leerRespuesta(a);
+    assert(respuesta.compare(0, 9, "aceptado ") == 0);
+    int b = conectar(ruta, largo);
+    respuesta = leerRespuesta(b);
+    assert(respuesta.compare(0, 9, "aceptado ") == 0);
+    r = enviarComando(ruta, largo);
+    assert(r.size() == 1 && r[0] == "rechazado cola llena");
+
+    // El trabajador nota la conexión cerrada al enviar el siguiente progreso
+    close(a);
+    close(b);
+    for (int k = 0; k < 500; k++) {
+        r = enviarComando(ruta, "estado");
+        if (r[0].find("activos=0 cola=0") != std::string::npos) break;
+        usleep(10000);
+    }
+    r = enviarComando(ruta, "trabajo n=10 m=10 gens=5");
+    assert(r.back().compare(0, 4, "fin ") == 0);
+    r = enviarComando(ruta, "estado");
+    assert(r.size() == 1 && r[0].find("activos=0 cola=0 completados=1 rechazados=1 cancelados=2 fallidos=0") != std::string::npos);
+}
+
+/**
+ * Testea que un trabajo con "cada" enorme se cancele al cerrar la conexión, sin esperar al
+ * siguiente progreso, y que un cliente que sólo cierra su lado de escritura siga recibiendo.
+ */
+void test_desconexion(const std::string &ruta) {
+    int fd = conectar(ruta, "trabajo n=1000 m=1000 gens=2000000000 cada=2000000000 motor=simd");
+    std::string aceptado = leerRespuesta(fd), iniciado = leerRespuesta(fd);
+    assert(aceptado.compare(0, 9, "aceptado ") == 0 && iniciado.compare(0, 7, "inicio ") == 0);
+    close(fd);
+    std::vector<std::string> r;
+    for (int k = 0; k < 3000; k++) {
+        r = enviarComando(ruta, "estado");
+        if (r[0].find("activos=0 cola=0") != std::string::npos) break;
+        usleep(10000);
+    }
+    assert(r[0].find("activos=0 cola=0 completados=0 rechazados=0 cancelados=1") != std::string::npos);
+
+    fd = conectar(ruta, "trabajo n=100 m=100 gens=2000 cada=1000 motor=simd");
+    shutdown(fd, SHUT_WR);
+    std::string respuesta, ultima;
+    while (!(respuesta = leerRespuesta(fd)).empty()) ultima = respuesta;
+    assert(ultima.compare(0, 9, "fin gen=2") == 0);
+    close(fd);
+}
+
+/**
+ * Testea que un cliente que no envía su comando no frene a los demás y que detener cancele un
+ * trabajo que no terminaría nunca.
+ */
+void test_apagado(GOLServidor &servidor, const std::string &ruta) {
+    sockaddr_un dir;
+    memset(&dir, 0, sizeof(dir));
+    dir.sun_family = AF_UNIX;
+    strcpy(dir.sun_path, ruta.c_str());
+    int lento = socket(AF_UNIX, SOCK_STREAM, 0);
+    int conectado = connect(lento, (sockaddr *) &dir, sizeof(dir));
+    assert(conectado == 0);
+    (void) conectado;
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    std::vector<std::string> r = enviarComando(ruta, "estado");
+    assert(r.size() == 1 && r[0].compare(0, 7, "estado ") == 0);
+    assert(std::chrono::steady_clock::now() - inicio < std::chrono::seconds(2));
+
+    int fd = conectar(ruta, "trabajo n=1000 m=1000 gens=2000000000 motor=simd");
+    std::string aceptado = leerRespuesta(fd), iniciado = leerRespuesta(fd);
+    assert(aceptado.compare(0, 9, "aceptado ") == 0 && iniciado.compare(0, 7, "inicio ") == 0);
+    inicio = std::chrono::steady_clock::now();
+    servidor.detener();
+    assert(std::chrono::steady_clock::now() - inicio < std::chrono::seconds(30));
+    std::string respuesta = leerRespuesta(fd);
+    assert(respuesta == "error servidor apagado");
+    close(fd);
+    close(lento);
+}
+
+/**
+ * Corre los tests.
+ */
+int main() {
+    std::cout << "Test Servidor" << std::endl;
+
+    // Carga los tests
+    test_leer_trabajo();
+    std::string ruta = "/tmp/test_servidor_" + std::to_string(getpid()) + ".sock";
+    std::string salidas = "test_servidor_salidas";
+    {
+        GOLServidor servidor(ruta, 2, 4, 1, salidas);
+        servidor.iniciar();
+        test_trabajos(ruta, salidas);
+        std::vector<std::string> r = enviarComando(ruta, "apagar");
+        assert(r.size() == 1 && r[0] == "apagando");
+        servidor.esperar();
+    }
+    {
+        GOLServidor servidor(ruta, 1, 1);
+        servidor.iniciar();
+        test_admision(ruta);
+    }
+    {
+        GOLServidor servidor(ruta, 1, 1);
+        servidor.iniciar();
+        test_desconexion(ruta);
+        test_apagado(servidor, ruta);
+    }
+    assert(access(ruta.c_str(), F_OK) != 0);
+    rmdir(salidas.c_str());
+
+    // Retorna
+    return 0;
+}
@@ -0,0 +1,128 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Testea la tabla de sumas acumuladas de GOL: conteo de rectángulos tras avanzar, en sitio con
+ * varias bandas y tras modificar celdas, junto con el mapa de densidad y su exportación.
+ */
+
+// Importación de librerías
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "../GOL.h"
+#include "../exportador.h"
+#include "../rng.h"
+
+/**
+ * Cuenta las celdas vivas de un rectángulo recorriendo el tablero.
+ */
+long long contarDirecto(const GOL &game, int i0, int j0, int alto, int ancho) {
+    long long vivas = 0;
+    for (int i = i0; i < i0 + alto; i++) {
+        for (int j = j0; j < j0 + ancho; j++) {
+            if (i >= 0 && j >= 0 && i < game.getFilas() && j < game.getColumnas()) vivas += game.getCelda(i, j);
+        }
+    }
+    return vivas;
+}
+
+/**
+ * Compara contarRegion contra el conteo directo en rectángulos aleatorios, incluyendo algunos
+ * que salen del tablero.
+ */
+void verificarRegiones(GOL &game, unsigned long long seed) {
+    int N = game.getFilas(), M = game.getColumnas();
+    int distintas = 0;
+    for (unsigned long long k = 0; k < 300; k++) {
+        int i0 = (int) (mezclarSplitMix(seed + 4 * k) % (N + 4)) - 2;
+        int j0 = (int) (mezclarSplitMix(seed + 4 * k + 1) % (M + 4)) - 2;
+        int alto = (int) (mezclarSplitMix(seed + 4 * k + 2) % (N + 1));
+        int ancho = (int) (mezclarSplitMix(seed + 4 * k + 3) % (M + 1));
+        if (game.contarRegion(i0, j0, alto, ancho) != contarDirecto(game, i0, j0, alto, ancho)) distintas++;
+    }
+    long long total = game.contarRegion(0, 0, N, M);
+    assert(distintas == 0 && total == game.contarPoblacion());
+    (void) distintas;
+    (void) total;
+}
+
+/**
+ * Testea la tabla armada al aplicar las reglas, con una matriz y en sitio con varias bandas.
+ */
+void test_avanzar() {
+    bool modos[] = {false, true};
+    for (bool enSitio : modos) {
+        GOL game(53, 71, enSitio, 4);
+        game.setMatrizToFalse();
+        game.setFrontera(FRONTERA_TOROIDAL);
+        game.inicializarMatrizRandom(35, 1998);
+        game.activarSumas(true);
+        verificarRegiones(game, 1); // Se arma desde la matriz
+        for (int g = 0; g < 5; g++) {
+            game.aplicarReglas();
+            verificarRegiones(game, 100 + g);
+        }
+
+        // Cambiar celdas invalida la tabla
+        game.setCeldas(10, 0, 71, true);
+        verificarRegiones(game, 7);
+        game.aplicarReglas();
+        verificarRegiones(game, 8);
+
+        // Sin tabla se recorre la matriz
+        game.activarSumas(false);
+        verificarRegiones(game, 9);
+    }
+}
+
+/**
+ * Testea el mapa de densidad y su exportación a PGM.
+ */
+void test_mapa() {
+    GOL game(40, 60);
+    game.setMatrizToFalse();
+    game.setCeldas(0, 0, 30, true); // Mitad de la primera fila
+    for (int i = 20; i < 40; i++) game.setCeldas(i, 30, 30, true); // Cuadrante inferior derecho
+    game.activarSumas(true);
+
+    uint8_t mapa[2 * 2];
+    game.mapaDensidad(0, 0, 40, 60, 2, 2, mapa);
+    assert(mapa[0] == 255 * 30 / 600 && mapa[1] == 0);
+    assert(mapa[2] == 0 && mapa[3] == 255);
+
+    // Zoom a una ventana más chica que el mapa, cada celda ocupa varios valores
+    uint8_t zoom[4 * 4];
+    game.mapaDensidad(19, 29, 2, 2, 4, 4, zoom);
+    uint8_t esperado[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 255, 255, 0, 0, 255, 255};
+    for (int k = 0; k < 16; k++) assert(zoom[k] == esperado[k]);
+    (void) esperado;
+
+    std::string ruta = "test_sumas.pgm";
+    guardarMapaDensidad(ruta, mapa, 2, 2);
+    std::ifstream infile(ruta, std::ios::binary);
+    std::string datos((std::istreambuf_iterator<char>(infile)), std::istreambuf_iterator<char>());
+    infile.close();
+    std::string cabecera = "P5\n2 2\n255\n";
+    assert(datos.size() == cabecera.size() + 4);
+    assert(datos.compare(0, cabecera.size(), cabecera) == 0);
+    assert((uint8_t) datos[cabecera.size() + 3] == 0); // Lleno es negro
+    assert((uint8_t) datos[cabecera.size() + 1] == 255);
+    remove(ruta.c_str());
+}
+
+/**
+ * Corre los tests.
+ */
+int main() {
+    std::cout << "Test Sumas" << std::endl;
+
+    // Carga los tests
+    test_avanzar();
+    test_mapa();
+
+    // Retorna
+    return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Testea las vecindades y reglas de GOL contra una referencia directa: Moore, von Neumann,
+ * hexagonal y máscaras arbitrarias, con una matriz y en sitio, en ambas fronteras.
+ */
+
+// Importación de librerías
+#include <iostream>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../GOL.h"
+
+// Caso de prueba: máscara de filas pares e impares y regla
+struct CasoVecindad {
+    int mascaraPar, mascaraImpar;
+    int nacer, sobrevivir;
+};
+
+/**
+ * Avanza una generación de la referencia, la paridad se cuenta desde la primera fila.
+ */
+std::vector<char> avanzarReferencia(const std::vector<char> &celdas, int N, int M, bool toroidal,
+                                    const CasoVecindad &c) {
+    std::vector<char> nueva(celdas.size());
+    for (int i = 0; i < N; i++) {
+        int mascara = i & 1 ? c.mascaraImpar : c.mascaraPar;
+        for (int j = 0; j < M; j++) {
+            int vivos = 0;
+            for (int k = -1; k < 2; k++) {
+                for (int p = -1; p < 2; p++) {
+                    if ((k == 0 && p == 0) || !(mascara >> (3 * (k + 1) + p + 1) & 1)) continue;
+                    int a = i + k, b = j + p;
+                    if (toroidal) {
+                        vivos += celdas[((a + N) % N) * M + (b + M) % M];
+                    } else if (a >= 0 && a < N && b >= 0 && b < M) {
+                        vivos += celdas[a * M + b];
+                    }
+                }
+            }
+            int reglas = celdas[i * M + j] ? c.sobrevivir : c.nacer;
+            nueva[i * M + j] = (char) (reglas >> vivos & 1);
+        }
+    }
+    return nueva;
+}
+
+/**
+ * Compara GOL contra la referencia para un caso, con una matriz y en sitio.
+ */
+void verificarCaso(const CasoVecindad &c, int N, int M, Frontera frontera, bool hexagonal) {
+    bool modos[] = {false, true};
+    for (bool enSitio : modos) {
+        GOL game(N, M, enSitio, 3);
+        game.setMatrizToFalse();
+        game.setFrontera(frontera);
+        game.inicializarMatrizRandom(40, 1998);
+        if (hexagonal) game.setVecindad(VECINDAD_HEXAGONAL);
+        else game.setMascaraVecinos(c.mascaraPar);
+        game.setRegla(c.nacer, c.sobrevivir);
+
+        std::vector<char> celdas((size_t) N * M);
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j < M; j++) celdas[i * M + j] = game.getCelda(i, j);
+        }
+        for (int g = 0; g < 12; g++) {
+            game.aplicarReglas();
+            celdas = avanzarReferencia(celdas, N, M, frontera == FRONTERA_TOROIDAL, c);
+        }
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j < M; j++) assert(game.getCelda(i, j) == (celdas[i * M + j] != 0));
+        }
+    }
+}
+
+/**
+ * Testea las vecindades con nombre y máscaras arbitrarias.
+ */
+void test_vecindades() {
+    int b3 = 1 << 3, s23 = 1 << 2 | 1 << 3;
+    CasoVecindad casos[] = {{MASCARA_MOORE, MASCARA_MOORE, b3, s23},
+                            {MASCARA_MOORE, MASCARA_MOORE, 1 << 3 | 1 << 6, s23},
+                            {MASCARA_MOORE, MASCARA_MOORE, 1 << 2, 0},
+                            {MASCARA_VON_NEUMANN, MASCARA_VON_NEUMANN, 1 << 1 | 1 << 3, 1 << 1 | 1 << 2 | 1 << 4},
+                            {0x1C7, 0x1C7, 1 << 2, 1 << 2 | 1 << 3},
+                            {0x0AF, 0x0AF, 1 << 1 | 1 << 3, 1 << 0 | 1 << 2},
+                            {0x155, 0x155, 1 << 1, 1 << 1 | 1 << 2},
+                            {0x000, 0x000, 1 << 0, 0}};
+    Frontera fronteras[] = {FRONTERA_TOROIDAL, FRONTERA_FIJA};
+    for (const CasoVecindad &c : casos) {
+        for (Frontera f : fronteras) verificarCaso(c, 21, 34, f, false);
+    }
+
+    // Hexagonal, con frontera toroidal N debe ser par
+    CasoVecindad hex = {MASCARA_HEX_PAR, MASCARA_HEX_IMPAR, 1 << 2, 1 << 3 | 1 << 4};
+    verificarCaso(hex, 22, 31, FRONTERA_TOROIDAL, true);
+    verificarCaso(hex, 23, 31, FRONTERA_FIJA, true);
+
+    // Volver a Moore deja el juego original
+    GOL game(10, 10);
+    game.setVecindad(VECINDAD_VON_NEUMANN);
+    game.setVecindad(VECINDAD_MOORE);
+    game.setMatrizToFalse();
+    game.setCeldas(4, 3, 3, true);
+    game.aplicarReglas();
+    assert(game.getCelda(3, 4) && game.getCelda(4, 4) && game.getCelda(5, 4) && !game.getCelda(4, 3));
+}
+
+/**
+ * Testea el formato B/S de las reglas.
+ */
+void test_reglas_texto() {
+    GOL a(30, 30), b(30, 30);
+    a.setMatrizToFalse();
+    b.setMatrizToFalse();
+    a.inicializarMatrizRandom(40, 7);
+    b.inicializarMatrizRandom(40, 7);
+    a.setRegla("b36/s23");
+    b.setRegla(1 << 3 | 1 << 6, 1 << 2 | 1 << 3);
+    for (int g = 0; g < 5; g++) {
+        a.aplicarReglas();
+        b.aplicarReglas();
+    }
+    for (int i = 0; i < 30; i++) {
+        for (int j = 0; j < 30; j++) assert(a.getCelda(i, j) == b.getCelda(i, j));
+    }
+
+    a.setRegla("S23/B3");
+    a.setRegla("B2/S");
+    const char *malas[] = {"", "B3", "B3/S29", "B3/S23/B1", "C3/S23", "B3S23x"};
+    for (const char *regla : malas) {
+        bool lanzada = false;
+        try {
+            a.setRegla(regla);
+        } catch (const std::invalid_argument &) {
+            lanzada = true;
+        }
+        assert(lanzada);
+        (void) lanzada;
+    }
+}
+
+/**
+ * Corre los tests.
+ */
+int main() {
+    std::cout << "Test Vecindades" << std::endl;
+
+    // Carga los tests
+    test_vecindades();
+    test_reglas_texto();
+
+    // Retorna
+    return 0;
+}
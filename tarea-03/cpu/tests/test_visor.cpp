@@ -0,0 +1,85 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Testea el triple buffer del visor: el lector siempre ve cuadros completos y cada vez más
+ * nuevos, sin que el escritor espere.
+ */
+
+// Importación de librerías
+#include <iostream>
+#include <cassert>
+#include <thread>
+#include "../visor.h"
+
+/**
+ * Testea el intercambio con un solo hilo.
+ */
+void test_intercambio() {
+    TripleBuffer b(4);
+    bool vacio = b.tomar();
+    assert(!vacio);
+
+    b.reservar()[0] = true;
+    b.publicar(1);
+    bool primero = b.tomar();
+    assert(primero);
+    assert(b.getGeneracion() == 1);
+    assert(b.getLectura()[0]);
+    bool repetido = b.tomar();
+    assert(!repetido);
+
+    // Sólo se ve el último de varios cuadros publicados
+    for (int g = 2; g <= 5; g++) {
+        bool *cuadro = b.reservar();
+        for (int k = 0; k < 4; k++) cuadro[k] = g % 2 == 1;
+        b.publicar(g);
+    }
+    bool ultimo = b.tomar();
+    assert(ultimo);
+    assert(b.getGeneracion() == 5);
+    for (int k = 0; k < 4; k++) assert(b.getLectura()[k]);
+    (void) vacio;
+    (void) primero;
+    (void) repetido;
+    (void) ultimo;
+}
+
+/**
+ * Testea un escritor y un lector concurrentes, cada cuadro tiene todas sus celdas iguales.
+ */
+void test_concurrente() {
+    const size_t celdas = 4096;
+    const long long total = 20000;
+    TripleBuffer b(celdas);
+
+    std::thread escritor([&b, celdas, total]() {
+        for (long long g = 1; g <= total; g++) {
+            bool *cuadro = b.reservar();
+            for (size_t k = 0; k < celdas; k++) cuadro[k] = g % 2 == 1;
+            b.publicar(g);
+        }
+    });
+
+    long long ultima = 0;
+    while (ultima < total) {
+        if (!b.tomar()) {
+            std::this_thread::yield();
+            continue;
+        }
+        long long g = b.getGeneracion();
+        assert(g > ultima);
+        for (size_t k = 0; k < celdas; k++) assert(b.getLectura()[k] == (g % 2 == 1));
+        ultima = g;
+    }
+    escritor.join();
+}
+
+int main() {
+    std::cout << "Test Visor" << std::endl;
+
+    // Carga los tests
+    test_intercambio();
+    test_concurrente();
+
+    // Retorna
+    return 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Visor en un hilo aparte con triple buffer.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include "visor.h"
+
+// Bit del índice intermedio que indica un cuadro nuevo
+#define CUADRO_NUEVO 4
+#define CUADRO_INDICE 3
+
+/**
+ * Constructor.
+ *
+ * @param celdas Celdas por cuadro
+ */
+TripleBuffer::TripleBuffer(size_t celdas) : intermedio(1) {
+    this->celdas = celdas;
+    for (int k = 0; k < 3; k++) {
+        cuadros[k].reset(new bool[celdas]());
+        generaciones[k] = -1;
+    }
+    escritura = 0;
+    lectura = 2;
+}
+
+/**
+ * Cuadro que puede llenar el escritor.
+ */
+bool *TripleBuffer::reservar() {
+    return cuadros[escritura].get();
+}
+
+/**
+ * Publica el cuadro reservado intercambiándolo con el intermedio.
+ *
+ * @param generacion Generación del cuadro
+ */
+void TripleBuffer::publicar(long long generacion) {
+    generaciones[escritura] = generacion;
+    escritura = intermedio.exchange(escritura | CUADRO_NUEVO, std::memory_order_acq_rel) & CUADRO_INDICE;
+}
+
+/**
+ * Toma el último cuadro publicado.
+ *
+ * @return Verdadero si había un cuadro nuevo
+ */
+bool TripleBuffer::tomar() {
+    if (!(intermedio.load(std::memory_order_acquire) & CUADRO_NUEVO)) return false;
+    lectura = intermedio.exchange(lectura, std::memory_order_acq_rel) & CUADRO_INDICE;
+    return true;
+}
+
+/**
+ * Cuadro tomado por el lector.
+ */
+const bool *TripleBuffer::getLectura() const {
+    return cuadros[lectura].get();
+}
+
+/**
+ * Generación del cuadro tomado por el lector.
+ */
+long long TripleBuffer::getGeneracion() const {
+    return generaciones[lectura];
+}
+
+/**
+ * Celdas por cuadro.
+ */
+size_t TripleBuffer::getCeldas() const {
+    return celdas;
+}
+
+/**
+ * Constructor, lanza el hilo del visor.
+ *
+ * @param N Número de filas
+ * @param M Número de columnas
+ * @param periodo Milisegundos entre cuadros
+ * @param modo Forma de dibujar las celdas
+ * @param filas Filas máximas de texto
+ * @param columnas Columnas máximas de texto
+ */
+GOLVisor::GOLVisor(int N, int M, int periodo, ModoRender modo, int filas, int columnas)
+        : buffer((size_t) N * M), pedido(true), terminar(false) {
+    this->N = N;
+    this->M = M;
+    this->periodo = periodo;
+
+    // Se deja una fila para el encabezado
+    if (filas == 0 || columnas == 0) {
+        int filasTerminal, columnasTerminal;
+        tamanoTerminal(filasTerminal, columnasTerminal);
+        if (filas == 0) filas = filasTerminal - 1;
+        if (columnas == 0) columnas = columnasTerminal;
+    }
+    render.configurar(modo, filas, columnas);
+    render.setVolverInicio(true);
+    hilo = std::thread(&GOLVisor::dibujar, this);
+}
+
+/**
+ * Destructor.
+ */
+GOLVisor::~GOLVisor() {
+    terminar.store(true);
+    hilo.join();
+}
+
+/**
+ * Ciclo del visor, dibuja el último cuadro publicado cada periodo.
+ */
+void GOLVisor::dibujar() {
+    char encabezado[64];
+    while (!terminar.load()) {
+        if (buffer.tomar()) {
+            snprintf(encabezado, sizeof(encabezado), "Generacion %lld", buffer.getGeneracion());
+            render.dibujar(buffer.getLectura(), N, M, (size_t) M, encabezado);
+            render.emitir();
+            pedido.store(true, std::memory_order_release);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(periodo));
+    }
+}
+
+/**
+ * Indica si el visor espera un cuadro.
+ */
+bool GOLVisor::quiereCuadro() const {
+    return pedido.load(std::memory_order_acquire);
+}
+
+/**
+ * Cuadro que debe llenar la simulación.
+ */
+bool *GOLVisor::reservar() {
+    return buffer.reservar();
+}
+
+/**
+ * Publica el cuadro reservado.
+ *
+ * @param generacion Generación del cuadro
+ */
+void GOLVisor::publicar(long long generacion) {
+    pedido.store(false, std::memory_order_relaxed);
+    buffer.publicar(generacion);
+}
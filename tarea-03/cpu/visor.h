@@ -0,0 +1,106 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Visor en un hilo aparte: la simulación publica cuadros en un triple buffer sin esperar y el
+ * visor dibuja el último cuadro a su propio ritmo.
+ */
+
+#ifndef GAMEOFLIFECPU_VISOR_H
+#define GAMEOFLIFECPU_VISOR_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include "render.h"
+
+/**
+ * Triple buffer sin bloqueos para un escritor y un lector. El escritor llena su cuadro y lo
+ * intercambia con el intermedio; el lector intercambia el suyo con el intermedio sólo si hay un
+ * cuadro nuevo. Ninguno espera al otro y el lector siempre ve un cuadro completo.
+ */
+class TripleBuffer {
+private:
+
+    // Cuadros y la generación de cada uno
+    std::unique_ptr<bool[]> cuadros[3];
+    long long generaciones[3];
+    size_t celdas;
+
+    // Índice del cuadro intermedio, con el bit NUEVO si el escritor publicó después de la última lectura
+    std::atomic<int> intermedio;
+
+    // Cuadros de cada lado, sólo los usa su dueño
+    int escritura;
+    int lectura;
+
+public:
+
+    // Constructor, cuadros de celdas elementos
+    explicit TripleBuffer(size_t celdas);
+
+    // Cuadro que puede llenar el escritor
+    bool *reservar();
+
+    // Publica el cuadro reservado, el escritor pasa a otro cuadro
+    void publicar(long long generacion);
+
+    // Toma el último cuadro publicado, retorna falso si no hay uno nuevo
+    bool tomar();
+
+    // Cuadro tomado por el lector y su generación
+    const bool *getLectura() const;
+
+    long long getGeneracion() const;
+
+    size_t getCeldas() const;
+
+};
+
+class GOLVisor {
+private:
+
+    // Dimensiones del tablero
+    int N;
+    int M;
+
+    // Milisegundos entre cuadros
+    int periodo;
+
+    TripleBuffer buffer;
+    GOLRender render;
+
+    // El visor terminó de dibujar y espera otro cuadro
+    std::atomic<bool> pedido;
+    std::atomic<bool> terminar;
+    std::thread hilo;
+
+    // Ciclo del hilo del visor
+    void dibujar();
+
+public:
+
+    /* Constructor, lanza el hilo del visor.
+     *
+     * @Param N: Número de filas.
+     * @Param M: Número de columnas.
+     * @Param periodo: Milisegundos entre cuadros.
+     * @Param modo: Forma de dibujar las celdas.
+     * @Param filas: Filas máximas de texto, 0 usa el tamaño de la terminal.
+     * @Param columnas: Columnas máximas de texto, 0 usa el tamaño de la terminal.
+     */
+    GOLVisor(int N, int M, int periodo = 100, ModoRender modo = RENDER_DENSIDAD, int filas = 0, int columnas = 0);
+
+    // Destructor, detiene el hilo
+    virtual ~GOLVisor();
+
+    // Indica si el visor espera un cuadro, así la simulación sólo copia el tablero cuando se va a mostrar
+    bool quiereCuadro() const;
+
+    // Cuadro de N * M celdas que debe llenar la simulación
+    bool *reservar();
+
+    // Publica el cuadro reservado, nunca bloquea
+    void publicar(long long generacion);
+
+};
+
+#endif // GAMEOFLIFECPU_VISOR_H
@@ -10,6 +10,7 @@
  *
  * BLOCK_SIZE: cantidad de threads que tendra cada bloque.
  * SRAND_VALUE: semilla que se ocupara para generar los numeros al azar.
+ * PROB_TRUE: probabilidad (0-100) de que una celda parta viva.
  * GOLIF: Indicador en caso de que se quiera verificar la cantidad de celdas
  *        vecinas vivas usando solo IF's.
  * IMPRIMIR: Indicador en caso de que se necesite imprimir las matrices (esto
@@ -25,10 +26,13 @@
 
  /* Declaración de constantes */
 #define SRAND_VALUE 1998	// Semilla para generar numeros random
+#define PROB_TRUE 50		// Probabilidad de que una celda parta viva
 #define IMPRIMIR 0			// Imprimir o no las matrices de entrada y de salida
 #define T_LIMIT 1			// Tiempo límite de cálculo
 
 /* Declaración de funciones */
+__global__ void inicializarRandom(int dimFilas, int dimColumnas, int *grid, unsigned long long seed, int probTrue);
+
 __global__ void GOL(int dimFilas, int dimColumnas, int *grid, int *newGrid);
 
 __global__ void ghostRows(int dimFilas, int dimColumnas, int *grid);
@@ -81,7 +85,6 @@ int main(int argc, char *argv[]) {
 		printf("IF desactivado\n\n");
 	}
 
-	int i, j;
 	int *h_grid; // Matriz en CPU
 	int *d_grid; // Matriz en GPU
 	int *d_newGrid; // Matriz auxiliar usada solo en GPU
@@ -104,26 +107,22 @@ int main(int argc, char *argv[]) {
 	cudaMalloc(&d_grid, bytes);
 	cudaMalloc(&d_newGrid, bytes);
 
-	// Colocamos valores aleatorios en la matriz inicialmente
-	srand(SRAND_VALUE);
-	for (i = 1; i <= dimFilas; i++) {
-		for (j = 1; j <= dimColumnas; j++) {
-			h_grid[i * (dimColumnas + 2) + j] = rand() % 2;
-		}
-	}
-
-	// Copiamos valores iniciales de la matriz a la GPU
-	cudaMemcpy(d_grid, h_grid, bytes, cudaMemcpyHostToDevice);
-	cudaMemcpy(d_newGrid, h_grid, bytes, cudaMemcpyHostToDevice);
-
 	// Establecemos los tamannos de los bloques y la cantidad de bloques a utilizar
 	dim3 blockSize(BLOCK_SIZE, BLOCK_SIZE, 1);
 	int linGrid = (int)ceil((dimFilas * dimColumnas) / (float)(BLOCK_SIZE * BLOCK_SIZE));
 	dim3 gridSize(linGrid, linGrid, 1);
 
+	// Colocamos valores aleatorios en la matriz directamente en la GPU, el generador es el
+	// mismo de cpu/rng.h por lo que el tablero coincide con CPU y OpenCL
+	cudaMemset(d_grid, 0, bytes);
+	inicializarRandom <<< gridSize, blockSize >>> (dimFilas, dimColumnas, d_grid, SRAND_VALUE, PROB_TRUE);
+	cudaMemcpy(d_newGrid, d_grid, bytes, cudaMemcpyDeviceToDevice);
+	cudaMemcpy(h_grid, d_grid, bytes, cudaMemcpyDeviceToHost);
+
 	dim3 cpyBlockSize(BLOCK_SIZE, 1, 1);
-	dim3 cpyGridRowsGridSize((int)ceil(dimFilas / (float)cpyBlockSize.x), 1, 1);
-	dim3 cpyGridColsGridSize((int)ceil((dimColumnas + 2) / (float)cpyBlockSize.x), 1, 1);
+	// ghostRows recorre las columnas [1,dim] y ghostCols las filas [0,dim+1]
+	dim3 cpyGridRowsGridSize((int)ceil(dimColumnas / (float)cpyBlockSize.x), 1, 1);
+	dim3 cpyGridColsGridSize((int)ceil((dimFilas + 2) / (float)cpyBlockSize.x), 1, 1);
 
 	// Imprimimos de ser el caso
 	if (IMPRIMIR) {
@@ -176,6 +175,27 @@ int main(int argc, char *argv[]) {
 
 }
 
+/* Generador basado en contador, debe coincidir con cpu/rng.h */
+__device__ unsigned long long mezclarSplitMix(unsigned long long z) {
+	z += 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+__global__ void inicializarRandom(int dimFilas, int dimColumnas, int *grid, unsigned long long seed, int probTrue) {
+	// Queremos id en [1,dim]
+	int iy = blockDim.y * blockIdx.y + threadIdx.y + 1;
+	int ix = blockDim.x * blockIdx.x + threadIdx.x + 1;
+
+	if (iy <= dimFilas && ix <= dimColumnas) {
+		// El indice no considera las filas ni columnas fantasmas
+		unsigned long long indice = (unsigned long long)(iy - 1) * dimColumnas + (ix - 1);
+		unsigned long long h = mezclarSplitMix(seed ^ mezclarSplitMix(indice));
+		grid[iy * (dimColumnas + 2) + ix] = (int)(((h >> 32) * 100) >> 32) < probTrue ? 1 : 0;
+	}
+}
+
 __global__ void GOL(int dimFilas, int dimColumnas, int *grid, int *newGrid) {
 	// Queremos id en [1,dim]
 	int iy = blockDim.y * blockIdx.y + threadIdx.y + 1;
@@ -201,7 +221,7 @@ __global__ void GOL(int dimFilas, int dimColumnas, int *grid, int *newGrid) {
 			newGrid[id] = 1;
 		}
 		else {
-			newGrid[id] = cell;
+			newGrid[id] = 0;
 		}
 	}
 }
@@ -236,7 +256,7 @@ __global__ void GOL_IF(int dimFilas, int dimColumnas, int *grid, int *newGrid) {
 			newGrid[id] = 1;
 		}
 		else {
-			newGrid[id] = cell;
+			newGrid[id] = 0;
 		}
 	}
 }
@@ -257,9 +277,9 @@ __global__ void ghostCols(int dimFilas, int dimColumnas, int *grid) {
 	int id = blockDim.x * blockIdx.x + threadIdx.x;
 	if (id <= dimFilas + 1) {
 		// Copia la primera columna real a la ultima
-		grid[id * (dimColumnas + 2) + dimFilas + 1] = grid[id * (dimColumnas + 2) + 1];
+		grid[id * (dimColumnas + 2) + dimColumnas + 1] = grid[id * (dimColumnas + 2) + 1];
 		// Copia la última columna real a la primera
-		grid[id * (dimColumnas + 2)] = grid[id * (dimColumnas + 2) + dimFilas];
+		grid[id * (dimColumnas + 2)] = grid[id * (dimColumnas + 2) + dimColumnas];
 	}
 }
 
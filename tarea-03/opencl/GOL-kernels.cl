@@ -1,3 +1,24 @@
+/* Generador basado en contador, debe coincidir con cpu/rng.h */
+ulong mezclarSplitMix(ulong z) {
+	z += 0x9E3779B97F4A7C15UL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9UL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBUL;
+	return z ^ (z >> 31);
+}
+
+__kernel void inicializarRandom(const int dimFilas, __global int *grid, const int dimColumnas, const ulong seed,
+	const int probTrue) {
+	int ix = get_global_id(0) + 1;
+	int iy = get_global_id(1) + 1;
+
+	if (iy <= dimFilas && ix <= dimColumnas) {
+		// El indice no considera las filas ni columnas fantasmas
+		ulong indice = (ulong)(iy - 1) * dimColumnas + (ix - 1);
+		ulong h = mezclarSplitMix(seed ^ mezclarSplitMix(indice));
+		grid[iy * (dimColumnas + 2) + ix] = (int)(((h >> 32) * 100) >> 32) < probTrue ? 1 : 0;
+	}
+}
+
 __kernel void ghostRows(const int dimFilas, __global int *grid, const int dimColumnas) {
 	// Queremos id en [1,dim]
 	int id = get_global_id(0) + 1;
@@ -18,9 +39,9 @@ __kernel void ghostCols(const int dimFilas, __global int *grid, const int dimCol
 	if (id <= dimFilas + 1)
 	{
 		// Copia la primera columna real a la ultima
-		grid[id*(dimColumnas + 2) + dimFilas + 1] = grid[id*(dimColumnas + 2) + 1];
+		grid[id*(dimColumnas + 2) + dimColumnas + 1] = grid[id*(dimColumnas + 2) + 1];
 		// Copia la ultima columna real a la primera
-		grid[id*(dimColumnas + 2)] = grid[id*(dimColumnas + 2) + dimFilas];
+		grid[id*(dimColumnas + 2)] = grid[id*(dimColumnas + 2) + dimColumnas];
 	}
 }
 
@@ -46,7 +67,7 @@ __kernel void GOL(const int dimFilas, __global int *grid, __global int *newGrid,
 			newGrid[id] = 1;
 		}
 		else {
-			newGrid[id] = cell;
+			newGrid[id] = 0;
 		}
 	}
 }
@@ -79,7 +100,52 @@ __kernel void GOL_IF(const int dimFilas, __global int *grid, __global int *newGr
 			newGrid[id] = 1;
 		}
 		else {
-			newGrid[id] = cell;
+			newGrid[id] = 0;
+		}
+	}
+}
+
+/* Cantidad de generaciones que avanza GOL_MULTI por lanzamiento y tamano del tile (igual al
+ * tamano local). Ambos se definen al compilar el programa con -D GENS=k -D TILE=l */
+#ifndef GENS
+#define GENS 1
+#endif
+#ifndef TILE
+#define TILE 16
+#endif
+
+__kernel void GOL_MULTI(const int dimFilas, __global int *grid, __global int *newGrid, const int dimColumnas) {
+	__local int tile[2][TILE][TILE];
+
+	// Cada grupo calcula un nucleo de (TILE - 2*GENS)^2 celdas, el resto es el halo
+	int lx = get_local_id(0);
+	int ly = get_local_id(1);
+	int nucleo = TILE - 2 * GENS;
+	int ix = get_group_id(0) * nucleo + lx - GENS; // Columna real en [0,dim), puede salir del tablero
+	int iy = get_group_id(1) * nucleo + ly - GENS; // Fila real en [0,dim), puede salir del tablero
+
+	// Carga el tile con condiciones periodicas, no se usan las filas ni columnas fantasmas
+	int gx = ((ix % dimColumnas) + dimColumnas) % dimColumnas + 1;
+	int gy = ((iy % dimFilas) + dimFilas) % dimFilas + 1;
+	tile[0][ly][lx] = grid[gy * (dimColumnas + 2) + gx];
+	barrier(CLK_LOCAL_MEM_FENCE);
+
+	// Avanza GENS generaciones en memoria local, la region valida se encoge en una celda por paso
+	int src = 0;
+	for (int g = 1; g <= GENS; g++) {
+		if (lx >= g && lx < TILE - g && ly >= g && ly < TILE - g) {
+			int numNeighbors = tile[src][ly - 1][lx - 1] + tile[src][ly - 1][lx] + tile[src][ly - 1][lx + 1]
+				+ tile[src][ly][lx - 1] + tile[src][ly][lx + 1]
+				+ tile[src][ly + 1][lx - 1] + tile[src][ly + 1][lx] + tile[src][ly + 1][lx + 1];
+			int cell = tile[src][ly][lx];
+			tile[1 - src][ly][lx] = (numNeighbors == 3 || (cell == 1 && numNeighbors == 2)) ? 1 : 0;
 		}
+		barrier(CLK_LOCAL_MEM_FENCE);
+		src = 1 - src;
 	}
-}
\ No newline at end of file
+
+	// Escribe solo el nucleo
+	if (lx >= GENS && lx < TILE - GENS && ly >= GENS && ly < TILE - GENS && ix < dimColumnas && iy < dimFilas) {
+		newGrid[(iy + 1) * (dimColumnas + 2) + ix + 1] = tile[src][ly][lx];
+	}
+}
@@ -0,0 +1,553 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Juego de la vida en OpenCL encapsulado en una clase.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include "GOLOpenCL.h"
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#define mkdir(path, mode) _mkdir(path)
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#define CACHE_DIR "cache"	// Carpeta donde se guardan los binarios compilados de los kernels
+
+/**
+ * Imprime el error y lanza una excepción, equivale a los EXIT_FAILURE del programa original.
+ */
+static void error(const char *mensaje) {
+	printf("Error: %s\n", mensaje);
+	throw std::runtime_error(mensaje);
+}
+
+/**
+ * Hash FNV-1a de 64 bits.
+ */
+static unsigned long long hashFNV(const char *data, size_t len) {
+	unsigned long long h = 14695981039346656037ULL;
+	for (size_t i = 0; i < len; i++) {
+		h ^= (unsigned char)data[i];
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+/**
+ * Crea la clave de la cache a partir del dispositivo, la version del driver, las opciones de
+ * compilacion y un hash del codigo fuente de los kernels.
+ */
+static std::string obtenerClaveCache(cl_device_id device_id, const char *source, const char *opciones) {
+	char nombre[256] = "";
+	char driver[256] = "";
+	char version[256] = "";
+	clGetDeviceInfo(device_id, CL_DEVICE_NAME, sizeof(nombre), nombre, NULL);
+	clGetDeviceInfo(device_id, CL_DRIVER_VERSION, sizeof(driver), driver, NULL);
+	clGetDeviceInfo(device_id, CL_DEVICE_VERSION, sizeof(version), version, NULL);
+
+	char hashFuente[17];
+	snprintf(hashFuente, sizeof(hashFuente), "%016llx", hashFNV(source, strlen(source)));
+
+	return std::string(nombre) + "|" + driver + "|" + version + "|" + opciones + "|" + hashFuente;
+}
+
+/**
+ * Retorna el nombre del archivo de la cache asociado a una clave.
+ */
+static std::string archivoCache(const std::string &clave) {
+	char nombre[64];
+	snprintf(nombre, sizeof(nombre), CACHE_DIR "/GOL-%016llx.bin", hashFNV(clave.c_str(), clave.size()));
+	return std::string(nombre);
+}
+
+/**
+ * Carga el programa desde un binario en la cache. Retorna NULL si no existe, si la clave guardada
+ * no coincide (cache obsoleta) o si el driver rechaza el binario; en ese caso se debe compilar
+ * desde el codigo fuente.
+ */
+static cl_program cargarProgramaCache(cl_context context, cl_device_id device_id, const std::string &clave,
+	const char *opciones) {
+	FILE *fh = fopen(archivoCache(clave).c_str(), "rb");
+	if (!fh) {
+		return NULL;
+	}
+
+	// El archivo guarda la clave completa seguida del binario
+	size_t largoClave = 0, largoBinario = 0;
+	if (fread(&largoClave, sizeof(size_t), 1, fh) != 1 || largoClave != clave.size()) {
+		fclose(fh);
+		return NULL;
+	}
+	std::string claveArchivo(largoClave, '\0');
+	if (fread(&claveArchivo[0], 1, largoClave, fh) != largoClave || claveArchivo != clave ||
+		fread(&largoBinario, sizeof(size_t), 1, fh) != 1 || largoBinario == 0) {
+		fclose(fh);
+		return NULL;
+	}
+	unsigned char *binario = (unsigned char *)malloc(largoBinario);
+	if (fread(binario, 1, largoBinario, fh) != largoBinario) {
+		free(binario);
+		fclose(fh);
+		return NULL;
+	}
+	fclose(fh);
+
+	cl_int err, estadoBinario;
+	cl_program program = clCreateProgramWithBinary(context, 1, &device_id, &largoBinario,
+		(const unsigned char **)&binario, &estadoBinario, &err);
+	free(binario);
+	if (!program || err != CL_SUCCESS || estadoBinario != CL_SUCCESS) {
+		if (program) { clReleaseProgram(program); }
+		return NULL;
+	}
+
+	// Aun cargando un binario se debe llamar a clBuildProgram
+	err = clBuildProgram(program, 1, &device_id, opciones, NULL, NULL);
+	if (err != CL_SUCCESS) {
+		clReleaseProgram(program);
+		return NULL;
+	}
+	return program;
+}
+
+/**
+ * Guarda el binario del programa compilado en la cache. Se escribe a un archivo temporal propio
+ * de cada llamada y luego se renombra sobre el anterior (rename lo reemplaza de forma atómica),
+ * de modo que una ejecucion concurrente nunca lee un binario a medio escribir ni queda sin cache.
+ */
+static void guardarProgramaCache(cl_program program, const std::string &clave) {
+	size_t largoBinario = 0;
+	if (clGetProgramInfo(program, CL_PROGRAM_BINARY_SIZES, sizeof(size_t), &largoBinario, NULL) != CL_SUCCESS ||
+		largoBinario == 0) {
+		return;
+	}
+	unsigned char *binario = (unsigned char *)malloc(largoBinario);
+	if (clGetProgramInfo(program, CL_PROGRAM_BINARIES, sizeof(unsigned char *), &binario, NULL) != CL_SUCCESS) {
+		free(binario);
+		return;
+	}
+
+	mkdir(CACHE_DIR, 0755);
+	std::string nombre = archivoCache(clave);
+	static std::atomic<int> temporales(0);
+	std::string temporal = nombre + "." + std::to_string((long long)getpid()) + "-" +
+		std::to_string(temporales++) + ".tmp";
+	FILE *fh = fopen(temporal.c_str(), "wb");
+	if (fh) {
+		size_t largoClave = clave.size();
+		bool ok = fwrite(&largoClave, sizeof(size_t), 1, fh) == 1 &&
+			fwrite(clave.c_str(), 1, largoClave, fh) == largoClave &&
+			fwrite(&largoBinario, sizeof(size_t), 1, fh) == 1 &&
+			fwrite(binario, 1, largoBinario, fh) == largoBinario;
+		ok = fclose(fh) == 0 && ok;
+		if (!ok || rename(temporal.c_str(), nombre.c_str()) != 0) {
+			remove(temporal.c_str());
+		}
+	}
+	free(binario);
+}
+
+/**
+ * Redondea n hacia arriba al múltiplo de m.
+ */
+static size_t redondear(int n, int m) {
+	return (size_t)((n + m - 1) / m) * m;
+}
+
+/**
+ * Constructor.
+ *
+ * @param N Número de filas
+ * @param M Número de columnas
+ * @param localSize Tamaño local
+ * @param kernel Kernel con el que se avanza el juego
+ * @param gens Generaciones por lanzamiento de GOL_MULTI
+ * @param tipo Tipo de dispositivo
+ * @param archivoKernels Ruta al archivo de los kernels
+ */
+GOLOpenCL::GOLOpenCL(int N, int M, int localSize, KernelGOL kernel, int gens, cl_device_type tipo,
+	const char *archivoKernels) {
+	this->dimFilas = N;
+	this->dimColumnas = M;
+	this->localSize = localSize;
+	this->kernel = kernel;
+	this->gens = kernel == KERNEL_GOL_MULTI ? gens : 1;
+	this->desdeCache = false;
+	if (kernel == KERNEL_GOL_MULTI && localSize <= 2 * gens) {
+		error("LOCAL SIZE debe ser mayor a 2*GENS");
+	}
+
+	// Si algún paso falla el destructor no se llama, liberar() suelta lo que ya se creó
+	h_grid = NULL;
+	context = NULL;
+	queue = NULL;
+	program = NULL;
+	k_gol = k_ghostRows = k_ghostCols = k_gol_if = k_gol_multi = k_init = NULL;
+	d_grid = d_newGrid = NULL;
+	try {
+		inicializarDispositivo(tipo, archivoKernels);
+	} catch (...) {
+		liberar();
+		throw;
+	}
+}
+
+/**
+ * Busca el dispositivo, compila los kernels y crea las matrices. Parte del constructor.
+ *
+ * @param tipo Tipo de dispositivo
+ * @param archivoKernels Ruta al archivo de los kernels
+ */
+void GOLOpenCL::inicializarDispositivo(cl_device_type tipo, const char *archivoKernels) {
+	// Tamaño, en bytes, de cada vector
+	bytes = sizeof(int) * (dimFilas + 2) * (dimColumnas + 2);
+	h_grid = (int *)calloc((dimFilas + 2) * (dimColumnas + 2), sizeof(int));
+
+	// Busca el primer dispositivo del tipo pedido en todas las plataformas
+	cl_int err;
+	cl_uint nPlataformas = 0;
+	err = clGetPlatformIDs(0, NULL, &nPlataformas);
+	if (err != CL_SUCCESS || nPlataformas == 0) {
+		error("Failed to find a platform");
+	}
+	cl_platform_id *plataformas = (cl_platform_id *)malloc(sizeof(cl_platform_id) * nPlataformas);
+	clGetPlatformIDs(nPlataformas, plataformas, NULL);
+	err = CL_DEVICE_NOT_FOUND;
+	for (cl_uint p = 0; p < nPlataformas && err != CL_SUCCESS; p++) {
+		err = clGetDeviceIDs(plataformas[p], tipo, 1, &device_id, NULL);
+	}
+	free(plataformas);
+	if (err != CL_SUCCESS) {
+		error("Failed to create a device group");
+	}
+
+	// Create a context
+	context = clCreateContext(0, 1, &device_id, NULL, NULL, &err);
+	if (!context) {
+		error("Failed to create a compute context");
+	}
+
+	// Create a command queue
+	queue = clCreateCommandQueue(context, device_id, 0, &err);
+	if (!queue) {
+		error("Failed to create a command commands");
+	}
+
+	// Compila y crea los kernels
+	compilarPrograma(archivoKernels);
+	k_gol = crearKernel("GOL");
+	k_ghostRows = crearKernel("ghostRows");
+	k_ghostCols = crearKernel("ghostCols");
+	k_gol_if = crearKernel("GOL_IF");
+	k_gol_multi = crearKernel("GOL_MULTI");
+	k_init = crearKernel("inicializarRandom");
+
+	// Create the input and output arrays in device memory for our calculation
+	d_grid = clCreateBuffer(context, CL_MEM_READ_WRITE, bytes, NULL, NULL);
+	d_newGrid = clCreateBuffer(context, CL_MEM_READ_WRITE, bytes, NULL, NULL);
+	if (!d_grid || !d_newGrid) {
+		error("Failed to allocate device memory");
+	}
+
+	// Set the arguments, las matrices se asignan en asignarMatrices()
+	err = CL_SUCCESS;
+	cl_kernel conDimensiones[] = {k_gol, k_gol_if, k_gol_multi};
+	for (cl_kernel k : conDimensiones) {
+		err |= clSetKernelArg(k, 0, sizeof(int), &dimFilas);
+		err |= clSetKernelArg(k, 3, sizeof(int), &dimColumnas);
+	}
+	cl_kernel fantasmas[] = {k_ghostRows, k_ghostCols};
+	for (cl_kernel k : fantasmas) {
+		err |= clSetKernelArg(k, 0, sizeof(int), &dimFilas);
+		err |= clSetKernelArg(k, 2, sizeof(int), &dimColumnas);
+	}
+	if (err != CL_SUCCESS) {
+		error("Failed to set kernel arguments");
+	}
+	asignarMatrices();
+
+	// ghostRows recorre las columnas [1,dim] y ghostCols las filas [0,dim+1]
+	cpyLocalSize = localSize;
+	cpyRowsGlobalSize = redondear(dimColumnas, localSize);
+	cpyColsGlobalSize = redondear(dimFilas + 2, localSize);
+
+	// El eje 0 corresponde a las columnas y el eje 1 a las filas
+	golLocalSize[0] = localSize;
+	golLocalSize[1] = localSize;
+	golGlobalSize[0] = redondear(dimColumnas, localSize);
+	golGlobalSize[1] = redondear(dimFilas, localSize);
+
+	// GOL_MULTI: cada grupo escribe un nucleo de localSize - 2*GENS celdas por lado
+	int nucleo = localSize - 2 * this->gens;
+	multiGlobalSize[0] = (size_t)((dimColumnas + nucleo - 1) / nucleo) * localSize;
+	multiGlobalSize[1] = (size_t)((dimFilas + nucleo - 1) / nucleo) * localSize;
+}
+
+/**
+ * Destructor.
+ */
+GOLOpenCL::~GOLOpenCL() {
+	liberar();
+}
+
+/**
+ * Libera los objetos OpenCL y la matriz en la CPU, omite los que aún no se crearon.
+ */
+void GOLOpenCL::liberar() {
+	cl_mem buffers[] = {d_grid, d_newGrid};
+	for (cl_mem d : buffers) {
+		if (d) { clReleaseMemObject(d); }
+	}
+	cl_kernel kernels[] = {k_gol, k_ghostRows, k_ghostCols, k_gol_if, k_gol_multi, k_init};
+	for (cl_kernel k : kernels) {
+		if (k) { clReleaseKernel(k); }
+	}
+	if (program) { clReleaseProgram(program); }
+	if (queue) { clReleaseCommandQueue(queue); }
+	if (context) { clReleaseContext(context); }
+	free(h_grid);
+}
+
+/**
+ * Compila el programa. Busca primero un binario compilado para este dispositivo, driver, opciones
+ * y fuente en la cache, si no existe compila desde el código fuente y lo guarda.
+ *
+ * @param archivoKernels Ruta al archivo de los kernels
+ */
+void GOLOpenCL::compilarPrograma(const char *archivoKernels) {
+	FILE *fh = fopen(archivoKernels, "rb");
+	if (!fh) {
+		error("Failed to open file");
+	}
+	struct stat statbuf;
+	stat(archivoKernels, &statbuf);
+	char *kernelSource = (char *)malloc(statbuf.st_size + 1);
+	size_t leidos = fread(kernelSource, 1, statbuf.st_size, fh);
+	kernelSource[leidos] = '\0';
+	fclose(fh);
+
+	// GENS y TILE son constantes de compilación de GOL_MULTI
+	char buildOptions[64];
+	snprintf(buildOptions, sizeof(buildOptions), "-D GENS=%d -D TILE=%d", gens, localSize);
+	std::string claveCache = obtenerClaveCache(device_id, kernelSource, buildOptions);
+	program = cargarProgramaCache(context, device_id, claveCache, buildOptions);
+	if (program) {
+		desdeCache = true;
+		free(kernelSource);
+		return;
+	}
+
+	cl_int err;
+	program = clCreateProgramWithSource(context, 1, (const char **)&kernelSource, NULL, &err);
+	free(kernelSource);
+	if (!program) {
+		error("Failed to create compute program");
+	}
+
+	// Build the program executable
+	err = clBuildProgram(program, 0, NULL, buildOptions, NULL, NULL);
+	if (err != CL_SUCCESS) {
+		printf("Error: Failed to build program executable %d\n", err);
+
+		// Determine the size of the log
+		size_t log_size;
+		clGetProgramBuildInfo(program, device_id, CL_PROGRAM_BUILD_LOG, 0, NULL, &log_size);
+
+		// Get the log and print it
+		char *log = (char *)malloc(log_size);
+		clGetProgramBuildInfo(program, device_id, CL_PROGRAM_BUILD_LOG, log_size, log, NULL);
+		printf("%s\n", log);
+		free(log);
+
+		error("Failed to build program executable");
+	}
+
+	// Guarda el binario para las siguientes ejecuciones
+	guardarProgramaCache(program, claveCache);
+}
+
+/**
+ * Crea un kernel del programa.
+ *
+ * @param nombre Nombre del kernel
+ * @return Kernel
+ */
+cl_kernel GOLOpenCL::crearKernel(const char *nombre) {
+	cl_int err;
+	cl_kernel k = clCreateKernel(program, nombre, &err);
+	if (!k || err != CL_SUCCESS) {
+		std::string mensaje = std::string("Failed to create ") + nombre + " kernel";
+		error(mensaje.c_str());
+	}
+	return k;
+}
+
+/**
+ * Asigna d_grid como entrada y d_newGrid como salida de todos los kernels.
+ */
+void GOLOpenCL::asignarMatrices() {
+	cl_int err = CL_SUCCESS;
+	cl_kernel kernels[] = {k_gol, k_gol_if, k_gol_multi};
+	for (cl_kernel k : kernels) {
+		err |= clSetKernelArg(k, 1, sizeof(cl_mem), &d_grid);
+		err |= clSetKernelArg(k, 2, sizeof(cl_mem), &d_newGrid);
+	}
+	err |= clSetKernelArg(k_ghostRows, 1, sizeof(cl_mem), &d_grid);
+	err |= clSetKernelArg(k_ghostCols, 1, sizeof(cl_mem), &d_grid);
+	if (err != CL_SUCCESS) {
+		error("Failed to set kernel arguments");
+	}
+}
+
+/**
+ * Inicializa la matriz en el dispositivo, usa el mismo generador de cpu/rng.h.
+ *
+ * @param probTrue Probabilidad de que una celda parta viva
+ * @param seed Semilla
+ */
+void GOLOpenCL::inicializarMatrizRandom(int probTrue, unsigned long long seed) {
+	cl_ulong semilla = seed;
+	memset(h_grid, 0, bytes);
+	cl_int err = clEnqueueWriteBuffer(queue, d_grid, CL_TRUE, 0, bytes, h_grid, 0, NULL, NULL);
+	err |= clSetKernelArg(k_init, 0, sizeof(int), &dimFilas);
+	err |= clSetKernelArg(k_init, 1, sizeof(cl_mem), &d_grid);
+	err |= clSetKernelArg(k_init, 2, sizeof(int), &dimColumnas);
+	err |= clSetKernelArg(k_init, 3, sizeof(cl_ulong), &semilla);
+	err |= clSetKernelArg(k_init, 4, sizeof(int), &probTrue);
+	err |= clEnqueueNDRangeKernel(queue, k_init, 2, NULL, golGlobalSize, golLocalSize, 0, NULL, NULL);
+	if (err != CL_SUCCESS) {
+		error("Failed to initialize the grid");
+	}
+}
+
+/**
+ * Encola un paso del juego e intercambia las matrices.
+ */
+void GOLOpenCL::aplicarReglas() {
+	encolarPaso(kernel);
+}
+
+/**
+ * Encola generaciones pasos del juego.
+ *
+ * @param generaciones Generaciones a avanzar
+ */
+void GOLOpenCL::avanzar(int generaciones) {
+	for (; generaciones >= gens; generaciones -= gens) {
+		encolarPaso(kernel);
+	}
+	for (; generaciones > 0; generaciones--) {
+		encolarPaso(KERNEL_GOL);
+	}
+}
+
+/**
+ * Encola un paso con el kernel dado e intercambia las matrices.
+ *
+ * @param k Kernel
+ */
+void GOLOpenCL::encolarPaso(KernelGOL k) {
+	cl_int err = CL_SUCCESS;
+	if (k == KERNEL_GOL_MULTI) {
+		// Avanza GENS generaciones por lanzamiento, no necesita copiar las filas fantasmas
+		err |= clEnqueueNDRangeKernel(queue, k_gol_multi, 2, NULL, multiGlobalSize, golLocalSize, 0, NULL, NULL);
+	}
+	else {
+		err |= clEnqueueNDRangeKernel(queue, k_ghostRows, 1, NULL, &cpyRowsGlobalSize, &cpyLocalSize,
+			0, NULL, NULL);
+		err |= clEnqueueNDRangeKernel(queue, k_ghostCols, 1, NULL, &cpyColsGlobalSize, &cpyLocalSize,
+			0, NULL, NULL);
+		err |= clEnqueueNDRangeKernel(queue, k == KERNEL_GOL_IF ? k_gol_if : k_gol, 2, NULL,
+			golGlobalSize, golLocalSize, 0, NULL, NULL);
+	}
+	if (err != CL_SUCCESS) {
+		error("Failed to launch kernels");
+	}
+
+	// Intercambiamos las matrices
+	cl_mem d_tmpGrid = d_grid;
+	d_grid = d_newGrid;
+	d_newGrid = d_tmpGrid;
+	asignarMatrices();
+}
+
+/**
+ * Generaciones que avanza cada llamada a aplicarReglas().
+ */
+int GOLOpenCL::generacionesPorPaso() const {
+	return gens;
+}
+
+/**
+ * Espera a que terminen los kernels encolados.
+ */
+void GOLOpenCL::terminar() {
+	clFinish(queue);
+}
+
+/**
+ * Copia la matriz del dispositivo a la CPU.
+ */
+void GOLOpenCL::leerMatriz() {
+	cl_int err = clEnqueueReadBuffer(queue, d_grid, CL_TRUE, 0, bytes, h_grid, 0, NULL, NULL);
+	if (err != CL_SUCCESS) {
+		error("Failed to read output array");
+	}
+}
+
+/**
+ * Copia la matriz de la CPU al dispositivo.
+ */
+void GOLOpenCL::escribirMatriz() {
+	cl_int err = clEnqueueWriteBuffer(queue, d_grid, CL_TRUE, 0, bytes, h_grid, 0, NULL, NULL);
+	if (err != CL_SUCCESS) {
+		error("Failed to write input array");
+	}
+}
+
+/**
+ * Retorna la matriz en la CPU, incluye las filas fantasmas.
+ */
+int *GOLOpenCL::getMatriz() {
+	return h_grid;
+}
+
+/**
+ * Retorna el valor de una celda.
+ *
+ * @param i Fila, sin contar las filas fantasmas
+ * @param j Columna, sin contar las columnas fantasmas
+ */
+bool GOLOpenCL::getCelda(int i, int j) const {
+	return h_grid[(i + 1) * (dimColumnas + 2) + j + 1] != 0;
+}
+
+/**
+ * Retorna el número de filas reales.
+ */
+int GOLOpenCL::getFilas() const {
+	return dimFilas;
+}
+
+/**
+ * Retorna el número de columnas reales.
+ */
+int GOLOpenCL::getColumnas() const {
+	return dimColumnas;
+}
+
+/**
+ * Indica si el programa se cargó desde la cache de binarios.
+ */
+bool GOLOpenCL::cargadoDesdeCache() const {
+	return desdeCache;
+}
@@ -0,0 +1,123 @@
+/**
+ * Game of Life. Tarea N3 Computación en GPU.
+ * Juego de la vida en OpenCL encapsulado en una clase, permite usar los kernels tanto desde el
+ * programa principal como desde los tests y benchmarks de cpu/.
+ */
+
+#ifndef GAMEOFLIFEOPENCL_GOLOPENCL_H
+#define GAMEOFLIFEOPENCL_GOLOPENCL_H
+
+#include <CL/cl.h>
+
+// Kernel que se usa para avanzar el juego
+enum KernelGOL {
+	KERNEL_GOL,         // Suma de vecinos
+	KERNEL_GOL_IF,      // Vecinos contados con IF
+	KERNEL_GOL_MULTI    // Avanza GENS generaciones en memoria local
+};
+
+class GOLOpenCL {
+private:
+
+	// Dimensiones sin contar las filas fantasmas
+	int dimFilas;
+	int dimColumnas;
+
+	// Configuración de la ejecución
+	int localSize;
+	int gens;
+	KernelGOL kernel;
+	bool desdeCache;
+
+	// Matriz en la CPU, incluye filas fantasmas
+	size_t bytes;
+	int *h_grid;
+
+	// Objetos OpenCL
+	cl_device_id device_id;
+	cl_context context;
+	cl_command_queue queue;
+	cl_program program;
+	cl_kernel k_gol, k_ghostRows, k_ghostCols, k_gol_if, k_gol_multi, k_init;
+	cl_mem d_grid;
+	cl_mem d_newGrid;
+
+	// Tamaños locales y globales de cada kernel
+	size_t cpyLocalSize, cpyRowsGlobalSize, cpyColsGlobalSize;
+	size_t golLocalSize[2], golGlobalSize[2], multiGlobalSize[2];
+
+	// Busca el dispositivo, compila los kernels y crea las matrices
+	void inicializarDispositivo(cl_device_type tipo, const char *archivoKernels);
+
+	// Compila el programa o lo carga desde la cache de binarios
+	void compilarPrograma(const char *archivoKernels);
+
+	// Crea un kernel del programa
+	cl_kernel crearKernel(const char *nombre);
+
+	// Asigna las matrices de entrada y salida a los kernels
+	void asignarMatrices();
+
+	// Encola un paso con el kernel dado e intercambia las matrices
+	void encolarPaso(KernelGOL k);
+
+	// Libera los objetos OpenCL y la matriz en la CPU que ya se hayan creado
+	void liberar();
+
+public:
+
+	/* Constructor, busca un dispositivo del tipo pedido y compila los kernels.
+	 *
+	 * @Param N: Número de filas.
+	 * @Param M: Número de columnas.
+	 * @Param localSize: Tamaño local de los kernels.
+	 * @Param kernel: Kernel con el que se avanza el juego.
+	 * @Param gens: Generaciones por lanzamiento de GOL_MULTI.
+	 * @Param tipo: Tipo de dispositivo (CL_DEVICE_TYPE_GPU, CL_DEVICE_TYPE_CPU, ...).
+	 * @Param archivoKernels: Ruta al archivo GOL-kernels.cl.
+	 */
+	GOLOpenCL(int N, int M, int localSize, KernelGOL kernel, int gens = 1,
+			  cl_device_type tipo = CL_DEVICE_TYPE_GPU, const char *archivoKernels = "GOL-kernels.cl");
+
+	// Destructor
+	virtual ~GOLOpenCL();
+
+	// Inicializa la matriz con el generador de cpu/rng.h
+	void inicializarMatrizRandom(int probTrue, unsigned long long seed);
+
+	// Encola un paso del juego, avanza generacionesPorPaso() generaciones
+	void aplicarReglas();
+
+	// Encola generaciones pasos, con GOL_MULTI el resto que no completa GENS se avanza con GOL
+	void avanzar(int generaciones);
+
+	// Generaciones que avanza cada llamada a aplicarReglas()
+	int generacionesPorPaso() const;
+
+	// Espera a que terminen los kernels encolados
+	void terminar();
+
+	// Copia la matriz del dispositivo a la CPU
+	void leerMatriz();
+
+	// Copia la matriz de la CPU al dispositivo, las filas fantasmas se actualizan en el siguiente paso
+	void escribirMatriz();
+
+	// Matriz en la CPU tras leerMatriz(), incluye las filas fantasmas
+	int *getMatriz();
+
+	// Retorna el valor de una celda tras leerMatriz(), (0, 0) es la primera celda real
+	bool getCelda(int i, int j) const;
+
+	// Número de filas sin contar las filas fantasmas
+	int getFilas() const;
+
+	// Número de columnas sin contar las columnas fantasmas
+	int getColumnas() const;
+
+	// Indica si el programa se cargó desde la cache de binarios
+	bool cargadoDesdeCache() const;
+
+};
+
+#endif // GAMEOFLIFEOPENCL_GOLOPENCL_H